@@ -12,6 +12,19 @@
 #include "SDL_ttf.h"
 #include "SDL_image.h"
 #include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <float.h>
+
+// text, gradients and plots are drawn with SDL_RenderGeometry.
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+	#error "sdlui needs SDL 2.0.18 or newer"
+#endif
+
+// glyphs are looked up, measured and kerned by full 32-bit codepoint.
+#if SDL_VERSIONNUM(SDL_TTF_MAJOR_VERSION, SDL_TTF_MINOR_VERSION, SDL_TTF_PATCHLEVEL) < SDL_VERSIONNUM(2, 0, 18)
+	#error "sdlui needs SDL_ttf 2.0.18 or newer"
+#endif
 
 typedef uint8_t u8;
 typedef uint16_t u16;
@@ -22,10 +35,23 @@ typedef int16_t i16;
 typedef int32_t i32;
 typedef int64_t i64;
 
+typedef u64 SDLUI_ID;
+
 #define SDLUI_COLLECTION_CHUNK 10
 #define SDLUI_STRING_CAPACITY 20
 #define SDLUI_MARGIN 8
 #define SDLUI_WINDOW_MIN_SIZE 120
+#define SDLUI_GLYPH_PAGE_SIZE 512
+#define SDLUI_GLYPH_MAX_PAGES 4
+#define SDLUI_TARGET_POOL_MAX_FREE 4
+#define SDLUI_MAX_INPUT_EVENTS 64
+#define SDLUI_LAST_LINE 0x7FFFFFFF
+#define SDLUI_LOG_CAPACITY 2048
+#define SDLUI_LOG_LINE_SIZE 256
+#define SDLUI_INSPECTOR_VALUE_SIZE 32
+#define SDLUI_LOG_SCAN_BUDGET 512
+#define SDLUI_HIT_CELL_SIZE 64
+#define SDLUI_ARENA_BLOCK_SIZE 16384
 
 enum SDLUI_BUTTON_STATE
 {
@@ -69,7 +95,70 @@ enum SDLUI_CONTROL_TYPE
 	SDLUI_CONTROL_TYPE_RADIO_BUTTON,
 	SDLUI_CONTROL_TYPE_SCROLL_AREA,
 	SDLUI_CONTROL_TYPE_LIST,
-	SDLUI_CONTROL_TYPE_TEXTBOX
+	SDLUI_CONTROL_TYPE_TEXTBOX,
+	SDLUI_CONTROL_TYPE_VIRTUAL_LIST,
+	SDLUI_CONTROL_TYPE_TEXT_EDITOR,
+	SDLUI_CONTROL_TYPE_CONSOLE,
+	SDLUI_CONTROL_TYPE_PLOT,
+	SDLUI_CONTROL_TYPE_INSPECTOR
+};
+
+enum SDLUI_PLOT_TYPE
+{
+	SDLUI_PLOT_TYPE_LINE,
+	SDLUI_PLOT_TYPE_AREA,
+	SDLUI_PLOT_TYPE_HISTOGRAM
+};
+
+enum SDLUI_ICON
+{
+	SDLUI_ICON_TICK,
+	SDLUI_ICON_TOGGLE,
+	SDLUI_ICON_CIRCLE_FILL_SMALL,
+	SDLUI_ICON_CIRCLE_FILL_BIG,
+	SDLUI_ICON_CIRCLE,
+	SDLUI_ICON_CLOSE,
+	SDLUI_ICON_COUNT
+};
+
+enum SDLUI_VALUE_TYPE
+{
+	SDLUI_VALUE_TYPE_BOOL,
+	SDLUI_VALUE_TYPE_INT,
+	SDLUI_VALUE_TYPE_FLOAT
+};
+
+enum SDLUI_LOG_LINE_STATE
+{
+	SDLUI_LOG_LINE_READY,
+	SDLUI_LOG_LINE_PENDING,
+	SDLUI_LOG_LINE_LOST
+};
+
+enum SDLUI_EDIT_KIND
+{
+	SDLUI_EDIT_KIND_NONE,
+	SDLUI_EDIT_KIND_TYPING,
+	SDLUI_EDIT_KIND_DELETING
+};
+
+enum SDLUI_LAYOUT_TYPE
+{
+	SDLUI_LAYOUT_VERTICAL,
+	SDLUI_LAYOUT_HORIZONTAL,
+	SDLUI_LAYOUT_GRID
+};
+
+enum SDLUI_SIZE_RULE
+{
+	SDLUI_SIZE_AUTO,
+	SDLUI_SIZE_FILL
+};
+
+enum SDLUI_COMPOSITOR
+{
+	SDLUI_COMPOSITOR_TEXTURES,
+	SDLUI_COMPOSITOR_DIRECT
 };
 
 enum SDLUI_RESIZE_DIRECTION
@@ -86,48 +175,324 @@ enum SDLUI_RESIZE_DIRECTION
 	SDLUI_RESIZE_RIGHT_BOTTOM
 };
 
-struct SDLUI_String
+// One chunk of an arena. The memory it hands out follows the header.
+struct SDLUI_ArenaBlock
+{
+	SDLUI_ArenaBlock* next;
+	size_t used;
+	size_t capacity;
+};
+
+// Bump allocator for things that are all freed together, like the controls of one window.
+struct SDLUI_Arena
+{
+	SDLUI_ArenaBlock* head;
+
+	void create()
+	{
+		head = NULL;
+	}
+
+	SDLUI_ArenaBlock* new_block(size_t capacity)
+	{
+		SDLUI_ArenaBlock* block = (SDLUI_ArenaBlock*)malloc(((sizeof(SDLUI_ArenaBlock) + 15) & ~(size_t)15) + capacity);
+		block->next = NULL;
+		block->used = 0;
+		block->capacity = capacity;
+		return block;
+	}
+
+	void* alloc(size_t size)
+	{
+		size = (size + 15) & ~(size_t)15;
+
+		// big requests get a block of their own behind the current one, so its free space isn't lost.
+		if (size > SDLUI_ARENA_BLOCK_SIZE / 4)
+		{
+			SDLUI_ArenaBlock* block = new_block(size);
+			block->used = size;
+
+			if (head == NULL)
+			{
+				head = block;
+			}
+			else
+			{
+				block->next = head->next;
+				head->next = block;
+			}
+
+			return (u8*)block + ((sizeof(SDLUI_ArenaBlock) + 15) & ~(size_t)15);
+		}
+
+		if (head == NULL || head->used + size > head->capacity)
+		{
+			SDLUI_ArenaBlock* block = new_block(SDLUI_ARENA_BLOCK_SIZE);
+			block->next = head;
+			head = block;
+		}
+
+		void* ptr = (u8*)head + ((sizeof(SDLUI_ArenaBlock) + 15) & ~(size_t)15) + head->used;
+		head->used += size;
+		return ptr;
+	}
+
+	void release()
+	{
+		while (head != NULL)
+		{
+			SDLUI_ArenaBlock* next = head->next;
+			free(head);
+			head = next;
+		}
+	}
+};
+
+// Every distinct string given to SDLUI_String::create is stored here once and shared
+// by all the controls using it until one of them changes its copy.
+struct __SDLUI_StringTable
 {
+	SDLUI_Arena arena;
+	const char** entries;
 	i32 capacity = 0;
+	i32 count = 0;
+
+	const char** find_slot(const char* str)
+	{
+		u32 hash = 2166136261u;
+		for (const char* c = str; *c != '\0'; ++c)
+		{
+			hash = (hash ^ (u8)*c) * 16777619u;
+		}
+
+		i32 i = hash & (capacity - 1);
+
+		while (entries[i] != NULL && strcmp(entries[i], str) != 0)
+		{
+			i = (i + 1) & (capacity - 1);
+		}
+
+		return &entries[i];
+	}
+
+	void grow()
+	{
+		const char** old_entries = entries;
+		i32 old_capacity = capacity;
+
+		capacity = capacity == 0 ? 256 : capacity * 2;
+		entries = (const char**)calloc(capacity, sizeof(const char*));
+
+		for (int i = 0; i < old_capacity; ++i)
+		{
+			if (old_entries[i] != NULL)
+			{
+				*find_slot(old_entries[i]) = old_entries[i];
+			}
+		}
+
+		free(old_entries);
+	}
+
+	const char* intern(const char* str)
+	{
+		if (count * 4 >= capacity * 3)
+		{
+			grow();
+		}
+
+		const char** slot = find_slot(str);
+		if (*slot == NULL)
+		{
+			size_t length = strlen(str);
+			char* copy = (char*)arena.alloc(length + 1);
+			memcpy(copy, str, length + 1);
+			*slot = copy;
+			count++;
+		}
+
+		return *slot;
+	}
+}SDLUI_StringTable;
+
+struct SDLUI_IDMapEntry
+{
+	SDLUI_ID id;
+	void* value;
+};
+
+// Open addressing hash map from IDs to pointers. ID 0 marks an empty slot.
+struct SDLUI_IDMap
+{
+	SDLUI_IDMapEntry* entries;
+	i32 capacity = 0;
+	i32 count = 0;
+
+	SDLUI_IDMapEntry* find_slot(SDLUI_ID id)
+	{
+		i32 i = (i32)((id * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+
+		while (entries[i].id != 0 && entries[i].id != id)
+		{
+			i = (i + 1) & (capacity - 1);
+		}
+
+		return &entries[i];
+	}
+
+	void* find(SDLUI_ID id)
+	{
+		if (capacity == 0 || id == 0)
+		{
+			return NULL;
+		}
+
+		return find_slot(id)->value;
+	}
+
+	void insert(SDLUI_ID id, void* value)
+	{
+		if (count * 4 >= capacity * 3)
+		{
+			SDLUI_IDMapEntry* old_entries = entries;
+			i32 old_capacity = capacity;
+
+			capacity = capacity == 0 ? 64 : capacity * 2;
+			entries = (SDLUI_IDMapEntry*)calloc(capacity, sizeof(SDLUI_IDMapEntry));
+
+			for (int i = 0; i < old_capacity; ++i)
+			{
+				if (old_entries[i].id != 0)
+				{
+					*find_slot(old_entries[i].id) = old_entries[i];
+				}
+			}
+
+			free(old_entries);
+		}
+
+		SDLUI_IDMapEntry* slot = find_slot(id);
+		if (slot->id == 0)
+		{
+			count++;
+		}
+
+		slot->id = id;
+		slot->value = value;
+	}
+
+	void* remove(SDLUI_ID id)
+	{
+		if (capacity == 0 || id == 0)
+		{
+			return NULL;
+		}
+
+		SDLUI_IDMapEntry* slot = find_slot(id);
+		if (slot->id == 0)
+		{
+			return NULL;
+		}
+
+		void* value = slot->value;
+		i32 hole = (i32)(slot - entries);
+		i32 i = hole;
+
+		// shift the entries after the hole back so every probe sequence stays unbroken.
+		while (true)
+		{
+			i = (i + 1) & (capacity - 1);
+			if (entries[i].id == 0)
+			{
+				break;
+			}
+
+			i32 home = (i32)((entries[i].id * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+			if (((i - home) & (capacity - 1)) >= ((i - hole) & (capacity - 1)))
+			{
+				entries[hole] = entries[i];
+				hole = i;
+			}
+		}
+
+		entries[hole].id = 0;
+		entries[hole].value = NULL;
+		count--;
+		return value;
+	}
+};
+
+// Controls by ID, so commands recorded on other threads can refer to them.
+SDLUI_IDMap SDLUI_ControlMap;
+
+// State records by ID, for what controls need to remember between calls.
+SDLUI_IDMap SDLUI_StateMap;
+
+struct SDLUI_String
+{
+	i32 capacity = 0; // 0 while data is the shared copy from SDLUI_StringTable
 	i32 length = 0;
 	bool modified = false;
 	char* data;
 
-	void create(char* str)
+	void create(const char* str)
 	{
 		length = strlen(str);
-		capacity = ((length / SDLUI_STRING_CAPACITY) + 1) * SDLUI_STRING_CAPACITY;
-		data = (char*)malloc(capacity);
-		memcpy(data, str, length);
-		memset(data + length, 0, 1);
+		capacity = 0;
+		data = (char*)SDLUI_StringTable.intern(str);
 
 		modified = false;
 	}
 
 	void destroy()
 	{
-		free(data);
+		if (capacity > 0)
+		{
+			free(data);
+		}
+
 		data = NULL;
+		capacity = 0;
+		length = 0;
 	}
 
-	void modify(const char* str)
+	// makes data a buffer of our own with room for size characters and the terminator, doubling as it grows.
+	void reserve(i32 size)
 	{
-		i32 new_length = strlen(str);
-		if (new_length >= capacity)
+		if (size < capacity)
+		{
+			return;
+		}
+
+		i32 new_capacity = capacity > 0 ? capacity : SDLUI_STRING_CAPACITY;
+		while (new_capacity <= size)
+		{
+			new_capacity *= 2;
+		}
+
+		if (capacity > 0)
 		{
-			capacity = ((new_length / SDLUI_STRING_CAPACITY) + 1) * SDLUI_STRING_CAPACITY;
-			data = (char*)realloc(data, capacity);
-			memcpy(data, str, new_length);
-			memset(data + new_length, 0, 1);
-			length = new_length;
+			data = (char*)realloc(data, new_capacity);
 		}
 		else
 		{
-			memcpy(data, str, new_length);
-			memset(data + new_length, 0, capacity - new_length);
-			length = new_length;
+			char* owned = (char*)malloc(new_capacity);
+			memcpy(owned, data, length + 1);
+			data = owned;
 		}
 
+		capacity = new_capacity;
+	}
+
+	void modify(const char* str)
+	{
+		i32 new_length = strlen(str);
+
+		reserve(new_length);
+		memmove(data, str, new_length);
+		memset(data + new_length, 0, 1);
+		length = new_length;
+
 		modified = true;
 	}
 
@@ -139,11 +504,7 @@ struct SDLUI_String
 		}
 
 		i32 new_length = length + 1;
-		if (new_length > capacity)
-		{
-			capacity = ((new_length / SDLUI_STRING_CAPACITY) + 1) * SDLUI_STRING_CAPACITY;
-			data = (char*)realloc(data, capacity);
-		}
+		reserve(new_length);
 
 		if (pos == 0)
 		{
@@ -173,6 +534,8 @@ struct SDLUI_String
 			return false;
 		}
 
+		reserve(length);
+
 		if (pos == length - 1)
 		{
 			memset(data + length - 1, 0, 1);
@@ -209,6 +572,8 @@ struct SDLUI_Theme
 	SDL_Color col_textbox_bg = { 22, 22, 22, 255 };
 };
 
+struct SDLUI_LayoutItem;
+
 struct SDLUI_Control
 {
 	SDLUI_CONTROL_TYPE type;
@@ -220,7 +585,18 @@ struct SDLUI_Control
 	bool enabled = true;
 	bool owned_by_window = true;
 	bool do_process = false;
+	bool dirty = true;
+	SDL_Rect drawn;
 	SDLUI_Control* parent;
+	SDLUI_ID id;
+
+	// x and y are relative to the parent, the screen position is cached until layout_generation moves on.
+	i32 screen_x;
+	i32 screen_y;
+	u32 layout_generation;
+
+	// the slot this control has in a layout, NULL when it is placed by hand.
+	SDLUI_LayoutItem* layout_item;
 };
 
 struct __SDLUI_Font
@@ -229,10 +605,145 @@ struct __SDLUI_Font
 	i32 size = 13;
 	i32 width;
 	i32 height;
-	char ascii[96];
-	SDL_Texture* tex_font;
+
+	// glyphs in the baked range come from the baked atlas, the TTF is only opened for anything else.
+	bool baked;
 }SDLUI_Font;
 
+// A glyph rasterized ahead of time by sdlui_bake_font, its coverage is w*h bytes at offset in the baked coverage.
+struct SDLUI_BakedGlyph
+{
+	i32 advance;
+	i32 offset_x;
+	i32 w;
+	i32 h;
+	i32 offset;
+};
+
+// Define SDLUI_BAKED_FONT as the header written by tools/sdlui_bake_font.cpp to skip opening and rasterizing the font at startup.
+#ifdef SDLUI_BAKED_FONT
+#include SDLUI_BAKED_FONT
+#endif
+
+struct SDLUI_Glyph
+{
+	u32 codepoint;
+	i32 page;
+	SDL_Rect src;
+	i32 offset_x;
+	i32 advance;
+};
+
+struct SDLUI_GlyphPage
+{
+	SDL_Texture* tex;
+	i32 shelf_x;
+	i32 shelf_y;
+	i32 shelf_h;
+};
+
+struct __SDLUI_GlyphCache
+{
+	SDLUI_Glyph* glyphs;
+	i32 capacity = 0;
+	i32 count = 0;
+	SDLUI_GlyphPage pages[SDLUI_GLYPH_MAX_PAGES];
+	i32 num_pages = 0;
+	u32 generation = 0;
+
+	SDLUI_Glyph* find_slot(u32 codepoint)
+	{
+		i32 i = (codepoint * 2654435761u) & (capacity - 1);
+
+		while (glyphs[i].codepoint != 0 && glyphs[i].codepoint != codepoint)
+		{
+			i = (i + 1) & (capacity - 1);
+		}
+
+		return &glyphs[i];
+	}
+
+	void grow()
+	{
+		SDLUI_Glyph* old_glyphs = glyphs;
+		i32 old_capacity = capacity;
+
+		capacity = capacity == 0 ? 256 : capacity * 2;
+		glyphs = (SDLUI_Glyph*)calloc(capacity, sizeof(SDLUI_Glyph));
+
+		for (int i = 0; i < old_capacity; ++i)
+		{
+			if (old_glyphs[i].codepoint != 0)
+			{
+				*find_slot(old_glyphs[i].codepoint) = old_glyphs[i];
+			}
+		}
+
+		free(old_glyphs);
+	}
+}SDLUI_GlyphCache;
+
+struct __SDLUI_TextBatch
+{
+	SDL_Texture* target;
+	SDL_Texture* texture;
+	SDL_Vertex* vertices;
+	i32 vertex_count = 0;
+	i32 vertex_capacity = 0;
+	i32* indices;
+	i32 index_count = 0;
+	i32 index_capacity = 0;
+
+	void ensure_capacity(i32 num_quads)
+	{
+		if (vertex_count + num_quads * 4 > vertex_capacity)
+		{
+			vertex_capacity = vertex_capacity * 2 > vertex_count + num_quads * 4 ? vertex_capacity * 2 : vertex_count + num_quads * 4;
+			vertices = (SDL_Vertex*)realloc(vertices, vertex_capacity * sizeof(SDL_Vertex));
+		}
+
+		if (index_count + num_quads * 6 > index_capacity)
+		{
+			index_capacity = index_capacity * 2 > index_count + num_quads * 6 ? index_capacity * 2 : index_count + num_quads * 6;
+			indices = (i32*)realloc(indices, index_capacity * sizeof(i32));
+		}
+	}
+}SDLUI_TextBatch;
+
+struct SDLUI_RenderTarget
+{
+	SDL_Texture* tex;
+	i32 capacity_w;
+	i32 capacity_h;
+	bool in_use;
+};
+
+struct __SDLUI_TargetPool
+{
+	SDLUI_RenderTarget* targets;
+	i32 size = 0;
+	i32 capacity = 0;
+
+	SDLUI_RenderTarget* find(SDL_Texture* tex)
+	{
+		for (int i = 0; i < size; ++i)
+		{
+			if (targets[i].tex == tex)
+			{
+				return &targets[i];
+			}
+		}
+
+		return NULL;
+	}
+
+	void remove(i32 index)
+	{
+		memmove(targets + index, targets + index + 1, (size - index - 1) * sizeof(SDLUI_RenderTarget));
+		size--;
+	}
+}SDLUI_TargetPool;
+
 struct SDLUI_ArrayOfControls
 {
 	i32 capacity;
@@ -246,11 +757,19 @@ struct SDLUI_ArrayOfControls
 		size = 0;
 	}
 
+	void destroy()
+	{
+		free(data);
+		data = NULL;
+		capacity = 0;
+		size = 0;
+	}
+
 	void ensure_capacity()
 	{
 		if (size >= capacity)
 		{
-			capacity += SDLUI_COLLECTION_CHUNK;
+			capacity = capacity == 0 ? SDLUI_COLLECTION_CHUNK : capacity * 2;
 			data = (SDLUI_Control**)realloc(data, capacity * sizeof(SDLUI_Control*));
 		}
 	}
@@ -266,7 +785,7 @@ struct SDLUI_ArrayOfControls
 	{
 		for (int i = 0; i < size; ++i)
 		{
-			if ((i < size - 1) && elem == data[i])
+			if (elem == data[i])
 			{
 				i32 num_elements = size - i - 1;
 				memmove(data + i, data + i + 1, num_elements * sizeof(data));
@@ -293,23 +812,83 @@ struct SDLUI_ArrayOfControls
 
 SDLUI_ArrayOfControls SDLUI_Window_Collection;
 
-struct SDLUI_Control_Window : SDLUI_Control
+// Uniform grid over a window's client area. Each cell lists the children whose bounds touch it,
+// stored back to back in entries with cell_start giving where each cell begins.
+struct SDLUI_HitGrid
 {
-	i32 drag_x;
-	i32 drag_y;
-	bool is_dragged = false;
-	bool is_resized = false;
-	bool is_hovered = false;
-	SDLUI_RESIZE_DIRECTION resize_direction;
+	i32 cols;
+	i32 rows;
+	i32* cell_start;
+	i32* entries;
+	i32 num_controls;
+	bool dirty;
+
+	// children bounds while building, kept between builds and only grown.
+	SDL_Rect* bounds;
+	i32 bounds_capacity;
+};
+
+struct SDLUI_Control_Window;
+struct SDLUI_Layout;
+
+// One entry of a layout, either a control or a nested layout.
+struct SDLUI_LayoutItem
+{
+	SDLUI_Layout* owner;
+	SDLUI_Control* ctrl;
+	SDLUI_Layout* layout;
+	SDLUI_SIZE_RULE width_rule;
+	SDLUI_SIZE_RULE height_rule;
+	i32 weight;
+
+	// size the item wants, kept until the item is invalidated.
+	i32 natural_w;
+	i32 natural_h;
+	bool measured;
+
+	SDLUI_LayoutItem* next;
+};
+
+// Places its items in a column, a row or a grid inside the rect it is given. Measuring and arranging
+// are cached, only layouts that were invalidated or got a different rect are worked out again.
+struct SDLUI_Layout
+{
+	SDLUI_LAYOUT_TYPE type;
+	SDLUI_Control_Window* window;
+	SDLUI_LayoutItem* item;
+	SDLUI_LayoutItem* first;
+	SDLUI_LayoutItem* last;
+	i32 num_items;
+	i32 spacing;
+	i32 padding;
+	i32 columns;
+	SDL_Rect rect;
+	i32 measured_w;
+	i32 measured_h;
+	bool measure_dirty;
+	bool arrange_dirty;
+};
+
+struct SDLUI_Control_Window : SDLUI_Control
+{
+	i32 drag_x;
+	i32 drag_y;
+	bool is_dragged = false;
+	bool is_resized = false;
+	bool is_hovered = false;
+	SDLUI_RESIZE_DIRECTION resize_direction;
 	bool visible_last_frame = false;
 	bool enabled_last_frame = false;
 	SDLUI_String title;
-	SDL_Texture* tex_title;
 	SDL_Texture* tex_rect;
 	bool active;
+	bool close_hovered;
 	bool has_close_button;
 	bool can_be_resized;
 	SDLUI_ArrayOfControls children;
+	SDLUI_HitGrid hit_grid;
+	SDLUI_Arena arena;
+	SDLUI_Layout* root_layout;
 };
 
 struct SDLUI_Control_Button : SDLUI_Control
@@ -317,7 +896,6 @@ struct SDLUI_Control_Button : SDLUI_Control
 	SDLUI_String text;
 	SDLUI_ALIGN align;
 	SDLUI_BUTTON_STATE state;
-	SDL_Texture* tex_text;
 };
 
 struct SDLUI_Control_SliderInt : SDLUI_Control
@@ -334,14 +912,12 @@ struct SDLUI_Control_CheckBox : SDLUI_Control
 {
 	bool checked;
 	SDLUI_String text;
-	SDL_Texture* tex_text;
 };
 
 struct SDLUI_Control_ToggleButton : SDLUI_Control
 {
 	bool checked;
 	SDLUI_String text;
-	SDL_Texture* tex_text;
 };
 
 struct SDLUI_Control_RadioButton : SDLUI_Control
@@ -350,7 +926,6 @@ struct SDLUI_Control_RadioButton : SDLUI_Control
 	bool checked;
 	bool checked_changed;
 	SDLUI_String text;
-	SDL_Texture* tex_text;
 };
 
 struct SDLUI_Control_TextBox : SDLUI_Control
@@ -360,25 +935,304 @@ struct SDLUI_Control_TextBox : SDLUI_Control
 	i32 select_start;
 	i32 select_end;
 	i32 cursor_pos;
-	i32 max_chars;
 	i32 scroll;
 	bool focused;
 };
 
+// Text with a gap at the place it was last edited. Typing fills the gap, so only moving the edit point
+// moves bytes around, and only the ones between the old and the new place.
+struct SDLUI_GapBuffer
+{
+	char* data;
+	i32 capacity;
+	i32 gap_start;
+	i32 gap_end;
+
+	void create()
+	{
+		data = NULL;
+		capacity = 0;
+		gap_start = 0;
+		gap_end = 0;
+		reserve(1);
+	}
+
+	void destroy()
+	{
+		free(data);
+		data = NULL;
+		capacity = 0;
+		gap_start = 0;
+		gap_end = 0;
+	}
+
+	i32 length()
+	{
+		return capacity - (gap_end - gap_start);
+	}
+
+	char at(i32 pos)
+	{
+		return pos < gap_start ? data[pos] : data[pos + gap_end - gap_start];
+	}
+
+	void move_gap(i32 pos)
+	{
+		if (pos < gap_start)
+		{
+			i32 size = gap_start - pos;
+			memmove(data + gap_end - size, data + pos, size);
+			gap_start -= size;
+			gap_end -= size;
+		}
+		else if (pos > gap_start)
+		{
+			i32 size = pos - gap_start;
+			memmove(data + gap_start, data + gap_end, size);
+			gap_start += size;
+			gap_end += size;
+		}
+	}
+
+	// makes the gap at least size bytes long.
+	void reserve(i32 size)
+	{
+		if (gap_end - gap_start >= size)
+		{
+			return;
+		}
+
+		i32 used = length();
+		i32 new_capacity = capacity == 0 ? 4096 : capacity * 2;
+		while (new_capacity - used < size)
+		{
+			new_capacity *= 2;
+		}
+
+		// a few zeroed bytes past the end so decoding a broken codepoint at the very end stays inside the allocation.
+		char* new_data = (char*)malloc(new_capacity + 4);
+		memset(new_data + new_capacity, 0, 4);
+
+		i32 tail = capacity - gap_end;
+		memcpy(new_data, data, gap_start);
+		memcpy(new_data + new_capacity - tail, data + gap_end, tail);
+		free(data);
+
+		data = new_data;
+		gap_end = new_capacity - tail;
+		capacity = new_capacity;
+	}
+
+	void insert(i32 pos, const char* text, i32 size)
+	{
+		reserve(size);
+		move_gap(pos);
+		memcpy(data + gap_start, text, size);
+		gap_start += size;
+	}
+
+	void erase(i32 pos, i32 size)
+	{
+		move_gap(pos);
+		gap_end += size;
+	}
+
+	void copy(i32 pos, i32 size, char* out)
+	{
+		i32 before = gap_start - pos;
+		before = before < 0 ? 0 : before > size ? size : before;
+
+		memcpy(out, data + pos, before);
+		memcpy(out + before, data + pos + before + gap_end - gap_start, size - before);
+	}
+};
+
+// Byte offset where each line of a gap buffer starts. Edits patch it instead of scanning the text again.
+struct SDLUI_LineIndex
+{
+	i32* starts;
+	i32 count;
+	i32 capacity;
+
+	void create()
+	{
+		capacity = 64;
+		starts = (i32*)malloc(capacity * sizeof(i32));
+		starts[0] = 0;
+		count = 1;
+	}
+
+	void destroy()
+	{
+		free(starts);
+		starts = NULL;
+		count = 0;
+		capacity = 0;
+	}
+
+	void reserve(i32 size)
+	{
+		if (count + size > capacity)
+		{
+			while (count + size > capacity)
+			{
+				capacity *= 2;
+			}
+			starts = (i32*)realloc(starts, capacity * sizeof(i32));
+		}
+	}
+
+	// the line holding byte pos.
+	i32 line_of(i32 pos)
+	{
+		i32 lo = 0;
+		i32 hi = count - 1;
+
+		while (lo < hi)
+		{
+			i32 mid = (lo + hi + 1) / 2;
+			if (starts[mid] <= pos)
+			{
+				lo = mid;
+			}
+			else
+			{
+				hi = mid - 1;
+			}
+		}
+
+		return lo;
+	}
+};
+
+// One insertion or deletion, with its bytes kept in the editor's undo text so it can be undone and redone.
+struct SDLUI_EditRecord
+{
+	i32 pos;
+	i32 length;
+	i32 text;
+	bool inserted;
+	u32 group;
+
+	// where the cursor and the selection were before the edit.
+	i32 cursor;
+	i32 anchor;
+};
+
+// Multi-line editor meant for large texts. The text lives in a gap buffer with a line index next to it,
+// and tex_text keeps the visible rows so only the rows an edit touched are drawn again.
+struct SDLUI_Control_TextEditor : SDLUI_Control
+{
+	SDLUI_GapBuffer buffer;
+	SDLUI_LineIndex lines;
+	i32 cursor;
+	i32 anchor;
+	i32 cursor_x;
+	i32 preferred_x;
+	i32 first_line;
+	i32 scroll_x;
+	i32 line_height;
+	i32 scrollbar_thickness;
+	i32 drag_offset;
+	bool is_dragging;
+	bool is_selecting;
+	bool focused;
+	SDL_Texture* tex_text;
+
+	// lines whose rows in tex_text have to be drawn again, none when dirty_first > dirty_last.
+	i32 dirty_first;
+	i32 dirty_last;
+
+	SDLUI_EditRecord* undo;
+	i32 num_undo;
+	i32 undo_pos;
+	i32 undo_capacity;
+	char* undo_text;
+	i32 undo_text_length;
+	i32 undo_text_capacity;
+	u32 undo_group;
+	SDLUI_EDIT_KIND last_edit;
+
+	// lines split by the gap are copied here to be measured and drawn.
+	char* scratch;
+	i32 scratch_capacity;
+
+	i32 text_width()
+	{
+		i32 tw = w - 2 * SDLUI_MARGIN - scrollbar_thickness;
+		return tw > 1 ? tw : 1;
+	}
+
+	i32 text_height()
+	{
+		i32 th = h - 2 * SDLUI_MARGIN;
+		return th > 1 ? th : 1;
+	}
+
+	i32 visible_lines()
+	{
+		i32 num = text_height() / line_height;
+		return num > 1 ? num : 1;
+	}
+
+	i32 max_first_line()
+	{
+		return lines.count > visible_lines() ? lines.count - visible_lines() : 0;
+	}
+
+	i32 selection_start()
+	{
+		return anchor < cursor ? anchor : cursor;
+	}
+
+	i32 selection_end()
+	{
+		return anchor > cursor ? anchor : cursor;
+	}
+
+	i32 thumb_size()
+	{
+		i32 size = (i32)((i64)h * visible_lines() / lines.count);
+		return size < 16 ? 16 : size > h ? h : size;
+	}
+
+	i32 thumb_pos()
+	{
+		return max_first_line() > 0 ? (i32)((i64)first_line * (h - thumb_size()) / max_first_line()) : 0;
+	}
+};
+
+// Everything the controls need from the events of one frame, filled in by SDLUI_EventHandler.
+struct __SDLUI_Input
+{
+	i32 mouse_x;
+	i32 mouse_y;
+	u8 mouse_down[6] = { 0 };
+	u8 mouse_down_last_frame[6] = { 0 };
+	u8 mouse_pressed[6] = { 0 };
+	u8 mouse_released[6] = { 0 };
+	i32 wheel_x;
+	i32 wheel_y;
+
+	// key and text events in the order they arrived.
+	SDL_Event events[SDLUI_MAX_INPUT_EVENTS];
+	i32 num_events = 0;
+}SDLUI_Input;
+
 struct __SDLUI_Core
 {
 	SDL_Window* window;
 	SDL_Renderer* renderer;
 	i32 window_width;
 	i32 window_height;
-	u8 mouse_current_frame[5] = { 0 };
-	u8 mouse_last_frame[5] = { 0 };
-	i32 mouse_wheel_y;
-	i32 mouse_wheel_x;
 	SDLUI_Theme theme;
 	SDLUI_Control_Window* active_window;
+	SDLUI_Control* hot_control;
+	u32 layout_generation = 1;
 
-	SDL_Event e;
+	// bumped for every window created and never reused, so ids stay unique after windows are destroyed.
+	u32 window_counter = 0;
+	SDLUI_COMPOSITOR compositor = SDLUI_COMPOSITOR_TEXTURES;
 
 	SDL_Cursor* cursor_arrow;
 	SDL_Cursor* cursor_ibeam;
@@ -387,20 +1241,38 @@ struct __SDLUI_Core
 
 	SDL_Cursor* cursor_size_nwse;
 	SDL_Cursor* cursor_size_nesw;
-
-	SDL_Texture* tex_tick;
-	SDL_Texture* tex_circle;
-	SDL_Texture* tex_circle_fill_1;
-	SDL_Texture* tex_circle_fill_2;
-	SDL_Texture* tex_toggle;
-	SDL_Texture* tex_close;
 }SDLUI_Core;
 
+struct SDLUI_Gradient
+{
+	SDL_Color color;
+	i32 w;
+	i32 h;
+	i32 interv;
+	SDL_Texture* tex;
+};
+
+// Textures that come from the theme rather than from a control, built once per renderer and shared by every window.
+// The icons are packed into one atlas and a gradient is only drawn the first time it is asked for.
+struct __SDLUI_ThemeCache
+{
+	SDL_Renderer* renderer;
+	SDL_Texture* atlas;
+	SDL_Rect icons[SDLUI_ICON_COUNT];
+	SDLUI_Gradient* gradients;
+	i32 num_gradients = 0;
+	i32 gradient_capacity = 0;
+}SDLUI_ThemeCache;
+
+i32 SDLUI_MeasureText(const char* text);
+void SDLUI_InvalidateLayout(SDLUI_Control* ctrl);
+void SDLUI_UpdateLayout(SDLUI_Control_Window* wnd);
+void SDLUI_ExecuteCommands();
+
 struct SDLUI_Control_Tab : SDLUI_Control
 {
 	i32 index;
 	SDLUI_String text;
-	SDL_Texture* tex_text;
 	SDLUI_ArrayOfControls children;
 };
 
@@ -413,20 +1285,15 @@ struct SDLUI_Control_TabContainer : SDLUI_Control
 
 	void add_tab(char* text)
 	{
-		SDLUI_Control_Tab* tab = (SDLUI_Control_Tab*)malloc(sizeof(SDLUI_Control_Tab));
+		SDLUI_Control_Tab* tab = (SDLUI_Control_Tab*)((SDLUI_Control_Window*)this->parent)->arena.alloc(sizeof(SDLUI_Control_Tab));
 
 		tab->type = SDLUI_CONTROL_TYPE_TAB;
 		tab->text.create(text);
-		tab->w = (tab->text.length) * SDLUI_Font.width;
+		tab->w = SDLUI_MeasureText(tab->text.data);
 		tab->h = SDLUI_Font.height;
 		tab->children.create();
 		tab->index = tabs.size;
 
-		SDL_Color c = { 255, 255, 255, 255 };
-		SDL_Surface* s = TTF_RenderText_Blended(SDLUI_Font.handle, tab->text.data, c);
-		tab->tex_text = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-		SDL_FreeSurface(s);
-
 		this->tabs.push(tab);
 		this->active_tab = tab;
 
@@ -470,114 +1337,497 @@ struct SDLUI_Control_TabContainer : SDLUI_Control
 	}
 };
 
-struct SDLUI_Control_Label : SDLUI_Control
+struct SDLUI_ScrollAreaState
 {
-	SDL_Texture* tex_text;
+	i32 mx_offset;
+	i32 my_offset;
 };
 
-struct SDLUI_Control_Text : SDLUI_Control
+struct SDLUI_ListState
 {
-	SDLUI_String text;
-	bool modified;
-	SDL_Texture* tex_text;
+	i32 counter;
+	i32 offset_y;
+	bool clicked;
+
+	// a hash of everything fed to the list this pass and of what the window last showed.
+	SDLUI_ID content;
+	SDLUI_ID drawn_content;
 };
 
-struct SDLUI_Control_ScrollArea : SDLUI_Control
+enum SDLUI_COMMAND_TYPE
 {
-	i32 content_width;
-	i32 content_height;
-	i32 client_width;
-	i32 client_height;
-	i32 scrollbar_thickness;
-	i32 track_size_h;
-	i32 track_size_v;
-	i32 thumb_size_h;
-	i32 thumb_size_v;
-	i32 scroll_x;
-	i32 scroll_y;
-	bool is_changing_v;
-	bool is_changing_h;
-	SDL_Texture* tex_rect;
+	SDLUI_COMMAND_CREATE_WINDOW,
+	SDLUI_COMMAND_CREATE_BUTTON,
+	SDLUI_COMMAND_CREATE_TEXT,
+	SDLUI_COMMAND_CREATE_CHECKBOX,
+	SDLUI_COMMAND_CREATE_SLIDER_INT,
+	SDLUI_COMMAND_CREATE_TEXTBOX,
+	SDLUI_COMMAND_SET_TEXT,
+	SDLUI_COMMAND_SET_VALUE,
+	SDLUI_COMMAND_SET_VISIBLE,
+	SDLUI_COMMAND_MOVE,
+	SDLUI_COMMAND_DESTROY_WINDOW
 };
 
-struct SDLUI_Control_List : SDLUI_Control
+struct SDLUI_Command
 {
-	SDLUI_Control_ScrollArea* scroll_area;
-	i32 num_items;
-	i32 selected_index;
-	i32 max_string_width;
-	const char* cur_item;
+	SDLUI_COMMAND_TYPE type;
+	SDLUI_ID id;
+	SDLUI_ID window;
+	i32 x;
+	i32 y;
+	i32 w;
+	i32 h;
+	i32 value;
+	i32 min;
+	i32 max;
+	i32 text; // offset into the list's text buffer, -1 for none
 };
 
-#include "sdlui.h"
+// UI changes recorded without touching any sdlui state, so it can be filled on any thread and handed
+// to SDLUI_SubmitCommands. Controls are named by IDs from SDLUI_GetID chosen by whoever records them.
+struct SDLUI_CommandList
+{
+	SDLUI_Command* commands;
+	i32 num_commands;
+	i32 capacity;
+	char* text;
+	i32 text_length;
+	i32 text_capacity;
+	SDLUI_CommandList* next;
 
-const uint8_t sdlui_png_close[] = {
-    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
-    0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x1e, 0x08, 0x06, 0x00, 0x00, 0x00, 0x3b, 0x30, 0xae,
-    0xa2, 0x00, 0x00, 0x00, 0x09, 0x70, 0x48, 0x59, 0x73, 0x00, 0x00, 0x0b, 0x13, 0x00, 0x00, 0x0b,
-    0x13, 0x01, 0x00, 0x9a, 0x9c, 0x18, 0x00, 0x00, 0x39, 0xec, 0x69, 0x54, 0x58, 0x74, 0x58, 0x4d,
-    0x4c, 0x3a, 0x63, 0x6f, 0x6d, 0x2e, 0x61, 0x64, 0x6f, 0x62, 0x65, 0x2e, 0x78, 0x6d, 0x70, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x3c, 0x3f, 0x78, 0x70, 0x61, 0x63, 0x6b, 0x65, 0x74, 0x20, 0x62, 0x65,
-    0x67, 0x69, 0x6e, 0x3d, 0x22, 0xef, 0xbb, 0xbf, 0x22, 0x20, 0x69, 0x64, 0x3d, 0x22, 0x57, 0x35,
-    0x4d, 0x30, 0x4d, 0x70, 0x43, 0x65, 0x68, 0x69, 0x48, 0x7a, 0x72, 0x65, 0x53, 0x7a, 0x4e, 0x54,
-    0x63, 0x7a, 0x6b, 0x63, 0x39, 0x64, 0x22, 0x3f, 0x3e, 0x0a, 0x3c, 0x78, 0x3a, 0x78, 0x6d, 0x70,
-    0x6d, 0x65, 0x74, 0x61, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x78, 0x3d, 0x22, 0x61, 0x64,
-    0x6f, 0x62, 0x65, 0x3a, 0x6e, 0x73, 0x3a, 0x6d, 0x65, 0x74, 0x61, 0x2f, 0x22, 0x20, 0x78, 0x3a,
-    0x78, 0x6d, 0x70, 0x74, 0x6b, 0x3d, 0x22, 0x41, 0x64, 0x6f, 0x62, 0x65, 0x20, 0x58, 0x4d, 0x50,
-    0x20, 0x43, 0x6f, 0x72, 0x65, 0x20, 0x35, 0x2e, 0x36, 0x2d, 0x63, 0x30, 0x36, 0x37, 0x20, 0x37,
-    0x39, 0x2e, 0x31, 0x35, 0x37, 0x37, 0x34, 0x37, 0x2c, 0x20, 0x32, 0x30, 0x31, 0x35, 0x2f, 0x30,
-    0x33, 0x2f, 0x33, 0x30, 0x2d, 0x32, 0x33, 0x3a, 0x34, 0x30, 0x3a, 0x34, 0x32, 0x20, 0x20, 0x20,
-    0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x3c, 0x72, 0x64, 0x66, 0x3a,
-    0x52, 0x44, 0x46, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x72, 0x64, 0x66, 0x3d, 0x22, 0x68,
-    0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67,
-    0x2f, 0x31, 0x39, 0x39, 0x39, 0x2f, 0x30, 0x32, 0x2f, 0x32, 0x32, 0x2d, 0x72, 0x64, 0x66, 0x2d,
-    0x73, 0x79, 0x6e, 0x74, 0x61, 0x78, 0x2d, 0x6e, 0x73, 0x23, 0x22, 0x3e, 0x0a, 0x20, 0x20, 0x20,
-    0x20, 0x20, 0x20, 0x3c, 0x72, 0x64, 0x66, 0x3a, 0x44, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74,
-    0x69, 0x6f, 0x6e, 0x20, 0x72, 0x64, 0x66, 0x3a, 0x61, 0x62, 0x6f, 0x75, 0x74, 0x3d, 0x22, 0x22,
-    0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c,
-    0x6e, 0x73, 0x3a, 0x78, 0x6d, 0x70, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x6e,
-    0x73, 0x2e, 0x61, 0x64, 0x6f, 0x62, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x78, 0x61, 0x70, 0x2f,
-    0x31, 0x2e, 0x30, 0x2f, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-    0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x64, 0x63, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70,
-    0x3a, 0x2f, 0x2f, 0x70, 0x75, 0x72, 0x6c, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x64, 0x63, 0x2f, 0x65,
-    0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x73, 0x2f, 0x31, 0x2e, 0x31, 0x2f, 0x22, 0x0a, 0x20, 0x20,
-    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a,
-    0x70, 0x68, 0x6f, 0x74, 0x6f, 0x73, 0x68, 0x6f, 0x70, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a,
-    0x2f, 0x2f, 0x6e, 0x73, 0x2e, 0x61, 0x64, 0x6f, 0x62, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x70,
-    0x68, 0x6f, 0x74, 0x6f, 0x73, 0x68, 0x6f, 0x70, 0x2f, 0x31, 0x2e, 0x30, 0x2f, 0x22, 0x0a, 0x20,
-    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73,
-    0x3a, 0x78, 0x6d, 0x70, 0x4d, 0x4d, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x6e,
-    0x73, 0x2e, 0x61, 0x64, 0x6f, 0x62, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x78, 0x61, 0x70, 0x2f,
-    0x31, 0x2e, 0x30, 0x2f, 0x6d, 0x6d, 0x2f, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-    0x20, 0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x73, 0x74, 0x45, 0x76, 0x74,
-    0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x6e, 0x73, 0x2e, 0x61, 0x64, 0x6f, 0x62,
-    0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x78, 0x61, 0x70, 0x2f, 0x31, 0x2e, 0x30, 0x2f, 0x73, 0x54,
-    0x79, 0x70, 0x65, 0x2f, 0x52, 0x65, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x45, 0x76, 0x65, 0x6e,
-    0x74, 0x23, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-    0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x74, 0x69, 0x66, 0x66, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70,
-    0x3a, 0x2f, 0x2f, 0x6e, 0x73, 0x2e, 0x61, 0x64, 0x6f, 0x62, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f,
-    0x74, 0x69, 0x66, 0x66, 0x2f, 0x31, 0x2e, 0x30, 0x2f, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x65, 0x78, 0x69,
-    0x66, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x6e, 0x73, 0x2e, 0x61, 0x64, 0x6f,
-    0x62, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x65, 0x78, 0x69, 0x66, 0x2f, 0x31, 0x2e, 0x30, 0x2f,
-    0x22, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x78, 0x6d, 0x70,
-    0x3a, 0x43, 0x72, 0x65, 0x61, 0x74, 0x6f, 0x72, 0x54, 0x6f, 0x6f, 0x6c, 0x3e, 0x41, 0x64, 0x6f,
-    0x62, 0x65, 0x20, 0x50, 0x68, 0x6f, 0x74, 0x6f, 0x73, 0x68, 0x6f, 0x70, 0x20, 0x43, 0x43, 0x20,
-    0x32, 0x30, 0x31, 0x35, 0x20, 0x28, 0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x73, 0x29, 0x3c, 0x2f,
-    0x78, 0x6d, 0x70, 0x3a, 0x43, 0x72, 0x65, 0x61, 0x74, 0x6f, 0x72, 0x54, 0x6f, 0x6f, 0x6c, 0x3e,
-    0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x78, 0x6d, 0x70, 0x3a, 0x43,
-    0x72, 0x65, 0x61, 0x74, 0x65, 0x44, 0x61, 0x74, 0x65, 0x3e, 0x32, 0x30, 0x32, 0x30, 0x2d, 0x30,
-    0x38, 0x2d, 0x30, 0x32, 0x54, 0x31, 0x30, 0x3a, 0x32, 0x38, 0x3a, 0x34, 0x37, 0x2b, 0x30, 0x33,
-    0x3a, 0x30, 0x30, 0x3c, 0x2f, 0x78, 0x6d, 0x70, 0x3a, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x44,
-    0x61, 0x74, 0x65, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x78,
-    0x6d, 0x70, 0x3a, 0x4d, 0x6f, 0x64, 0x69, 0x66, 0x79, 0x44, 0x61, 0x74, 0x65, 0x3e, 0x32, 0x30,
-    0x32, 0x30, 0x2d, 0x30, 0x38, 0x2d, 0x30, 0x32, 0x54, 0x31, 0x30, 0x3a, 0x33, 0x33, 0x3a, 0x31,
-    0x33, 0x2b, 0x30, 0x33, 0x3a, 0x30, 0x30, 0x3c, 0x2f, 0x78, 0x6d, 0x70, 0x3a, 0x4d, 0x6f, 0x64,
-    0x69, 0x66, 0x79, 0x44, 0x61, 0x74, 0x65, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-    0x20, 0x20, 0x3c, 0x78, 0x6d, 0x70, 0x3a, 0x4d, 0x65, 0x74, 0x61, 0x64, 0x61, 0x74, 0x61, 0x44,
-    0x61, 0x74, 0x65, 0x3e, 0x32, 0x30, 0x32, 0x30, 0x2d, 0x30, 0x38, 0x2d, 0x30, 0x32, 0x54, 0x31,
-    0x30, 0x3a, 0x33, 0x33, 0x3a, 0x31, 0x33, 0x2b, 0x30, 0x33, 0x3a, 0x30, 0x30, 0x3c, 0x2f, 0x78,
-    0x6d, 0x70, 0x3a, 0x4d, 0x65, 0x74, 0x61, 0x64, 0x61, 0x74, 0x61, 0x44, 0x61, 0x74, 0x65, 0x3e,
+	void create()
+	{
+		commands = NULL;
+		num_commands = 0;
+		capacity = 0;
+		text = NULL;
+		text_length = 0;
+		text_capacity = 0;
+		next = NULL;
+	}
+
+	void destroy()
+	{
+		free(commands);
+		free(text);
+		create();
+	}
+
+	SDLUI_Command* push(SDLUI_COMMAND_TYPE type, SDLUI_ID id, const char* str = NULL)
+	{
+		if (num_commands >= capacity)
+		{
+			capacity = capacity == 0 ? 32 : capacity * 2;
+			commands = (SDLUI_Command*)realloc(commands, capacity * sizeof(SDLUI_Command));
+		}
+
+		SDLUI_Command* cmd = &commands[num_commands++];
+		memset(cmd, 0, sizeof(SDLUI_Command));
+		cmd->type = type;
+		cmd->id = id;
+		cmd->text = -1;
+
+		if (str != NULL)
+		{
+			i32 length = strlen(str) + 1;
+			if (text_length + length > text_capacity)
+			{
+				text_capacity = text_capacity == 0 ? 256 : text_capacity;
+				while (text_length + length > text_capacity)
+				{
+					text_capacity *= 2;
+				}
+				text = (char*)realloc(text, text_capacity);
+			}
+
+			memcpy(text + text_length, str, length);
+			cmd->text = text_length;
+			text_length += length;
+		}
+
+		return cmd;
+	}
+
+	void create_window(SDLUI_ID id, i32 x, i32 y, i32 w, i32 h, const char* title)
+	{
+		SDLUI_Command* cmd = push(SDLUI_COMMAND_CREATE_WINDOW, id, title);
+		cmd->x = x;
+		cmd->y = y;
+		cmd->w = w;
+		cmd->h = h;
+	}
+
+	void create_button(SDLUI_ID id, SDLUI_ID window, i32 x, i32 y, const char* text)
+	{
+		SDLUI_Command* cmd = push(SDLUI_COMMAND_CREATE_BUTTON, id, text);
+		cmd->window = window;
+		cmd->x = x;
+		cmd->y = y;
+	}
+
+	void create_text(SDLUI_ID id, SDLUI_ID window, i32 x, i32 y, const char* text)
+	{
+		SDLUI_Command* cmd = push(SDLUI_COMMAND_CREATE_TEXT, id, text);
+		cmd->window = window;
+		cmd->x = x;
+		cmd->y = y;
+	}
+
+	void create_checkbox(SDLUI_ID id, SDLUI_ID window, i32 x, i32 y, const char* text, bool checked)
+	{
+		SDLUI_Command* cmd = push(SDLUI_COMMAND_CREATE_CHECKBOX, id, text);
+		cmd->window = window;
+		cmd->x = x;
+		cmd->y = y;
+		cmd->value = checked;
+	}
+
+	void create_slider_int(SDLUI_ID id, SDLUI_ID window, i32 x, i32 y, i32 min, i32 max, i32 value)
+	{
+		SDLUI_Command* cmd = push(SDLUI_COMMAND_CREATE_SLIDER_INT, id);
+		cmd->window = window;
+		cmd->x = x;
+		cmd->y = y;
+		cmd->min = min;
+		cmd->max = max;
+		cmd->value = value;
+	}
+
+	void create_textbox(SDLUI_ID id, SDLUI_ID window, i32 x, i32 y, i32 w)
+	{
+		SDLUI_Command* cmd = push(SDLUI_COMMAND_CREATE_TEXTBOX, id);
+		cmd->window = window;
+		cmd->x = x;
+		cmd->y = y;
+		cmd->w = w;
+	}
+
+	void set_text(SDLUI_ID id, const char* text)
+	{
+		push(SDLUI_COMMAND_SET_TEXT, id, text);
+	}
+
+	void set_value(SDLUI_ID id, i32 value)
+	{
+		push(SDLUI_COMMAND_SET_VALUE, id)->value = value;
+	}
+
+	void set_visible(SDLUI_ID id, bool visible)
+	{
+		push(SDLUI_COMMAND_SET_VISIBLE, id)->value = visible;
+	}
+
+	void move(SDLUI_ID id, i32 x, i32 y)
+	{
+		SDLUI_Command* cmd = push(SDLUI_COMMAND_MOVE, id);
+		cmd->x = x;
+		cmd->y = y;
+	}
+
+	void destroy_window(SDLUI_ID id)
+	{
+		push(SDLUI_COMMAND_DESTROY_WINDOW, id);
+	}
+};
+
+// Lists submitted from any thread, waiting for the UI thread to run them.
+struct __SDLUI_CommandQueue
+{
+	SDL_mutex* mutex;
+	SDLUI_CommandList* head;
+	SDLUI_CommandList* tail;
+}SDLUI_CommandQueue;
+
+struct SDLUI_LogLine
+{
+	SDL_atomic_t sequence;
+	i32 length;
+	char text[SDLUI_LOG_LINE_SIZE];
+};
+
+static_assert((SDLUI_LOG_CAPACITY & (SDLUI_LOG_CAPACITY - 1)) == 0, "SDLUI_LOG_CAPACITY has to be a power of two, tickets are masked with it");
+
+// The last SDLUI_LOG_CAPACITY lines logged from any thread. Writers claim a ticket with one atomic add and
+// overwrite the oldest line, readers check the line's sequence before and after copying it. Nobody waits.
+struct __SDLUI_LogRing
+{
+	SDLUI_LogLine lines[SDLUI_LOG_CAPACITY];
+	SDL_atomic_t head;
+
+	u32 next_ticket()
+	{
+		return (u32)SDL_AtomicGet(&head);
+	}
+
+	// copies the line with the given ticket to out, which has room for SDLUI_LOG_LINE_SIZE bytes.
+	SDLUI_LOG_LINE_STATE read(u32 ticket, char* out, i32* length)
+	{
+		SDLUI_LogLine* line = &lines[ticket & (SDLUI_LOG_CAPACITY - 1)];
+		u32 before = (u32)SDL_AtomicGet(&line->sequence);
+
+		if (before != ticket + 1)
+		{
+			// either its writer isn't done yet, or newer lines have already taken the slot.
+			return next_ticket() - ticket > SDLUI_LOG_CAPACITY ? SDLUI_LOG_LINE_LOST : SDLUI_LOG_LINE_PENDING;
+		}
+
+		*length = line->length < 0 ? 0 : line->length > SDLUI_LOG_LINE_SIZE - 1 ? SDLUI_LOG_LINE_SIZE - 1 : line->length;
+		memcpy(out, line->text, *length);
+		out[*length] = '\0';
+
+		SDL_MemoryBarrierAcquire();
+		return (u32)SDL_AtomicGet(&line->sequence) == before ? SDLUI_LOG_LINE_READY : SDLUI_LOG_LINE_LOST;
+	}
+}SDLUI_LogRing;
+
+// Lists the log lines containing filter. New lines are searched a bounded number per frame,
+// so logging a burst or changing the filter never stalls one.
+struct SDLUI_Control_Console : SDLUI_Control
+{
+	u32 scanned;
+	u32 matches[SDLUI_LOG_CAPACITY];
+	u32 match_start;
+	i32 num_matches;
+	char filter[SDLUI_LOG_LINE_SIZE];
+	i32 item_height;
+	i32 scroll_y;
+	i32 scrollbar_thickness;
+	i32 drag_offset;
+	bool is_dragging;
+	bool follow;
+
+	u32 match(i32 index)
+	{
+		return matches[(match_start + index) & (SDLUI_LOG_CAPACITY - 1)];
+	}
+
+	i32 content_height()
+	{
+		return num_matches * item_height;
+	}
+
+	i32 max_scroll()
+	{
+		return content_height() > h ? content_height() - h : 0;
+	}
+
+	i32 thumb_size()
+	{
+		i32 size = content_height() > 0 ? (i32)((i64)h * h / content_height()) : h;
+		return size < 16 ? 16 : size;
+	}
+
+	i32 thumb_pos()
+	{
+		return max_scroll() > 0 ? (i32)((i64)scroll_y * (h - thumb_size()) / max_scroll()) : 0;
+	}
+};
+
+struct SDLUI_Control_Label : SDLUI_Control
+{
+	SDLUI_String text;
+};
+
+struct SDLUI_Control_Text : SDLUI_Control
+{
+	SDLUI_String text;
+	bool modified;
+};
+
+struct SDLUI_Control_ScrollArea : SDLUI_Control
+{
+	i32 content_width;
+	i32 content_height;
+	i32 client_width;
+	i32 client_height;
+	i32 scrollbar_thickness;
+	i32 track_size_h;
+	i32 track_size_v;
+	i32 thumb_size_h;
+	i32 thumb_size_v;
+	i32 scroll_x;
+	i32 scroll_y;
+	bool is_changing_v;
+	bool is_changing_h;
+	SDL_Texture* tex_rect;
+};
+
+typedef const char* (*SDLUI_ListItemProvider)(i32 index, void* user_data);
+
+struct SDLUI_Control_VirtualList : SDLUI_Control
+{
+	i32 num_items;
+	i32 selected_index;
+	i32 item_height;
+	i32 scroll_y;
+	i32 scrollbar_thickness;
+	i32 drag_offset;
+	bool is_dragging;
+	SDLUI_ListItemProvider get_item;
+	void* user_data;
+
+	i32 content_height()
+	{
+		return num_items * item_height;
+	}
+
+	i32 max_scroll()
+	{
+		return content_height() > h ? content_height() - h : 0;
+	}
+
+	i32 thumb_size()
+	{
+		i32 size = content_height() > 0 ? (i32)((i64)h * h / content_height()) : h;
+		return size < 16 ? 16 : size;
+	}
+
+	i32 thumb_pos()
+	{
+		return max_scroll() > 0 ? (i32)((i64)scroll_y * (h - thumb_size()) / max_scroll()) : 0;
+	}
+};
+
+// Draws the last capacity samples pushed to it. Samples are reduced to a min and a max per pixel column,
+// so any number of them is drawn with at most two vertices per column in one SDL_RenderGeometry call.
+struct SDLUI_Control_Plot : SDLUI_Control
+{
+	SDLUI_PLOT_TYPE plot_type;
+	float* samples;
+	i32 capacity;
+	i32 count;
+	i32 head;
+	float min;
+	float max;
+	SDL_Color color;
+
+	// geometry from the last time the samples changed, with the range it was drawn for.
+	SDL_Vertex* vertices;
+	i32* indices;
+	i32 num_vertices;
+	i32 num_indices;
+	i32 vertex_capacity;
+	i32 index_capacity;
+	i32 geometry_x;
+	i32 geometry_y;
+	float drawn_min;
+	float drawn_max;
+	bool geometry_dirty;
+
+	float sample(i32 index)
+	{
+		return samples[(head - count + index + capacity) % capacity];
+	}
+};
+
+// A value shown by an inspector. The bits it had when it was last formatted are kept so it is only
+// formatted again once it changes.
+struct SDLUI_InspectorField
+{
+	const char* name;
+	SDLUI_VALUE_TYPE value_type;
+	const void* value;
+	u32 last;
+	i32 length;
+	bool formatted;
+};
+
+// Shows named values living somewhere else, one per row. All of the formatted values share one buffer
+// with SDLUI_INSPECTOR_VALUE_SIZE bytes per field, so watching them costs a compare per field each frame.
+struct SDLUI_Control_Inspector : SDLUI_Control
+{
+	SDLUI_InspectorField* fields;
+	char* text;
+	i32 num_fields;
+	i32 capacity;
+	i32 item_height;
+	i32 value_x;
+
+	char* field_text(i32 index)
+	{
+		return text + index * SDLUI_INSPECTOR_VALUE_SIZE;
+	}
+};
+
+struct SDLUI_Control_List : SDLUI_Control
+{
+	SDLUI_Control_ScrollArea* scroll_area;
+	i32 num_items;
+	i32 selected_index;
+	i32 max_string_width;
+	const char* cur_item;
+};
+
+#include "sdlui.h"
+
+const uint8_t sdlui_png_close[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x1e, 0x08, 0x06, 0x00, 0x00, 0x00, 0x3b, 0x30, 0xae,
+    0xa2, 0x00, 0x00, 0x00, 0x09, 0x70, 0x48, 0x59, 0x73, 0x00, 0x00, 0x0b, 0x13, 0x00, 0x00, 0x0b,
+    0x13, 0x01, 0x00, 0x9a, 0x9c, 0x18, 0x00, 0x00, 0x39, 0xec, 0x69, 0x54, 0x58, 0x74, 0x58, 0x4d,
+    0x4c, 0x3a, 0x63, 0x6f, 0x6d, 0x2e, 0x61, 0x64, 0x6f, 0x62, 0x65, 0x2e, 0x78, 0x6d, 0x70, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3c, 0x3f, 0x78, 0x70, 0x61, 0x63, 0x6b, 0x65, 0x74, 0x20, 0x62, 0x65,
+    0x67, 0x69, 0x6e, 0x3d, 0x22, 0xef, 0xbb, 0xbf, 0x22, 0x20, 0x69, 0x64, 0x3d, 0x22, 0x57, 0x35,
+    0x4d, 0x30, 0x4d, 0x70, 0x43, 0x65, 0x68, 0x69, 0x48, 0x7a, 0x72, 0x65, 0x53, 0x7a, 0x4e, 0x54,
+    0x63, 0x7a, 0x6b, 0x63, 0x39, 0x64, 0x22, 0x3f, 0x3e, 0x0a, 0x3c, 0x78, 0x3a, 0x78, 0x6d, 0x70,
+    0x6d, 0x65, 0x74, 0x61, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x78, 0x3d, 0x22, 0x61, 0x64,
+    0x6f, 0x62, 0x65, 0x3a, 0x6e, 0x73, 0x3a, 0x6d, 0x65, 0x74, 0x61, 0x2f, 0x22, 0x20, 0x78, 0x3a,
+    0x78, 0x6d, 0x70, 0x74, 0x6b, 0x3d, 0x22, 0x41, 0x64, 0x6f, 0x62, 0x65, 0x20, 0x58, 0x4d, 0x50,
+    0x20, 0x43, 0x6f, 0x72, 0x65, 0x20, 0x35, 0x2e, 0x36, 0x2d, 0x63, 0x30, 0x36, 0x37, 0x20, 0x37,
+    0x39, 0x2e, 0x31, 0x35, 0x37, 0x37, 0x34, 0x37, 0x2c, 0x20, 0x32, 0x30, 0x31, 0x35, 0x2f, 0x30,
+    0x33, 0x2f, 0x33, 0x30, 0x2d, 0x32, 0x33, 0x3a, 0x34, 0x30, 0x3a, 0x34, 0x32, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x3c, 0x72, 0x64, 0x66, 0x3a,
+    0x52, 0x44, 0x46, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x72, 0x64, 0x66, 0x3d, 0x22, 0x68,
+    0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67,
+    0x2f, 0x31, 0x39, 0x39, 0x39, 0x2f, 0x30, 0x32, 0x2f, 0x32, 0x32, 0x2d, 0x72, 0x64, 0x66, 0x2d,
+    0x73, 0x79, 0x6e, 0x74, 0x61, 0x78, 0x2d, 0x6e, 0x73, 0x23, 0x22, 0x3e, 0x0a, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x3c, 0x72, 0x64, 0x66, 0x3a, 0x44, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74,
+    0x69, 0x6f, 0x6e, 0x20, 0x72, 0x64, 0x66, 0x3a, 0x61, 0x62, 0x6f, 0x75, 0x74, 0x3d, 0x22, 0x22,
+    0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c,
+    0x6e, 0x73, 0x3a, 0x78, 0x6d, 0x70, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x6e,
+    0x73, 0x2e, 0x61, 0x64, 0x6f, 0x62, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x78, 0x61, 0x70, 0x2f,
+    0x31, 0x2e, 0x30, 0x2f, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x64, 0x63, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70,
+    0x3a, 0x2f, 0x2f, 0x70, 0x75, 0x72, 0x6c, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x64, 0x63, 0x2f, 0x65,
+    0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x73, 0x2f, 0x31, 0x2e, 0x31, 0x2f, 0x22, 0x0a, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a,
+    0x70, 0x68, 0x6f, 0x74, 0x6f, 0x73, 0x68, 0x6f, 0x70, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a,
+    0x2f, 0x2f, 0x6e, 0x73, 0x2e, 0x61, 0x64, 0x6f, 0x62, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x70,
+    0x68, 0x6f, 0x74, 0x6f, 0x73, 0x68, 0x6f, 0x70, 0x2f, 0x31, 0x2e, 0x30, 0x2f, 0x22, 0x0a, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73,
+    0x3a, 0x78, 0x6d, 0x70, 0x4d, 0x4d, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x6e,
+    0x73, 0x2e, 0x61, 0x64, 0x6f, 0x62, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x78, 0x61, 0x70, 0x2f,
+    0x31, 0x2e, 0x30, 0x2f, 0x6d, 0x6d, 0x2f, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x73, 0x74, 0x45, 0x76, 0x74,
+    0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x6e, 0x73, 0x2e, 0x61, 0x64, 0x6f, 0x62,
+    0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x78, 0x61, 0x70, 0x2f, 0x31, 0x2e, 0x30, 0x2f, 0x73, 0x54,
+    0x79, 0x70, 0x65, 0x2f, 0x52, 0x65, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x45, 0x76, 0x65, 0x6e,
+    0x74, 0x23, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x74, 0x69, 0x66, 0x66, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70,
+    0x3a, 0x2f, 0x2f, 0x6e, 0x73, 0x2e, 0x61, 0x64, 0x6f, 0x62, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f,
+    0x74, 0x69, 0x66, 0x66, 0x2f, 0x31, 0x2e, 0x30, 0x2f, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x65, 0x78, 0x69,
+    0x66, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x6e, 0x73, 0x2e, 0x61, 0x64, 0x6f,
+    0x62, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x65, 0x78, 0x69, 0x66, 0x2f, 0x31, 0x2e, 0x30, 0x2f,
+    0x22, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x78, 0x6d, 0x70,
+    0x3a, 0x43, 0x72, 0x65, 0x61, 0x74, 0x6f, 0x72, 0x54, 0x6f, 0x6f, 0x6c, 0x3e, 0x41, 0x64, 0x6f,
+    0x62, 0x65, 0x20, 0x50, 0x68, 0x6f, 0x74, 0x6f, 0x73, 0x68, 0x6f, 0x70, 0x20, 0x43, 0x43, 0x20,
+    0x32, 0x30, 0x31, 0x35, 0x20, 0x28, 0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x73, 0x29, 0x3c, 0x2f,
+    0x78, 0x6d, 0x70, 0x3a, 0x43, 0x72, 0x65, 0x61, 0x74, 0x6f, 0x72, 0x54, 0x6f, 0x6f, 0x6c, 0x3e,
+    0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x78, 0x6d, 0x70, 0x3a, 0x43,
+    0x72, 0x65, 0x61, 0x74, 0x65, 0x44, 0x61, 0x74, 0x65, 0x3e, 0x32, 0x30, 0x32, 0x30, 0x2d, 0x30,
+    0x38, 0x2d, 0x30, 0x32, 0x54, 0x31, 0x30, 0x3a, 0x32, 0x38, 0x3a, 0x34, 0x37, 0x2b, 0x30, 0x33,
+    0x3a, 0x30, 0x30, 0x3c, 0x2f, 0x78, 0x6d, 0x70, 0x3a, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x44,
+    0x61, 0x74, 0x65, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x78,
+    0x6d, 0x70, 0x3a, 0x4d, 0x6f, 0x64, 0x69, 0x66, 0x79, 0x44, 0x61, 0x74, 0x65, 0x3e, 0x32, 0x30,
+    0x32, 0x30, 0x2d, 0x30, 0x38, 0x2d, 0x30, 0x32, 0x54, 0x31, 0x30, 0x3a, 0x33, 0x33, 0x3a, 0x31,
+    0x33, 0x2b, 0x30, 0x33, 0x3a, 0x30, 0x30, 0x3c, 0x2f, 0x78, 0x6d, 0x70, 0x3a, 0x4d, 0x6f, 0x64,
+    0x69, 0x66, 0x79, 0x44, 0x61, 0x74, 0x65, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x3c, 0x78, 0x6d, 0x70, 0x3a, 0x4d, 0x65, 0x74, 0x61, 0x64, 0x61, 0x74, 0x61, 0x44,
+    0x61, 0x74, 0x65, 0x3e, 0x32, 0x30, 0x32, 0x30, 0x2d, 0x30, 0x38, 0x2d, 0x30, 0x32, 0x54, 0x31,
+    0x30, 0x3a, 0x33, 0x33, 0x3a, 0x31, 0x33, 0x2b, 0x30, 0x33, 0x3a, 0x30, 0x30, 0x3c, 0x2f, 0x78,
+    0x6d, 0x70, 0x3a, 0x4d, 0x65, 0x74, 0x61, 0x64, 0x61, 0x74, 0x61, 0x44, 0x61, 0x74, 0x65, 0x3e,
     0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x64, 0x63, 0x3a, 0x66, 0x6f,
     0x72, 0x6d, 0x61, 0x74, 0x3e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x2f, 0x70, 0x6e, 0x67, 0x3c, 0x2f,
     0x64, 0x63, 0x3a, 0x66, 0x6f, 0x72, 0x6d, 0x61, 0x74, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
@@ -15423,2215 +16673,5681 @@ bool SDLUI_PointInRect(SDL_Rect rect, i32 x, i32 y)
     return false;
 }
 
-void SDLUI_Init(SDL_Renderer* r, SDL_Window* w)
+// 64 bit FNV-1a over size bytes, continuing from seed. Touches no state, so it is safe on any thread.
+SDLUI_ID SDLUI_HashID(const void* data, size_t size, SDLUI_ID seed)
 {
-#ifdef _WIN32
-    SetProcessDpiAwareness(PROCESS_PER_MONITOR_DPI_AWARE);
-#endif
-
-    IMG_Init(IMG_INIT_PNG);
-    TTF_Init();
+    SDLUI_ID hash = seed != 0 ? seed : 14695981039346656037ull;
+    const u8* bytes = (const u8*)data;
 
-    SDL_RWops* rw;
-    rw = SDL_RWFromMem((void*)sdlui_font_data, sizeof(sdlui_font_data));
-    SDLUI_Font.handle = TTF_OpenFontRW(rw, 1, SDLUI_Font.size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
 
-    SDLUI_Font.height = TTF_FontHeight(SDLUI_Font.handle);
-    TTF_SizeText(SDLUI_Font.handle, "0", &SDLUI_Font.width, &SDLUI_Font.height);
+    return hash != 0 ? hash : 1;
+}
 
-    SDLUI_Core.renderer = r;
-    SDLUI_Core.window = w;
-    SDL_GetWindowSize(SDLUI_Core.window, &SDLUI_Core.window_width, &SDLUI_Core.window_height);
+// ID for a name, seed lets the same name be reused under different parents.
+SDLUI_ID SDLUI_GetID(const char* name, SDLUI_ID seed = 0)
+{
+    return SDLUI_HashID(name, strlen(name), seed);
+}
 
-    SDLUI_Window_Collection.create();
+// Controls made by hand are numbered in the order they were added to their window, which keeps
+// their IDs the same from run to run.
+SDLUI_ID SDLUI_NextChildID(SDLUI_Control_Window* wnd)
+{
+    return SDLUI_HashID(&wnd->children.size, sizeof(wnd->children.size), wnd->id);
+}
 
-    SDLUI_Core.cursor_arrow = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW);
-    SDLUI_Core.cursor_ibeam = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_IBEAM);
-
-    SDLUI_Core.cursor_size_we = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_SIZEWE);
-    SDLUI_Core.cursor_size_ns = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_SIZENS);
-
-    SDLUI_Core.cursor_size_nwse = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_SIZENWSE);
-    SDLUI_Core.cursor_size_nesw = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_SIZENESW);
-
-    SDL_SetCursor(SDLUI_Core.cursor_arrow);
+SDLUI_Control* SDLUI_FindControl(SDLUI_ID id)
+{
+    return (SDLUI_Control*)SDLUI_ControlMap.find(id);
+}
 
-    for (int i = 0; i <= 95; ++i)
+// Gives a control the ID commands and state records know it by.
+void SDLUI_SetControlID(SDLUI_Control* ctrl, SDLUI_ID id)
+{
+    if (SDLUI_ControlMap.find(ctrl->id) == ctrl)
     {
-        SDLUI_Font.ascii[i] = 32 + i;
+        SDLUI_ControlMap.remove(ctrl->id);
     }
-    SDLUI_Font.ascii[95] = '\0';
-
-    SDL_Surface* characters = TTF_RenderText_Blended(SDLUI_Font.handle, SDLUI_Font.ascii, SDLUI_Core.theme.col_white);
-    SDLUI_Font.tex_font = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, characters);
-    SDL_FreeSurface(characters);
-
-    SDL_Surface* s;
-    // SDL_RWops *rw;
-
-    rw = SDL_RWFromMem((void*)sdlui_png_tick, sizeof(sdlui_png_tick));
-    s = IMG_LoadPNG_RW(rw);
-    SDLUI_Core.tex_tick = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
 
-    rw = SDL_RWFromMem((void*)sdlui_png_toggle, sizeof(sdlui_png_toggle));
-    s = IMG_LoadPNG_RW(rw);
-    SDLUI_Core.tex_toggle = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-
-    rw = SDL_RWFromMem((void*)sdlui_png_circlefillsmall, sizeof(sdlui_png_circlefillsmall));
-    s = IMG_LoadPNG_RW(rw);
-    SDLUI_Core.tex_circle_fill_2 = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-
-    rw = SDL_RWFromMem((void*)sdlui_png_circlefillbig, sizeof(sdlui_png_circlefillbig));
-    s = IMG_LoadPNG_RW(rw);
-    SDLUI_Core.tex_circle_fill_1 = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-
-    rw = SDL_RWFromMem((void*)sdlui_png_circle, sizeof(sdlui_png_circle));
-    s = IMG_LoadPNG_RW(rw);
-    SDLUI_Core.tex_circle = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-
-    rw = SDL_RWFromMem((void*)sdlui_png_close, sizeof(sdlui_png_close));
-    s = IMG_LoadPNG_RW(rw);
-    SDLUI_Core.tex_close = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-
-    SDL_FreeSurface(s);
-    SDL_RWclose(rw);
+    ctrl->id = id;
+    SDLUI_ControlMap.insert(id, ctrl);
 }
 
-void SDLUI_MouseStateReset()
+// The state record for id, zeroed the first time it is asked for. The pointer stays valid until SDLUI_FreeState.
+void* SDLUI_GetState(SDLUI_ID id, i32 size)
 {
-    for (int i = 0; i < 5; ++i)
+    void* state = SDLUI_StateMap.find(id);
+
+    if (state == NULL)
     {
-        SDLUI_Core.mouse_last_frame[i] = SDLUI_Core.mouse_current_frame[i];
+        state = calloc(1, size);
+        SDLUI_StateMap.insert(id, state);
     }
+
+    return state;
 }
 
-void SDLUI_MouseStateSet(i32 event_type, i32 mbutton)
+void SDLUI_FreeState(SDLUI_ID id)
 {
-    SDLUI_Core.mouse_current_frame[mbutton] = (event_type == SDL_MOUSEBUTTONDOWN || event_type == SDL_MOUSEMOTION);
+    free(SDLUI_StateMap.remove(id));
 }
 
-SDLUI_MOUSEBUTTON SDLUI_MouseButton(i32 mbutton)
+u32 SDLUI_DecodeUTF8(const char* text, i32* index)
 {
-    if (SDLUI_Core.mouse_current_frame[mbutton] && !SDLUI_Core.mouse_last_frame[mbutton])
+    const u8* c = (const u8*)text + *index;
+    u32 codepoint;
+    i32 length;
+
+    if (c[0] < 0x80)
     {
-        return SDLUI_MOUSEBUTTON_PRESSED;
+        codepoint = c[0];
+        length = 1;
     }
-    else if (SDLUI_Core.mouse_current_frame[mbutton] && SDLUI_Core.mouse_last_frame[mbutton])
+    else if ((c[0] & 0xE0) == 0xC0)
     {
-        return SDLUI_MOUSEBUTTON_HELD;
+        codepoint = c[0] & 0x1F;
+        length = 2;
     }
-    else if (!SDLUI_Core.mouse_current_frame[mbutton] && SDLUI_Core.mouse_last_frame[mbutton])
+    else if ((c[0] & 0xF0) == 0xE0)
     {
-        return SDLUI_MOUSEBUTTON_RELEASED;
+        codepoint = c[0] & 0x0F;
+        length = 3;
+    }
+    else if ((c[0] & 0xF8) == 0xF0)
+    {
+        codepoint = c[0] & 0x07;
+        length = 4;
+    }
+    else
+    {
+        *index += 1;
+        return 0xFFFD;
     }
 
-    return SDLUI_MOUSEBUTTON_NONE;
-}
+    for (int i = 1; i < length; ++i)
+    {
+        if ((c[i] & 0xC0) != 0x80)
+        {
+            *index += i;
+            return 0xFFFD;
+        }
 
-void SDLUI_SetColor(SDL_Color c)
-{
-    SDL_SetRenderDrawColor(SDLUI_Core.renderer, c.r, c.g, c.b, c.a);
+        codepoint = (codepoint << 6) | (c[i] & 0x3F);
+    }
+
+    *index += length;
+    return codepoint;
 }
 
-void SDLUI_GradientToTexture(SDL_Texture* t, SDL_Color c, i32 width, i32 height, i32 interv)
+void SDLUI_FlushText();
+
+// Drops every cached glyph and starts filling the pages from the top again. Called when the pages are full.
+void SDLUI_ResetGlyphCache()
 {
-    SDL_SetRenderTarget(SDLUI_Core.renderer, t);
+    SDLUI_FlushText();
 
-    i32 x = 0, y = 0;
-    SDLUI_SetColor(c);
+    memset(SDLUI_GlyphCache.glyphs, 0, SDLUI_GlyphCache.capacity * sizeof(SDLUI_Glyph));
+    SDLUI_GlyphCache.count = 0;
 
-    for (int i = 0; i < height; ++i)
+    for (int i = 0; i < SDLUI_GlyphCache.num_pages; ++i)
     {
-        SDL_RenderDrawLine(SDLUI_Core.renderer, x, y + i, width, y + i);
+        SDLUI_GlyphCache.pages[i].shelf_x = 0;
+        SDLUI_GlyphCache.pages[i].shelf_y = 0;
+        SDLUI_GlyphCache.pages[i].shelf_h = 0;
+    }
+
+    SDLUI_GlyphCache.generation++;
+}
 
-        if (i % interv == 0)
+// Finds room for a w*h glyph on one of the atlas pages, adding a page or resetting the cache when they are all full.
+bool SDLUI_PackGlyph(i32 w, i32 h, i32* page, SDL_Rect* rect)
+{
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        for (int i = 0; i < SDLUI_GLYPH_MAX_PAGES; ++i)
         {
-            c.r -= interv;
-            c.g -= interv;
-            c.b -= interv;
+            if (i == SDLUI_GlyphCache.num_pages)
+            {
+                SDLUI_GlyphPage* p = &SDLUI_GlyphCache.pages[i];
+                p->tex = SDL_CreateTexture(SDLUI_Core.renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, SDLUI_GLYPH_PAGE_SIZE, SDLUI_GLYPH_PAGE_SIZE);
+                SDL_SetTextureBlendMode(p->tex, SDL_BLENDMODE_BLEND);
+                p->shelf_x = 0;
+                p->shelf_y = 0;
+                p->shelf_h = 0;
+                SDLUI_GlyphCache.num_pages++;
+            }
+
+            SDLUI_GlyphPage* p = &SDLUI_GlyphCache.pages[i];
+
+            if (p->shelf_x + w > SDLUI_GLYPH_PAGE_SIZE)
+            {
+                p->shelf_x = 0;
+                p->shelf_y += p->shelf_h + 1;
+                p->shelf_h = 0;
+            }
+
+            if (p->shelf_y + h <= SDLUI_GLYPH_PAGE_SIZE && w <= SDLUI_GLYPH_PAGE_SIZE)
+            {
+                *page = i;
+                *rect = { p->shelf_x, p->shelf_y, w, h };
+                p->shelf_x += w + 1;
+                p->shelf_h = p->shelf_h > h ? p->shelf_h : h;
+                return true;
+            }
         }
+
+        SDLUI_ResetGlyphCache();
     }
 
-    SDL_SetRenderTarget(SDLUI_Core.renderer, NULL);
+    return false;
 }
 
-float SDLUI_Max(float a, float b)
+// Opens the embedded TTF the first time something needs it.
+TTF_Font* SDLUI_UseFont()
 {
-    if (a > b)
+    if (SDLUI_Font.handle == NULL)
     {
-        return a;
+        TTF_Init();
+        SDL_RWops* rw = SDL_RWFromConstMem(sdlui_font_data, sizeof(sdlui_font_data));
+        SDLUI_Font.handle = TTF_OpenFontRW(rw, 1, SDLUI_Font.size);
     }
 
-    return b;
+    return SDLUI_Font.handle;
 }
 
-void SDLUI_Colorize(SDL_Texture* t, SDL_Color c)
+bool SDLUI_IsBaked(u32 codepoint)
 {
-    SDL_SetTextureColorMod(t, c.r, c.g, c.b);
+#ifdef SDLUI_BAKED_FONT
+    return SDLUI_Font.baked && codepoint >= SDLUI_BAKED_FIRST && codepoint < SDLUI_BAKED_FIRST + SDLUI_BAKED_COUNT;
+#else
+    return false;
+#endif
 }
 
-void SDLUI_SetActiveWindow(SDLUI_Control_Window* wnd)
+// How far the pen moves between previous and codepoint on top of the advance of previous.
+i32 SDLUI_Kerning(u32 previous, u32 codepoint)
 {
-    SDLUI_Window_Collection.to_back(wnd);
-    SDLUI_Core.active_window = wnd;
+#ifdef SDLUI_BAKED_FONT
+    if (SDLUI_IsBaked(previous) && SDLUI_IsBaked(codepoint))
+    {
+        return sdlui_baked_kerning[(previous - SDLUI_BAKED_FIRST) * SDLUI_BAKED_COUNT + codepoint - SDLUI_BAKED_FIRST];
+    }
+#endif
+
+    TTF_Font* font = SDLUI_UseFont();
+    return TTF_GetFontKerning(font) != 0 ? TTF_GetFontKerningSizeGlyphs32(font, previous, codepoint) : 0;
 }
 
-SDLUI_RESIZE_DIRECTION SDLUI_SetWindowResizeCursor(SDLUI_Control_Window* wnd, i32 mousex, i32 mousey)
+#ifdef SDLUI_BAKED_FONT
+// Fills in glyph from the baked atlas, expanding its coverage to white pixels the way TTF_RenderGlyph32_Blended makes them.
+void SDLUI_LoadBakedGlyph(u32 codepoint, SDLUI_Glyph* glyph)
 {
-    SDL_Rect left, top, right, bottom, lt, rt, lb, rb;
-    left = { wnd->x - 8, wnd->y, 8, wnd->h };
-    top = { wnd->x, wnd->y - 8, wnd->w, 8 };
-    right = { wnd->x + wnd->w, wnd->y, 8, wnd->h };
-    bottom = { wnd->x, wnd->y + wnd->h, wnd->w, 8 };
+    const SDLUI_BakedGlyph* b = &sdlui_baked_glyphs[codepoint - SDLUI_BAKED_FIRST];
 
-    lt = { wnd->x - 8, wnd->y - 8, 8, 8 };
-    rt = { wnd->x + wnd->w, wnd->y - 8, 8, 8 };
-    lb = { wnd->x - 8, wnd->y + wnd->h, 8, 8 };
-    rb = { wnd->x + wnd->w, wnd->y + wnd->h, 8, 8 };
+    glyph->advance = b->advance;
+    glyph->offset_x = b->offset_x;
 
-    if (SDLUI_PointInRect(left, mousex, mousey))
-    {
-        SDL_SetCursor(SDLUI_Core.cursor_size_we);
-        return SDLUI_RESIZE_LEFT;
-    }
-    else if (SDLUI_PointInRect(top, mousex, mousey))
-    {
-        SDL_SetCursor(SDLUI_Core.cursor_size_ns);
-        return SDLUI_RESIZE_TOP;
-    }
-    else if (SDLUI_PointInRect(right, mousex, mousey))
+    if (b->w > 0 && SDLUI_PackGlyph(b->w, b->h, &glyph->page, &glyph->src))
     {
-        SDL_SetCursor(SDLUI_Core.cursor_size_we);
-        return SDLUI_RESIZE_RIGHT;
+        u32* pixels = (u32*)malloc(b->w * b->h * sizeof(u32));
+        const u8* coverage = sdlui_baked_coverage + b->offset;
+
+        for (int i = 0; i < b->w * b->h; ++i)
+        {
+            pixels[i] = ((u32)coverage[i] << 24) | 0x00FFFFFF;
+        }
+
+        SDL_UpdateTexture(SDLUI_GlyphCache.pages[glyph->page].tex, &glyph->src, pixels, b->w * sizeof(u32));
+        free(pixels);
     }
-    else if (SDLUI_PointInRect(bottom, mousex, mousey))
+}
+#endif
+
+SDLUI_Glyph SDLUI_GetGlyph(u32 codepoint)
+{
+    if (SDLUI_GlyphCache.count * 4 >= SDLUI_GlyphCache.capacity * 3)
     {
-        SDL_SetCursor(SDLUI_Core.cursor_size_ns);
-        return SDLUI_RESIZE_BOTTOM;
+        SDLUI_GlyphCache.grow();
     }
-    else if (SDLUI_PointInRect(lt, mousex, mousey))
+
+    SDLUI_Glyph* g = SDLUI_GlyphCache.find_slot(codepoint);
+
+    if (g->codepoint == codepoint)
     {
-        SDL_SetCursor(SDLUI_Core.cursor_size_nwse);
-        return SDLUI_RESIZE_LEFT_TOP;
+        return *g;
     }
-    else if (SDLUI_PointInRect(rt, mousex, mousey))
+
+    SDLUI_Glyph glyph;
+    glyph.codepoint = codepoint;
+    glyph.page = -1;
+    glyph.src = { 0, 0, 0, 0 };
+
+#ifdef SDLUI_BAKED_FONT
+    if (SDLUI_IsBaked(codepoint))
     {
-        SDL_SetCursor(SDLUI_Core.cursor_size_nesw);
-        return SDLUI_RESIZE_RIGHT_TOP;
+        SDLUI_LoadBakedGlyph(codepoint, &glyph);
     }
-    else if (SDLUI_PointInRect(lb, mousex, mousey))
+    else
+#endif
     {
-        SDL_SetCursor(SDLUI_Core.cursor_size_nesw);
-        return SDLUI_RESIZE_LEFT_BOTTOM;
+        TTF_Font* font = SDLUI_UseFont();
+        i32 minx, maxx, miny, maxy;
+
+        if (!TTF_GlyphIsProvided32(font, codepoint) || TTF_GlyphMetrics32(font, codepoint, &minx, &maxx, &miny, &maxy, &glyph.advance) != 0)
+        {
+            glyph.advance = SDLUI_Font.width;
+            minx = 0;
+        }
+
+        // the rendered surface starts at the leftmost pixel of the glyph when it hangs left of the pen position.
+        glyph.offset_x = minx < 0 ? minx : 0;
+
+        SDL_Surface* s = TTF_RenderGlyph32_Blended(font, codepoint, SDLUI_Core.theme.col_white);
+
+        if (s != NULL)
+        {
+            if (s->w > 0 && SDLUI_PackGlyph(s->w, s->h, &glyph.page, &glyph.src))
+            {
+                SDL_UpdateTexture(SDLUI_GlyphCache.pages[glyph.page].tex, &glyph.src, s->pixels, s->pitch);
+            }
+
+            SDL_FreeSurface(s);
+        }
     }
-    else if (SDLUI_PointInRect(rb, mousex, mousey))
+
+    // packing may have reset the cache, so the slot is looked up again.
+    *SDLUI_GlyphCache.find_slot(codepoint) = glyph;
+    SDLUI_GlyphCache.count++;
+
+    return glyph;
+}
+
+// Returns the width in pixels of length bytes of text starting at start, including kerning.
+i32 SDLUI_MeasureTextRange(const char* text, i32 start, i32 length)
+{
+    i32 width = 0;
+    u32 previous = 0;
+    i32 i = start;
+
+    while (i < start + length && text[i] != '\0')
     {
-        SDL_SetCursor(SDLUI_Core.cursor_size_nwse);
-        return SDLUI_RESIZE_RIGHT_BOTTOM;
+        u32 codepoint = SDLUI_DecodeUTF8(text, &i);
+
+        if (previous != 0)
+        {
+            width += SDLUI_Kerning(previous, codepoint);
+        }
+
+        width += SDLUI_GetGlyph(codepoint).advance;
+        previous = codepoint;
     }
 
-    SDL_SetCursor(SDLUI_Core.cursor_arrow);
+    return width;
+}
 
-    return SDLUI_RESIZE_NONE;
+i32 SDLUI_MeasureText(const char* text)
+{
+    return SDLUI_MeasureTextRange(text, 0, strlen(text));
 }
 
-void SDLUI_ResizeWindow(SDLUI_Control_Window* aw, SDLUI_RESIZE_DIRECTION res_dir, i32 mx, i32 my)
+// Steps past the codepoint at index and returns how far it moves the pen, with kerning against previous,
+// which is updated for the next call.
+i32 SDLUI_GlyphAdvance(const char* text, i32* index, u32* previous)
 {
-    if (res_dir == SDLUI_RESIZE_RIGHT)
+    u32 codepoint = SDLUI_DecodeUTF8(text, index);
+    i32 advance = SDLUI_GetGlyph(codepoint).advance;
+
+    if (*previous != 0)
     {
-        aw->w = mx - aw->x;
+        advance += SDLUI_Kerning(*previous, codepoint);
     }
-    else if (res_dir == SDLUI_RESIZE_LEFT)
+    *previous = codepoint;
+
+    return advance;
+}
+
+// Byte offset into length bytes of text whose position is closest to x pixels from the start.
+i32 SDLUI_TextOffsetAtX(const char* text, i32 length, i32 x)
+{
+    u32 previous = 0;
+    i32 pen = 0;
+    i32 i = 0;
+
+    while (i < length)
     {
-        i32 old_x = aw->x;
-        aw->w += aw->x - mx;
-        if (aw->w > SDLUI_WINDOW_MIN_SIZE)
-        {
-            aw->x = mx;
-        }
+        i32 next = i;
+        i32 advance = SDLUI_GlyphAdvance(text, &next, &previous);
 
-        for (int i = 0; i < aw->children.size; ++i)
+        if (pen + advance / 2 > x)
         {
-            aw->children.data[i]->x += aw->x - old_x;
+            break;
         }
+
+        pen += advance;
+        i = next;
     }
-    else if (res_dir == SDLUI_RESIZE_BOTTOM)
+
+    return i;
+}
+
+// The bytes of a line of the editor without its newline. The pointer is good until the next call,
+// lines the gap splits are copied to the editor's scratch buffer.
+const char* SDLUI_TextEditorLine(SDLUI_Control_TextEditor* ed, i32 line, i32* length)
+{
+    SDLUI_GapBuffer* b = &ed->buffer;
+    i32 start = ed->lines.starts[line];
+    i32 end = line + 1 < ed->lines.count ? ed->lines.starts[line + 1] - 1 : b->length();
+
+    *length = end - start;
+
+    if (end <= b->gap_start)
     {
-        aw->h = my - aw->y;
+        return b->data + start;
     }
-    else if (res_dir == SDLUI_RESIZE_TOP)
+
+    if (start >= b->gap_start)
     {
-        i32 old_y = aw->y;
-        aw->h += aw->y - my;
-        if (aw->h > SDLUI_WINDOW_MIN_SIZE)
-        {
-            aw->y = my;
-        }
+        return b->data + start + b->gap_end - b->gap_start;
+    }
 
-        for (int i = 0; i < aw->children.size; ++i)
-        {
-            aw->children.data[i]->y += aw->y - old_y;
-        }
+    if (*length + 4 > ed->scratch_capacity)
+    {
+        ed->scratch_capacity = *length + 4 > ed->scratch_capacity * 2 ? *length + 4 : ed->scratch_capacity * 2;
+        ed->scratch = (char*)realloc(ed->scratch, ed->scratch_capacity);
     }
-    else if (res_dir == SDLUI_RESIZE_LEFT_TOP)
+
+    b->copy(start, *length, ed->scratch);
+    memset(ed->scratch + *length, 0, 4);
+
+    return ed->scratch;
+}
+
+// Decodes the embedded icons and copies them side by side into one texture. Each surface is freed as soon as it is copied.
+void SDLUI_BuildIconAtlas()
+{
+    struct { const uint8_t* data; i32 size; } pngs[SDLUI_ICON_COUNT] =
     {
-        i32 old_x = aw->x;
-        i32 old_y = aw->y;
-        aw->w += aw->x - mx;
-        if (aw->w > SDLUI_WINDOW_MIN_SIZE)
-        {
-            aw->x = mx;
-        }
-        aw->h += aw->y - my;
-        if (aw->h > SDLUI_WINDOW_MIN_SIZE)
-        {
-            aw->y = my;
-        }
+        { sdlui_png_tick, sizeof(sdlui_png_tick) },
+        { sdlui_png_toggle, sizeof(sdlui_png_toggle) },
+        { sdlui_png_circlefillsmall, sizeof(sdlui_png_circlefillsmall) },
+        { sdlui_png_circlefillbig, sizeof(sdlui_png_circlefillbig) },
+        { sdlui_png_circle, sizeof(sdlui_png_circle) },
+        { sdlui_png_close, sizeof(sdlui_png_close) }
+    };
 
-        for (int i = 0; i < aw->children.size; ++i)
-        {
-            aw->children.data[i]->x += aw->x - old_x;
-            aw->children.data[i]->y += aw->y - old_y;
-        }
-    }
-    else if (res_dir == SDLUI_RESIZE_RIGHT_TOP)
+    IMG_Init(IMG_INIT_PNG);
+
+    SDL_Surface* surfaces[SDLUI_ICON_COUNT];
+    i32 atlas_w = 1;
+    i32 atlas_h = 1;
+
+    for (int i = 0; i < SDLUI_ICON_COUNT; ++i)
     {
-        i32 old_y = aw->y;
-        aw->h += aw->y - my;
-        if (aw->h > SDLUI_WINDOW_MIN_SIZE)
-        {
-            aw->y = my;
-        }
-        aw->w = mx - aw->x;
+        SDL_RWops* rw = SDL_RWFromConstMem(pngs[i].data, pngs[i].size);
+        surfaces[i] = IMG_LoadPNG_RW(rw);
+        SDL_RWclose(rw);
 
-        for (int i = 0; i < aw->children.size; ++i)
+        SDLUI_ThemeCache.icons[i] = { atlas_w, 0, 0, 0 };
+
+        if (surfaces[i] != NULL)
         {
-            aw->children.data[i]->y += aw->y - old_y;
+            SDLUI_ThemeCache.icons[i].w = surfaces[i]->w;
+            SDLUI_ThemeCache.icons[i].h = surfaces[i]->h;
+
+            // a transparent pixel between icons keeps scaled copies from picking up their neighbours.
+            atlas_w += surfaces[i]->w + 1;
+            atlas_h = surfaces[i]->h > atlas_h ? surfaces[i]->h : atlas_h;
         }
     }
-    else if (res_dir == SDLUI_RESIZE_LEFT_BOTTOM)
-    {
-        i32 old_x = aw->x;
-        aw->w += aw->x - mx;
-        if (aw->w > SDLUI_WINDOW_MIN_SIZE)
-        {
-            aw->x = mx;
-        }
-        aw->h = my - aw->y;
 
-        for (int i = 0; i < aw->children.size; ++i)
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, atlas_w, atlas_h, 32, SDL_PIXELFORMAT_RGBA32);
+
+    for (int i = 0; i < SDLUI_ICON_COUNT; ++i)
+    {
+        if (surfaces[i] != NULL)
         {
-            aw->children.data[i]->x += aw->x - old_x;
+            SDL_Rect dst = SDLUI_ThemeCache.icons[i];
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(surfaces[i], NULL, atlas, &dst);
+            SDL_FreeSurface(surfaces[i]);
         }
     }
-    else if (res_dir == SDLUI_RESIZE_RIGHT_BOTTOM)
+
+    SDLUI_ThemeCache.atlas = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, atlas);
+    SDL_SetTextureBlendMode(SDLUI_ThemeCache.atlas, SDL_BLENDMODE_BLEND);
+    SDL_FreeSurface(atlas);
+}
+
+// Draws an icon from the atlas tinted with c. The tint is set on every draw since all of the icons share one texture.
+void SDLUI_DrawIcon(SDLUI_ICON icon, const SDL_Rect* dst, SDL_Color c)
+{
+    if (SDLUI_ThemeCache.atlas == NULL)
     {
-        aw->w = mx - aw->x;
-        aw->h = my - aw->y;
+        SDLUI_BuildIconAtlas();
     }
 
-    aw->w = SDLUI_Clamp(aw->w, 120, 10000);
-    aw->h = SDLUI_Clamp(aw->h, 120, 10000);
+    SDL_SetTextureColorMod(SDLUI_ThemeCache.atlas, c.r, c.g, c.b);
+    SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_ThemeCache.atlas, &SDLUI_ThemeCache.icons[icon], dst);
 }
 
-void SDLUI_WindowHandler()
+void SDLUI_Init(SDL_Renderer* r, SDL_Window* w)
 {
-    i32 mx, my, index = 0;
-    SDL_GetMouseState(&mx, &my);
-    SDLUI_Control_Window* aw = SDLUI_Core.active_window;
-    static SDLUI_RESIZE_DIRECTION res_dir = SDLUI_RESIZE_NONE;
+#ifdef _WIN32
+    SetProcessDpiAwareness(PROCESS_PER_MONITOR_DPI_AWARE);
+#endif
 
-    if (aw != NULL)
+    // nothing is rasterized here. Glyphs are made the first time they are measured or drawn, and with a baked
+    // font that is a copy out of the baked atlas without ever opening the TTF. Without one the TTF is opened
+    // right away, the layout needs the line height before anything is drawn.
+#ifdef SDLUI_BAKED_FONT
+    SDLUI_Font.baked = SDLUI_Font.size == SDLUI_BAKED_FONT_SIZE;
+    SDLUI_Font.width = sdlui_baked_font_width;
+    SDLUI_Font.height = sdlui_baked_font_height;
+#else
+    SDLUI_Font.baked = false;
+#endif
+
+    if (!SDLUI_Font.baked)
     {
-        if (!aw->is_resized && aw->can_be_resized)
-        {
-            res_dir = SDLUI_SetWindowResizeCursor(aw, mx, my);
+        TTF_SizeText(SDLUI_UseFont(), "0", &SDLUI_Font.width, &SDLUI_Font.height);
+    }
 
-            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD)
-            {
-                aw->is_resized = true;
-            }
-        }
+    SDLUI_Core.renderer = r;
+    SDLUI_Core.window = w;
+    SDL_GetWindowSize(SDLUI_Core.window, &SDLUI_Core.window_width, &SDLUI_Core.window_height);
 
-        if (aw->is_resized && !aw->is_dragged)
-        {
-            SDLUI_ResizeWindow(aw, res_dir, mx, my);
-            SDL_DestroyTexture(aw->tex_rect);
-            aw->tex_rect = SDL_CreateTexture(SDLUI_Core.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, aw->w, aw->h);
-        }
-        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_RELEASED && aw->is_resized)
-        {
-            aw->is_resized = false;
-            SDL_SetCursor(SDLUI_Core.cursor_arrow);
-        }
-    }
+    SDLUI_Window_Collection.create();
+    SDLUI_CommandQueue.mutex = SDL_CreateMutex();
 
-    if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED && SDL_GetCursor() == SDLUI_Core.cursor_arrow)
-    {
-        SDLUI_Control_Window* wnd;
-        SDL_Rect r;
-        bool hovers_window = false;
+    SDLUI_Core.cursor_arrow = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW);
+    SDLUI_Core.cursor_ibeam = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_IBEAM);
 
-        for (int i = 0; i < SDLUI_Window_Collection.size; ++i)
-        {
-            wnd = (SDLUI_Control_Window*)SDLUI_Window_Collection.data[i];
+    SDLUI_Core.cursor_size_we = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_SIZEWE);
+    SDLUI_Core.cursor_size_ns = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_SIZENS);
 
-            if (wnd->visible)
-            {
-                r = { wnd->x, wnd->y, wnd->w, wnd->h };
+    SDLUI_Core.cursor_size_nwse = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_SIZENWSE);
+    SDLUI_Core.cursor_size_nesw = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_SIZENESW);
 
-                if (SDLUI_PointInRect(r, mx, my))
-                {
-                    index = i;
-                    hovers_window = true;
-                }
-            }
-        }
+    SDL_SetCursor(SDLUI_Core.cursor_arrow);
 
-        if (SDLUI_Window_Collection.data[index] != SDLUI_Core.active_window && hovers_window)
-        {
-            SDLUI_SetActiveWindow((SDLUI_Control_Window*)SDLUI_Window_Collection.data[index]);
-        }
-        else if (!hovers_window)
-        {
-            SDLUI_Core.active_window = NULL;
-        }
+    SDL_GetMouseState(&SDLUI_Input.mouse_x, &SDLUI_Input.mouse_y);
+
+    // calling init again for the same renderer keeps the theme textures, a new renderer can't use the old ones.
+    // the icon atlas is built the first time an icon is drawn.
+    if (SDLUI_ThemeCache.renderer != r)
+    {
+        SDLUI_ThemeCache.renderer = r;
+        SDLUI_ThemeCache.atlas = NULL;
+        SDLUI_ThemeCache.num_gradients = 0;
     }
 }
 
-// Got this from StackOverflow.
-void save_texture(SDL_Renderer* ren, SDL_Texture* tex, const char* filename)
+// Called once the frame has been rendered so the next one starts from a clean snapshot.
+void SDLUI_InputReset()
 {
-    SDL_Texture* ren_tex;
-    SDL_Surface* surf;
-    int st;
-    int w;
-    int h;
-    int format;
-    void* pixels;
-
-    pixels = NULL;
-    surf = NULL;
-    ren_tex = NULL;
-    format = SDL_PIXELFORMAT_RGBA32;
-
-    /* Get information about texture we want to save */
-    st = SDL_QueryTexture(tex, NULL, NULL, &w, &h);
-    if (st != 0) {
-        SDL_Log("Failed querying texture: %s\n", SDL_GetError());
-        goto cleanup;
-    }
-
-    ren_tex = SDL_CreateTexture(ren, format, SDL_TEXTUREACCESS_TARGET, w, h);
-    if (!ren_tex) {
-        SDL_Log("Failed creating render texture: %s\n", SDL_GetError());
-        goto cleanup;
-    }
+    for (int i = 0; i < 6; ++i)
+    {
+        // a click that was pressed and released within one frame was reported as a press, so the release is
+        // reported on the next frame for whatever started on that press.
+        bool clicked = SDLUI_Input.mouse_pressed[i] && SDLUI_Input.mouse_released[i] && !SDLUI_Input.mouse_down[i];
 
-    /*
-     * Initialize our canvas, then copy texture to a target whose pixel data we
-     * can access
-     */
-    st = SDL_SetRenderTarget(ren, ren_tex);
-    if (st != 0) {
-        SDL_Log("Failed setting render target: %s\n", SDL_GetError());
-        goto cleanup;
+        SDLUI_Input.mouse_down_last_frame[i] = SDLUI_Input.mouse_down[i];
+        SDLUI_Input.mouse_pressed[i] = 0;
+        SDLUI_Input.mouse_released[i] = clicked;
     }
 
-    SDL_SetRenderDrawColor(ren, 0x00, 0x00, 0x00, 0x00);
-    SDL_RenderClear(ren);
-
-    st = SDL_RenderCopy(ren, tex, NULL, NULL);
-    if (st != 0) {
-        SDL_Log("Failed copying texture data: %s\n", SDL_GetError());
-        goto cleanup;
-    }
+    SDLUI_Input.wheel_x = 0;
+    SDLUI_Input.wheel_y = 0;
+    SDLUI_Input.num_events = 0;
 
-    /* Create buffer to hold texture data and load it */
-    pixels = malloc(w * h * SDL_BYTESPERPIXEL(format));
-    if (!pixels) {
-        SDL_Log("Failed allocating memory\n");
-        goto cleanup;
-    }
+    SDLUI_Core.hot_control = NULL;
+}
 
-    st = SDL_RenderReadPixels(ren, NULL, format, pixels, w * SDL_BYTESPERPIXEL(format));
-    if (st != 0) {
-        SDL_Log("Failed reading pixel data: %s\n", SDL_GetError());
-        goto cleanup;
+SDLUI_MOUSEBUTTON SDLUI_MouseButton(i32 mbutton)
+{
+    // a press and release within one frame counts as a press, the release follows on the next frame.
+    if (SDLUI_Input.mouse_pressed[mbutton])
+    {
+        return SDLUI_MOUSEBUTTON_PRESSED;
     }
-
-    /* Copy pixel data over to surface */
-    surf = SDL_CreateRGBSurfaceWithFormatFrom(pixels, w, h, SDL_BITSPERPIXEL(format), w * SDL_BYTESPERPIXEL(format), format);
-    if (!surf) {
-        SDL_Log("Failed creating new surface: %s\n", SDL_GetError());
-        goto cleanup;
+    else if (SDLUI_Input.mouse_down[mbutton] && SDLUI_Input.mouse_down_last_frame[mbutton])
+    {
+        return SDLUI_MOUSEBUTTON_HELD;
     }
-
-    /* Save result to an image */
-    st = SDL_SaveBMP(surf, filename);
-    if (st != 0) {
-        SDL_Log("Failed saving image: %s\n", SDL_GetError());
-        goto cleanup;
+    else if (SDLUI_Input.mouse_released[mbutton])
+    {
+        return SDLUI_MOUSEBUTTON_RELEASED;
     }
 
-    SDL_Log("Saved texture as BMP to \"%s\"\n", filename);
-
-cleanup:
-    SDL_FreeSurface(surf);
-    free(pixels);
-    SDL_DestroyTexture(ren_tex);
+    return SDLUI_MOUSEBUTTON_NONE;
 }
 
-void SDLUI_DrawText(i32 x, i32 y, const char* text, SDL_Texture* dst)
+void SDLUI_SetColor(SDL_Color c)
 {
-    SDL_SetRenderTarget(SDLUI_Core.renderer, dst);
-    i32 cur_char;
-    SDL_Rect glyph_rect;
-    SDL_Rect pos = { x, y, SDLUI_Font.width, SDLUI_Font.height };
-
-    i32 count = strlen(text);
-
-    for (int i = 0; i < count; ++i)
-    {
-        cur_char = (i32)text[i];
-        glyph_rect = { (cur_char - 32) * SDLUI_Font.width, 0, SDLUI_Font.width, SDLUI_Font.height };
-
-        SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Font.tex_font, &glyph_rect, &pos);
-        pos.x += SDLUI_Font.width;
-    }
-
-    SDL_SetRenderTarget(SDLUI_Core.renderer, NULL);
+    SDL_SetRenderDrawColor(SDLUI_Core.renderer, c.r, c.g, c.b, c.a);
 }
 
-void SDLUI_DrawTextRange(i32 x, i32 y, const char* text, i32 start, i32 length, SDL_Texture* dst)
+// Fills t with c at the top getting darker by interv every interv rows, as one quad whose colors are blended down the rows.
+void SDLUI_GradientToTexture(SDL_Texture* t, SDL_Color c, i32 width, i32 height, i32 interv)
 {
-    SDL_SetRenderTarget(SDLUI_Core.renderer, dst);
-    i32 cur_char;
-    SDL_Rect glyph_rect;
-    SDL_Rect pos = { x, y, SDLUI_Font.width, SDLUI_Font.height };
+    SDL_Texture* old_target = SDL_GetRenderTarget(SDLUI_Core.renderer);
+    SDL_SetRenderTarget(SDLUI_Core.renderer, t);
+
+    i32 darken = interv > 0 && height > 1 ? ((height - 2) / interv + 1) * interv : 0;
+    SDL_Color bottom = c;
+    bottom.r = c.r > darken ? c.r - darken : 0;
+    bottom.g = c.g > darken ? c.g - darken : 0;
+    bottom.b = c.b > darken ? c.b - darken : 0;
 
-    for (int i = start; i < start + length; ++i)
+    float w = (float)width;
+    float h = (float)height;
+    SDL_Vertex v[4] =
     {
-        cur_char = (i32)text[i];
-        glyph_rect = { (cur_char - 32) * SDLUI_Font.width, 0, SDLUI_Font.width, SDLUI_Font.height };
+        { { 0, 0 }, c, { 0, 0 } },
+        { { w, 0 }, c, { 0, 0 } },
+        { { w, h }, bottom, { 0, 0 } },
+        { { 0, h }, bottom, { 0, 0 } }
+    };
+    i32 indices[6] = { 0, 1, 2, 0, 2, 3 };
 
-        SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Font.tex_font, &glyph_rect, &pos);
-        pos.x += SDLUI_Font.width;
-    }
+    SDL_RenderGeometry(SDLUI_Core.renderer, NULL, v, 4, indices, 6);
 
-    SDL_SetRenderTarget(SDLUI_Core.renderer, NULL);
+    SDL_SetRenderTarget(SDLUI_Core.renderer, old_target);
 }
 
-void SDLUI_Render_Button(SDLUI_Control_Button* btn)
+// A width*height gradient from the theme cache, drawn the first time it is asked for and shared after that.
+SDL_Texture* SDLUI_GetGradient(SDL_Color c, i32 width, i32 height, i32 interv)
 {
-    if (btn->visible)
+    for (int i = 0; i < SDLUI_ThemeCache.num_gradients; ++i)
     {
-        if (btn->text.modified)
+        SDLUI_Gradient* g = &SDLUI_ThemeCache.gradients[i];
+
+        if (g->w == width && g->h == height && g->interv == interv &&
+            g->color.r == c.r && g->color.g == c.g && g->color.b == c.b && g->color.a == c.a)
         {
-            SDL_Color c = { 255, 255, 255, 255 };
-            SDL_Surface* s = TTF_RenderText_Blended(SDLUI_Font.handle, btn->text.data, c);
-            btn->tex_text = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-            SDL_FreeSurface(s);
+            return g->tex;
         }
+    }
 
-        i32 xx = btn->x - btn->parent->x;
-        i32 yy = btn->y - btn->parent->y;
+    if (SDLUI_ThemeCache.num_gradients == SDLUI_ThemeCache.gradient_capacity)
+    {
+        SDLUI_ThemeCache.gradient_capacity = SDLUI_ThemeCache.gradient_capacity > 0 ? SDLUI_ThemeCache.gradient_capacity * 2 : 8;
+        SDLUI_ThemeCache.gradients = (SDLUI_Gradient*)realloc(SDLUI_ThemeCache.gradients, SDLUI_ThemeCache.gradient_capacity * sizeof(SDLUI_Gradient));
+    }
 
-        SDL_Rect r = { xx, yy, btn->w, btn->h };
+    SDLUI_Gradient* g = &SDLUI_ThemeCache.gradients[SDLUI_ThemeCache.num_gradients++];
+    g->color = c;
+    g->w = width;
+    g->h = height;
+    g->interv = interv;
+    g->tex = SDL_CreateTexture(SDLUI_Core.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    SDLUI_GradientToTexture(g->tex, c, width, height, interv);
 
-        switch (btn->state)
-        {
-        case SDLUI_BUTTON_STATE_NORMAL:
-            SDLUI_SetColor(SDLUI_Core.theme.col_button_normal);
-            break;
+    return g->tex;
+}
 
-        case SDLUI_BUTTON_STATE_HOVER:
-            SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
-            break;
+float SDLUI_Max(float a, float b)
+{
+    if (a > b)
+    {
+        return a;
+    }
 
-        case SDLUI_BUTTON_STATE_CLICK:
-            SDLUI_SetColor(SDLUI_Core.theme.col_button_click);
-            break;
-        }
+    return b;
+}
 
-        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+void SDLUI_Colorize(SDL_Texture* t, SDL_Color c)
+{
+    SDL_SetTextureColorMod(t, c.r, c.g, c.b);
+}
 
-        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
-        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+// Render targets are allocated with some slack so growing a little doesn't need a new texture.
+i32 SDLUI_TargetCapacity(i32 size)
+{
+    size += size / 4;
+    return (size + 63) & ~63;
+}
 
-        i32 tex_w, tex_h;
-        SDL_QueryTexture(btn->tex_text, NULL, NULL, &tex_w, &tex_h);
+// Returns a render target at least w*h big, reusing a released one when it fits.
+// The texture can be larger than asked for, so callers keep track of the size they use.
+SDL_Texture* SDLUI_AcquireTarget(i32 w, i32 h)
+{
+    SDLUI_RenderTarget* best = NULL;
 
-        i32 diff = btn->w - tex_w;
-        i32 offset = diff * btn->align / 2;
+    for (int i = 0; i < SDLUI_TargetPool.size; ++i)
+    {
+        SDLUI_RenderTarget* t = &SDLUI_TargetPool.targets[i];
 
-        if (btn->align == SDLUI_ALIGN_LEFT)
+        if (!t->in_use && t->capacity_w >= w && t->capacity_h >= h)
         {
-            offset += SDLUI_MARGIN;
-        }
-        else if (btn->align == SDLUI_ALIGN_RIGHT)
-        {
-            offset -= SDLUI_MARGIN;
+            if (best == NULL || t->capacity_w * t->capacity_h < best->capacity_w * best->capacity_h)
+            {
+                best = t;
+            }
         }
-
-        r = { xx + offset, yy + SDLUI_MARGIN, tex_w, tex_h };
-        SDL_RenderCopy(SDLUI_Core.renderer, btn->tex_text, NULL, &r);
     }
-}
 
-void SDLUI_Render_SliderInt(SDLUI_Control_SliderInt* si)
-{
-    if (si->visible)
+    if (best != NULL)
     {
-        if (si->orientation == SDLUI_ORIENTATION_HORIZONTAL)
-        {
-            i32 xx = si->x - si->parent->x;
-            i32 yy = si->y - si->parent->y;
-
-            i32 fill = (i32)SDLUI_Map(si->min, si->max, 0, si->w, si->value);
-
-            SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
-            SDL_RenderDrawLine(SDLUI_Core.renderer, xx, yy + 8, xx + fill, yy + 8);
+        best->in_use = true;
+        return best->tex;
+    }
 
-            SDLUI_SetColor(SDLUI_Core.theme.col_border);
-            SDL_RenderDrawLine(SDLUI_Core.renderer, xx + fill, yy + 8, xx + si->w, yy + 8);
+    if (SDLUI_TargetPool.size >= SDLUI_TargetPool.capacity)
+    {
+        SDLUI_TargetPool.capacity += SDLUI_COLLECTION_CHUNK;
+        SDLUI_TargetPool.targets = (SDLUI_RenderTarget*)realloc(SDLUI_TargetPool.targets, SDLUI_TargetPool.capacity * sizeof(SDLUI_RenderTarget));
+    }
 
-            SDL_Rect r = { xx + fill - 8, yy, 16, 16 };
-            r.x = SDLUI_Clamp(r.x, xx, xx + si->w - 14);
-            SDLUI_Colorize(SDLUI_Core.tex_circle_fill_1, SDLUI_Core.theme.col_scrollbar_thumb);
-            SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_circle_fill_1, NULL, &r);
-            SDLUI_Colorize(SDLUI_Core.tex_circle, SDLUI_Core.theme.col_white);
-            SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_circle, NULL, &r);
-        }
-        else
-        {
-            i32 xx = si->x - si->parent->x;
-            i32 yy = si->y - si->parent->y;
+    SDLUI_RenderTarget* t = &SDLUI_TargetPool.targets[SDLUI_TargetPool.size++];
+    t->capacity_w = SDLUI_TargetCapacity(w);
+    t->capacity_h = SDLUI_TargetCapacity(h);
+    t->tex = SDL_CreateTexture(SDLUI_Core.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, t->capacity_w, t->capacity_h);
+    t->in_use = true;
 
-            i32 fill = (i32)SDLUI_Map(si->min, si->max, 0, si->h, si->value);
+    return t->tex;
+}
 
-            SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
-            SDL_RenderDrawLine(SDLUI_Core.renderer, xx + 8, yy + si->h, xx + 8, yy + si->h - fill);
+// Gives a render target back to the pool. Only a few free ones are kept around, the largest go first.
+void SDLUI_ReleaseTarget(SDL_Texture* tex)
+{
+    // text may still be queued up for it.
+    SDLUI_FlushText();
 
-            SDLUI_SetColor(SDLUI_Core.theme.col_border);
-            SDL_RenderDrawLine(SDLUI_Core.renderer, xx + 8, yy + si->h - fill, xx + 8, yy);
+    SDLUI_RenderTarget* t = SDLUI_TargetPool.find(tex);
 
-            SDL_Rect r = { xx, yy + si->h - fill - 8, 16, 16 };
-            r.y = SDLUI_Clamp(r.y, yy, yy + si->h - 14);
-            SDLUI_Colorize(SDLUI_Core.tex_circle_fill_1, SDLUI_Core.theme.col_scrollbar_thumb);
-            SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_circle_fill_1, NULL, &r);
-            SDLUI_Colorize(SDLUI_Core.tex_circle, SDLUI_Core.theme.col_white);
-            SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_circle, NULL, &r);
-        }
+    if (t == NULL)
+    {
+        SDL_DestroyTexture(tex);
+        return;
     }
-}
 
-void SDLUI_Render_CheckBox(SDLUI_Control_CheckBox* chk)
-{
-    if (chk->visible)
-    {
-        i32 xx = chk->x - chk->parent->x;
-        i32 yy = chk->y - chk->parent->y;
+    t->in_use = false;
 
-        SDLUI_SetColor(SDLUI_Core.theme.col_white);
+    i32 num_free = 0;
+    i32 largest = -1;
 
-        SDL_Rect r = { xx, yy, chk->w, chk->h };
-        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+    for (int i = 0; i < SDLUI_TargetPool.size; ++i)
+    {
+        t = &SDLUI_TargetPool.targets[i];
 
-        if (chk->checked)
+        if (!t->in_use)
         {
-            SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_tick, NULL, &r);
-        }
+            num_free++;
 
-        if (chk->tex_text != NULL)
-        {
-            i32 tex_w, tex_h;
-            SDL_QueryTexture(chk->tex_text, NULL, NULL, &tex_w, &tex_h);
-            r = { xx + chk->w + SDLUI_MARGIN, yy + 2, tex_w, tex_h };
-            SDL_RenderCopy(SDLUI_Core.renderer, chk->tex_text, NULL, &r);
+            if (largest < 0 || t->capacity_w * t->capacity_h > SDLUI_TargetPool.targets[largest].capacity_w * SDLUI_TargetPool.targets[largest].capacity_h)
+            {
+                largest = i;
+            }
         }
     }
+
+    if (num_free > SDLUI_TARGET_POOL_MAX_FREE)
+    {
+        SDL_DestroyTexture(SDLUI_TargetPool.targets[largest].tex);
+        SDLUI_TargetPool.remove(largest);
+    }
 }
 
-void SDLUI_Render_Text(SDLUI_Control_Text* txt)
+// Makes sure tex can hold w*h, only swapping it for another target when it is too small.
+SDL_Texture* SDLUI_ResizeTarget(SDL_Texture* tex, i32 w, i32 h)
 {
-    if (txt->visible)
-    {
-        if (txt->text.modified)
-        {
-            txt->w = (txt->text.length) * SDLUI_Font.width;
-            SDL_Color c = { 255, 255, 255, 255 };
-            SDL_Surface* s = TTF_RenderText_Blended(SDLUI_Font.handle, txt->text.data, c);
-            txt->tex_text = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-            SDL_FreeSurface(s);
-            txt->text.modified = false;
-        }
+    SDLUI_RenderTarget* t = SDLUI_TargetPool.find(tex);
 
-        i32 xx = txt->x - txt->parent->x;
-        i32 yy = txt->y - txt->parent->y;
+    if (t != NULL && t->capacity_w >= w && t->capacity_h >= h)
+    {
+        return tex;
+    }
+
+    SDLUI_ReleaseTarget(tex);
+    return SDLUI_AcquireTarget(w, h);
+}
+
+void SDLUI_SetActiveWindow(SDLUI_Control_Window* wnd)
+{
+    SDLUI_Window_Collection.to_back(wnd);
+    SDLUI_Core.active_window = wnd;
+}
+
+SDLUI_RESIZE_DIRECTION SDLUI_SetWindowResizeCursor(SDLUI_Control_Window* wnd, i32 mousex, i32 mousey)
+{
+    SDL_Rect left, top, right, bottom, lt, rt, lb, rb;
+    left = { wnd->x - 8, wnd->y, 8, wnd->h };
+    top = { wnd->x, wnd->y - 8, wnd->w, 8 };
+    right = { wnd->x + wnd->w, wnd->y, 8, wnd->h };
+    bottom = { wnd->x, wnd->y + wnd->h, wnd->w, 8 };
+
+    lt = { wnd->x - 8, wnd->y - 8, 8, 8 };
+    rt = { wnd->x + wnd->w, wnd->y - 8, 8, 8 };
+    lb = { wnd->x - 8, wnd->y + wnd->h, 8, 8 };
+    rb = { wnd->x + wnd->w, wnd->y + wnd->h, 8, 8 };
+
+    if (SDLUI_PointInRect(left, mousex, mousey))
+    {
+        SDL_SetCursor(SDLUI_Core.cursor_size_we);
+        return SDLUI_RESIZE_LEFT;
+    }
+    else if (SDLUI_PointInRect(top, mousex, mousey))
+    {
+        SDL_SetCursor(SDLUI_Core.cursor_size_ns);
+        return SDLUI_RESIZE_TOP;
+    }
+    else if (SDLUI_PointInRect(right, mousex, mousey))
+    {
+        SDL_SetCursor(SDLUI_Core.cursor_size_we);
+        return SDLUI_RESIZE_RIGHT;
+    }
+    else if (SDLUI_PointInRect(bottom, mousex, mousey))
+    {
+        SDL_SetCursor(SDLUI_Core.cursor_size_ns);
+        return SDLUI_RESIZE_BOTTOM;
+    }
+    else if (SDLUI_PointInRect(lt, mousex, mousey))
+    {
+        SDL_SetCursor(SDLUI_Core.cursor_size_nwse);
+        return SDLUI_RESIZE_LEFT_TOP;
+    }
+    else if (SDLUI_PointInRect(rt, mousex, mousey))
+    {
+        SDL_SetCursor(SDLUI_Core.cursor_size_nesw);
+        return SDLUI_RESIZE_RIGHT_TOP;
+    }
+    else if (SDLUI_PointInRect(lb, mousex, mousey))
+    {
+        SDL_SetCursor(SDLUI_Core.cursor_size_nesw);
+        return SDLUI_RESIZE_LEFT_BOTTOM;
+    }
+    else if (SDLUI_PointInRect(rb, mousex, mousey))
+    {
+        SDL_SetCursor(SDLUI_Core.cursor_size_nwse);
+        return SDLUI_RESIZE_RIGHT_BOTTOM;
+    }
+
+    SDL_SetCursor(SDLUI_Core.cursor_arrow);
+
+    return SDLUI_RESIZE_NONE;
+}
+
+void SDLUI_ResizeWindow(SDLUI_Control_Window* aw, SDLUI_RESIZE_DIRECTION res_dir, i32 mx, i32 my)
+{
+    if (res_dir == SDLUI_RESIZE_RIGHT)
+    {
+        aw->w = mx - aw->x;
+    }
+    else if (res_dir == SDLUI_RESIZE_LEFT)
+    {
+        aw->w += aw->x - mx;
+        if (aw->w > SDLUI_WINDOW_MIN_SIZE)
+        {
+            aw->x = mx;
+        }
+    }
+    else if (res_dir == SDLUI_RESIZE_BOTTOM)
+    {
+        aw->h = my - aw->y;
+    }
+    else if (res_dir == SDLUI_RESIZE_TOP)
+    {
+        aw->h += aw->y - my;
+        if (aw->h > SDLUI_WINDOW_MIN_SIZE)
+        {
+            aw->y = my;
+        }
+    }
+    else if (res_dir == SDLUI_RESIZE_LEFT_TOP)
+    {
+        aw->w += aw->x - mx;
+        if (aw->w > SDLUI_WINDOW_MIN_SIZE)
+        {
+            aw->x = mx;
+        }
+        aw->h += aw->y - my;
+        if (aw->h > SDLUI_WINDOW_MIN_SIZE)
+        {
+            aw->y = my;
+        }
+    }
+    else if (res_dir == SDLUI_RESIZE_RIGHT_TOP)
+    {
+        aw->h += aw->y - my;
+        if (aw->h > SDLUI_WINDOW_MIN_SIZE)
+        {
+            aw->y = my;
+        }
+        aw->w = mx - aw->x;
+    }
+    else if (res_dir == SDLUI_RESIZE_LEFT_BOTTOM)
+    {
+        aw->w += aw->x - mx;
+        if (aw->w > SDLUI_WINDOW_MIN_SIZE)
+        {
+            aw->x = mx;
+        }
+        aw->h = my - aw->y;
+    }
+    else if (res_dir == SDLUI_RESIZE_RIGHT_BOTTOM)
+    {
+        aw->w = mx - aw->x;
+        aw->h = my - aw->y;
+    }
+
+    aw->w = SDLUI_Clamp(aw->w, 120, 10000);
+    aw->h = SDLUI_Clamp(aw->h, 120, 10000);
+
+    SDLUI_Core.layout_generation++;
+}
+
+void SDLUI_WindowHandler()
+{
+    i32 mx = SDLUI_Input.mouse_x;
+    i32 my = SDLUI_Input.mouse_y;
+    i32 index = 0;
+
+    // queued commands can destroy windows, the active one included, so only look at it afterwards.
+    SDLUI_ExecuteCommands();
+
+    SDLUI_Control_Window* aw = SDLUI_Core.active_window;
+
+    if (aw != NULL)
+    {
+        if (!aw->is_resized && aw->can_be_resized)
+        {
+            aw->resize_direction = SDLUI_SetWindowResizeCursor(aw, mx, my);
+
+            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD)
+            {
+                aw->is_resized = true;
+            }
+        }
+
+        if (aw->is_resized && !aw->is_dragged)
+        {
+            SDLUI_ResizeWindow(aw, aw->resize_direction, mx, my);
+            if (aw->tex_rect != NULL)
+            {
+                aw->tex_rect = SDLUI_ResizeTarget(aw->tex_rect, aw->w, aw->h);
+            }
+            aw->dirty = true;
+        }
+        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_RELEASED && aw->is_resized)
+        {
+            aw->is_resized = false;
+            SDL_SetCursor(SDLUI_Core.cursor_arrow);
+        }
+    }
+
+    if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED && SDL_GetCursor() == SDLUI_Core.cursor_arrow)
+    {
+        SDLUI_Control_Window* wnd;
+        SDL_Rect r;
+        bool hovers_window = false;
+
+        for (int i = 0; i < SDLUI_Window_Collection.size; ++i)
+        {
+            wnd = (SDLUI_Control_Window*)SDLUI_Window_Collection.data[i];
+
+            if (wnd->visible)
+            {
+                r = { wnd->x, wnd->y, wnd->w, wnd->h };
+
+                if (SDLUI_PointInRect(r, mx, my))
+                {
+                    index = i;
+                    hovers_window = true;
+                }
+            }
+        }
+
+        if (SDLUI_Window_Collection.data[index] != SDLUI_Core.active_window && hovers_window)
+        {
+            SDLUI_SetActiveWindow((SDLUI_Control_Window*)SDLUI_Window_Collection.data[index]);
+        }
+        else if (!hovers_window)
+        {
+            SDLUI_Core.active_window = NULL;
+        }
+    }
+}
+
+// Got this from StackOverflow.
+void save_texture(SDL_Renderer* ren, SDL_Texture* tex, const char* filename)
+{
+    SDL_Texture* ren_tex;
+    SDL_Surface* surf;
+    int st;
+    int w;
+    int h;
+    int format;
+    void* pixels;
+
+    pixels = NULL;
+    surf = NULL;
+    ren_tex = NULL;
+    format = SDL_PIXELFORMAT_RGBA32;
+
+    /* Get information about texture we want to save */
+    st = SDL_QueryTexture(tex, NULL, NULL, &w, &h);
+    if (st != 0) {
+        SDL_Log("Failed querying texture: %s\n", SDL_GetError());
+        goto cleanup;
+    }
+
+    ren_tex = SDL_CreateTexture(ren, format, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!ren_tex) {
+        SDL_Log("Failed creating render texture: %s\n", SDL_GetError());
+        goto cleanup;
+    }
+
+    /*
+     * Initialize our canvas, then copy texture to a target whose pixel data we
+     * can access
+     */
+    st = SDL_SetRenderTarget(ren, ren_tex);
+    if (st != 0) {
+        SDL_Log("Failed setting render target: %s\n", SDL_GetError());
+        goto cleanup;
+    }
+
+    SDL_SetRenderDrawColor(ren, 0x00, 0x00, 0x00, 0x00);
+    SDL_RenderClear(ren);
+
+    st = SDL_RenderCopy(ren, tex, NULL, NULL);
+    if (st != 0) {
+        SDL_Log("Failed copying texture data: %s\n", SDL_GetError());
+        goto cleanup;
+    }
+
+    /* Create buffer to hold texture data and load it */
+    pixels = malloc(w * h * SDL_BYTESPERPIXEL(format));
+    if (!pixels) {
+        SDL_Log("Failed allocating memory\n");
+        goto cleanup;
+    }
+
+    st = SDL_RenderReadPixels(ren, NULL, format, pixels, w * SDL_BYTESPERPIXEL(format));
+    if (st != 0) {
+        SDL_Log("Failed reading pixel data: %s\n", SDL_GetError());
+        goto cleanup;
+    }
+
+    /* Copy pixel data over to surface */
+    surf = SDL_CreateRGBSurfaceWithFormatFrom(pixels, w, h, SDL_BITSPERPIXEL(format), w * SDL_BYTESPERPIXEL(format), format);
+    if (!surf) {
+        SDL_Log("Failed creating new surface: %s\n", SDL_GetError());
+        goto cleanup;
+    }
+
+    /* Save result to an image */
+    st = SDL_SaveBMP(surf, filename);
+    if (st != 0) {
+        SDL_Log("Failed saving image: %s\n", SDL_GetError());
+        goto cleanup;
+    }
+
+    SDL_Log("Saved texture as BMP to \"%s\"\n", filename);
+
+cleanup:
+    SDL_FreeSurface(surf);
+    free(pixels);
+    SDL_DestroyTexture(ren_tex);
+}
+
+// Draws everything queued up by SDLUI_DrawText into its target in a single call.
+void SDLUI_FlushText()
+{
+    if (SDLUI_TextBatch.index_count == 0)
+    {
+        return;
+    }
+
+    SDL_Texture* previous = SDL_GetRenderTarget(SDLUI_Core.renderer);
+
+    if (previous != SDLUI_TextBatch.target)
+    {
+        SDL_SetRenderTarget(SDLUI_Core.renderer, SDLUI_TextBatch.target);
+    }
+
+    SDL_RenderGeometry(SDLUI_Core.renderer, SDLUI_TextBatch.texture, SDLUI_TextBatch.vertices, SDLUI_TextBatch.vertex_count, SDLUI_TextBatch.indices, SDLUI_TextBatch.index_count);
+
+    if (previous != SDLUI_TextBatch.target)
+    {
+        SDL_SetRenderTarget(SDLUI_Core.renderer, previous);
+    }
+
+    SDLUI_TextBatch.vertex_count = 0;
+    SDLUI_TextBatch.index_count = 0;
+}
+
+// Queues length bytes of UTF-8 text starting at start. Nothing is drawn until SDLUI_FlushText.
+void SDLUI_DrawTextRange(i32 x, i32 y, const char* text, i32 start, i32 length, SDL_Texture* dst)
+{
+    // text going somewhere else has to be drawn first so the order of draws is kept.
+    if (dst != SDLUI_TextBatch.target)
+    {
+        SDLUI_FlushText();
+        SDLUI_TextBatch.target = dst;
+    }
+
+    SDLUI_TextBatch.ensure_capacity(length);
+
+    float inv_size = 1.0f / SDLUI_GLYPH_PAGE_SIZE;
+    float pos_x = (float)x;
+    float pos_y = (float)y;
+    SDL_Color c = SDLUI_Core.theme.col_white;
+    u32 previous = 0;
+    i32 i = start;
+
+    while (i < start + length && text[i] != '\0')
+    {
+        u32 codepoint = SDLUI_DecodeUTF8(text, &i);
+        SDLUI_Glyph g = SDLUI_GetGlyph(codepoint);
+
+        if (previous != 0)
+        {
+            pos_x += SDLUI_Kerning(previous, codepoint);
+        }
+        previous = codepoint;
+
+        if (g.page >= 0)
+        {
+            SDL_Texture* page = SDLUI_GlyphCache.pages[g.page].tex;
+
+            if (page != SDLUI_TextBatch.texture)
+            {
+                SDLUI_FlushText();
+                SDLUI_TextBatch.texture = page;
+            }
+
+            float x0 = pos_x + g.offset_x;
+            float x1 = x0 + g.src.w;
+            float y1 = pos_y + g.src.h;
+            float u0 = g.src.x * inv_size;
+            float u1 = (g.src.x + g.src.w) * inv_size;
+            float v0 = g.src.y * inv_size;
+            float v1 = (g.src.y + g.src.h) * inv_size;
+
+            SDL_Vertex* v = SDLUI_TextBatch.vertices + SDLUI_TextBatch.vertex_count;
+            v[0] = { { x0, pos_y }, c, { u0, v0 } };
+            v[1] = { { x1, pos_y }, c, { u1, v0 } };
+            v[2] = { { x1, y1 }, c, { u1, v1 } };
+            v[3] = { { x0, y1 }, c, { u0, v1 } };
+
+            i32* idx = SDLUI_TextBatch.indices + SDLUI_TextBatch.index_count;
+            i32 base = SDLUI_TextBatch.vertex_count;
+            idx[0] = base; idx[1] = base + 1; idx[2] = base + 2;
+            idx[3] = base; idx[4] = base + 2; idx[5] = base + 3;
+
+            SDLUI_TextBatch.vertex_count += 4;
+            SDLUI_TextBatch.index_count += 6;
+        }
+
+        pos_x += g.advance;
+    }
+}
+
+void SDLUI_DrawText(i32 x, i32 y, const char* text, SDL_Texture* dst)
+{
+    SDLUI_DrawTextRange(x, y, text, 0, strlen(text), dst);
+}
+
+// Queues control text into whatever the window is currently being rendered into.
+// It lands on top of the window's shapes when the window flushes the batch.
+void SDLUI_DrawControlText(i32 x, i32 y, const char* text)
+{
+    SDLUI_DrawText(x, y, text, SDL_GetRenderTarget(SDLUI_Core.renderer));
+}
+
+void SDLUI_Render_Button(SDLUI_Control_Button* btn)
+{
+    if (btn->visible)
+    {
+        i32 xx = btn->x;
+        i32 yy = btn->y;
+
+        SDL_Rect r = { xx, yy, btn->w, btn->h };
+
+        switch (btn->state)
+        {
+        case SDLUI_BUTTON_STATE_NORMAL:
+            SDLUI_SetColor(SDLUI_Core.theme.col_button_normal);
+            break;
+
+        case SDLUI_BUTTON_STATE_HOVER:
+            SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
+            break;
+
+        case SDLUI_BUTTON_STATE_CLICK:
+            SDLUI_SetColor(SDLUI_Core.theme.col_button_click);
+            break;
+        }
+
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
+        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+
+        i32 diff = btn->w - SDLUI_MeasureText(btn->text.data);
+        i32 offset = diff * btn->align / 2;
+
+        if (btn->align == SDLUI_ALIGN_LEFT)
+        {
+            offset += SDLUI_MARGIN;
+        }
+        else if (btn->align == SDLUI_ALIGN_RIGHT)
+        {
+            offset -= SDLUI_MARGIN;
+        }
+
+        SDLUI_DrawControlText(xx + offset, yy + SDLUI_MARGIN, btn->text.data);
+    }
+}
+
+void SDLUI_Render_SliderInt(SDLUI_Control_SliderInt* si)
+{
+    if (si->visible)
+    {
+        if (si->orientation == SDLUI_ORIENTATION_HORIZONTAL)
+        {
+            i32 xx = si->x;
+            i32 yy = si->y;
+
+            i32 fill = (i32)SDLUI_Map(si->min, si->max, 0, si->w, si->value);
+
+            SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
+            SDL_RenderDrawLine(SDLUI_Core.renderer, xx, yy + 8, xx + fill, yy + 8);
+
+            SDLUI_SetColor(SDLUI_Core.theme.col_border);
+            SDL_RenderDrawLine(SDLUI_Core.renderer, xx + fill, yy + 8, xx + si->w, yy + 8);
+
+            SDL_Rect r = { xx + fill - 8, yy, 16, 16 };
+            r.x = SDLUI_Clamp(r.x, xx, xx + si->w - 14);
+            SDLUI_DrawIcon(SDLUI_ICON_CIRCLE_FILL_BIG, &r, SDLUI_Core.theme.col_scrollbar_thumb);
+            SDLUI_DrawIcon(SDLUI_ICON_CIRCLE, &r, SDLUI_Core.theme.col_white);
+        }
+        else
+        {
+            i32 xx = si->x;
+            i32 yy = si->y;
+
+            i32 fill = (i32)SDLUI_Map(si->min, si->max, 0, si->h, si->value);
+
+            SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
+            SDL_RenderDrawLine(SDLUI_Core.renderer, xx + 8, yy + si->h, xx + 8, yy + si->h - fill);
+
+            SDLUI_SetColor(SDLUI_Core.theme.col_border);
+            SDL_RenderDrawLine(SDLUI_Core.renderer, xx + 8, yy + si->h - fill, xx + 8, yy);
+
+            SDL_Rect r = { xx, yy + si->h - fill - 8, 16, 16 };
+            r.y = SDLUI_Clamp(r.y, yy, yy + si->h - 14);
+            SDLUI_DrawIcon(SDLUI_ICON_CIRCLE_FILL_BIG, &r, SDLUI_Core.theme.col_scrollbar_thumb);
+            SDLUI_DrawIcon(SDLUI_ICON_CIRCLE, &r, SDLUI_Core.theme.col_white);
+        }
+    }
+}
+
+void SDLUI_Render_CheckBox(SDLUI_Control_CheckBox* chk)
+{
+    if (chk->visible)
+    {
+        i32 xx = chk->x;
+        i32 yy = chk->y;
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_white);
+
+        SDL_Rect r = { xx, yy, chk->w, chk->h };
+        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+
+        if (chk->checked)
+        {
+            SDLUI_DrawIcon(SDLUI_ICON_TICK, &r, SDLUI_Core.theme.col_white);
+        }
+
+        if (chk->text.length > 0)
+        {
+            SDLUI_DrawControlText(xx + chk->w + SDLUI_MARGIN, yy + 2, chk->text.data);
+        }
+    }
+}
+
+void SDLUI_Render_Text(SDLUI_Control_Text* txt)
+{
+    if (txt->visible)
+    {
+        i32 xx = txt->x;
+        i32 yy = txt->y;
+
+        SDLUI_DrawControlText(xx, yy, txt->text.data);
+    }
+}
+
+void SDLUI_Render_ToggleButton(SDLUI_Control_ToggleButton* tb)
+{
+    if (tb->visible)
+    {
+        i32 xx = tb->x;
+        i32 yy = tb->y;
+
+        SDL_Rect r = { xx, yy, tb->w, tb->h };
+        SDLUI_DrawIcon(SDLUI_ICON_TOGGLE, &r, SDLUI_Core.theme.col_white);
+
+        if (tb->checked)
+        {
+            r = { xx + 16, yy, tb->w - 16, tb->h };
+            SDLUI_DrawIcon(SDLUI_ICON_CIRCLE_FILL_SMALL, &r, SDLUI_Core.theme.col_highlight);
+        }
+        else
+        {
+            r = { xx, yy, tb->w - 16, tb->h };
+            SDLUI_DrawIcon(SDLUI_ICON_CIRCLE_FILL_SMALL, &r, SDLUI_Core.theme.col_white);
+        }
+
+        if (tb->text.length > 0)
+        {
+            SDLUI_DrawControlText(xx + tb->w + SDLUI_MARGIN, yy + 2, tb->text.data);
+        }
+    }
+}
+
+void SDLUI_Render_RadioButton(SDLUI_Control_RadioButton* rb)
+{
+    if (rb->visible)
+    {
+        i32 xx = rb->x;
+        i32 yy = rb->y;
+
+        SDL_Rect r = { xx, yy, rb->w, rb->h };
+        SDLUI_DrawIcon(SDLUI_ICON_CIRCLE, &r, SDLUI_Core.theme.col_white);
+
+        if (rb->checked)
+        {
+            SDLUI_DrawIcon(SDLUI_ICON_CIRCLE_FILL_SMALL, &r, SDLUI_Core.theme.col_white);
+        }
+
+        if (rb->text.length > 0)
+        {
+            SDLUI_DrawControlText(xx + rb->w + SDLUI_MARGIN, yy + 2, rb->text.data);
+        }
+    }
+}
+
+void SDLUI_RenderChild(SDLUI_CONTROL_TYPE type, SDLUI_Control* ctrl);
+
+void SDLUI_Render_Tabcontainer(SDLUI_Control_TabContainer* tbc)
+{
+    if (tbc->visible)
+    {
+        i32 xx = tbc->x;
+        i32 yy = tbc->y;
+        i32 offset = 0;
+
+        SDL_Rect r = { xx, yy, tbc->w, tbc->bar_height };
+        SDLUI_SetColor(SDLUI_Core.theme.col_inactive_window_bar);
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+        SDLUI_Control_Tab* tab;
+
+        for (int i = 0; i < tbc->tabs.size; ++i)
+        {
+            tab = (SDLUI_Control_Tab*)tbc->tabs.data[i];
+
+            r = { SDLUI_MARGIN + xx + offset, yy + SDLUI_MARGIN, tab->w, tab->h };
+            SDLUI_DrawControlText(r.x, r.y, tab->text.data);
+
+            if (tab == tbc->active_tab)
+            {
+                SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
+                r.y += 2 * SDLUI_MARGIN;
+                r.h = 2;
+                SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+            }
+
+            offset += SDLUI_MARGIN + tab->w;
+        }
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_window_bg);
+        r = { xx, yy + tbc->bar_height, tbc->w, tbc->h - tbc->bar_height };
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
+        r = { xx, yy, tbc->w, tbc->h };
+        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+
+        tab = (SDLUI_Control_Tab*)tbc->active_tab;
+
+        SDLUI_CONTROL_TYPE type;
+        SDLUI_Control* ctrl;
+
+        for (int j = 0; j < tab->children.size; ++j)
+        {
+            type = tab->children.data[j]->type;
+            ctrl = tab->children.data[j];
+
+            ctrl->visible = true;
+
+            if (ctrl->do_process)
+            {
+                SDLUI_RenderChild(type, ctrl);
+            }
+        }
+    }
+}
+
+// The scrollbars take space away from the visible part of the content when it doesn't fit.
+void SDLUI_UpdateScrollAreaClient(SDLUI_Control_ScrollArea* sa)
+{
+    sa->client_width = sa->content_height > sa->h ? sa->w - sa->scrollbar_thickness : sa->w;
+    sa->client_height = sa->content_width > sa->w ? sa->h - sa->scrollbar_thickness : sa->h;
+}
+
+void SDLUI_Render_ScrollArea(SDLUI_Control_ScrollArea* sa)
+{
+    if (sa->visible)
+    {
+        i32 xx = sa->x;
+        i32 yy = sa->y;
+
+        SDL_Rect r;
+        SDL_Rect dst = { xx, yy, sa->client_width, sa->client_height };
+
+        if (sa->content_height > sa->h)
+        {
+            // vertical scrollbar
+            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_track);
+            r = { xx + sa->w - sa->scrollbar_thickness, yy, sa->scrollbar_thickness, sa->track_size_v };
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_thumb);
+            sa->thumb_size_v = (float)(sa->track_size_v * (sa->h - sa->scrollbar_thickness)) / (float)sa->content_height;
+
+            r = { xx + sa->w - sa->scrollbar_thickness + 1, yy + sa->scroll_y, sa->scrollbar_thickness - 4, sa->thumb_size_v };
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+        }
+
+        if (sa->content_width > sa->w)
+        {
+            // horizontal scrollbar
+            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_track);
+            r = { xx, yy + sa->h - sa->scrollbar_thickness, sa->track_size_h, sa->scrollbar_thickness };
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_thumb);
+            sa->thumb_size_h = (float)(sa->track_size_h * (sa->w - sa->scrollbar_thickness)) / (float)sa->content_width;
+
+            r = { xx + sa->scroll_x, yy + sa->h - sa->scrollbar_thickness + 1, sa->thumb_size_h, sa->scrollbar_thickness - 4 };
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+        }
+
+        // Texture
+        SDLUI_UpdateScrollAreaClient(sa);
+
+        float ratio_y = (float)sa->content_height / sa->client_height;
+        float ratio_x = (float)sa->content_width / sa->client_width;
+
+        float offset_x = sa->scroll_x * ratio_x;
+        float offset_y = sa->scroll_y * ratio_y;
+
+        offset_x = SDLUI_Clamp(offset_x, 0, sa->content_width - sa->client_width);
+        offset_y = SDLUI_Clamp(offset_y, 0, sa->content_height - sa->client_height);
+
+        SDL_Rect src = { (i32)offset_x, (i32)offset_y, sa->client_width, sa->client_height };
+        SDL_RenderCopy(SDLUI_Core.renderer, sa->tex_rect, &src, &dst);
+
+        // Container rect
+        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
+        r = { xx, yy, sa->w, sa->h };
+        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+    }
+}
+
+void SDLUI_Render_TextBox(SDLUI_Control_TextBox* tbx)
+{
+    if (tbx->visible)
+    {
+        i32 xx = tbx->x;
+        i32 yy = tbx->y;
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_textbox_bg);
+        SDL_Rect r = { xx, yy, tbx->w, tbx->h };
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
+        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+
+        if (tbx->text.length > 0)
+        {
+            // the pooled texture can be larger than the text area.
+            SDL_Rect src = { 0, 0, (i32)SDLUI_Max(1, tbx->w - (2 * SDLUI_MARGIN)), SDLUI_Font.height };
+            SDL_Rect dst = { xx + SDLUI_MARGIN, yy + SDLUI_MARGIN, src.w, src.h };
+            SDL_RenderCopy(SDLUI_Core.renderer, tbx->tex_text, &src, &dst);
+        }
+
+        if (tbx->focused && tbx->parent == SDLUI_Core.active_window && SDLUI_Core.active_window != NULL)
+        {
+            i32 cursor_x = SDLUI_MeasureTextRange(tbx->text.data, tbx->scroll, tbx->cursor_pos - tbx->scroll);
+            r = { xx + SDLUI_MARGIN + cursor_x, yy + 6, 2, tbx->h - 12 };
+            SDLUI_SetColor(SDLUI_Core.theme.col_white);
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+        }
+    }
+}
+
+void SDLUI_Render_VirtualList(SDLUI_Control_VirtualList* vl)
+{
+    if (vl->visible)
+    {
+        i32 xx = vl->x;
+        i32 yy = vl->y;
+
+        SDL_Rect r = { xx, yy, vl->w, vl->h };
+        SDLUI_SetColor(SDLUI_Core.theme.col_list_bg);
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+        bool has_scrollbar = vl->content_height() > vl->h;
+        i32 row_width = has_scrollbar ? vl->w - vl->scrollbar_thickness : vl->w;
+
+        // rows are clipped to the list, on top of whatever clipping the window is already doing.
+        SDL_Rect old_clip;
+        bool was_clipped = SDL_RenderIsClipEnabled(SDLUI_Core.renderer);
+        SDL_RenderGetClipRect(SDLUI_Core.renderer, &old_clip);
+
+        SDL_Rect clip = { xx, yy, row_width, vl->h };
+        if (was_clipped)
+        {
+            SDL_IntersectRect(&clip, &old_clip, &clip);
+        }
+        SDL_RenderSetClipRect(SDLUI_Core.renderer, &clip);
+
+        i32 first = vl->scroll_y / vl->item_height;
+        i32 last = (vl->scroll_y + vl->h) / vl->item_height + 1;
+        if (last > vl->num_items)
+        {
+            last = vl->num_items;
+        }
+
+        for (int i = first; i < last; ++i)
+        {
+            i32 row_y = yy + i * vl->item_height - vl->scroll_y;
+
+            if (i == vl->selected_index)
+            {
+                SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
+                r = { xx, row_y, row_width, vl->item_height };
+                SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+            }
+
+            const char* item = vl->get_item(i, vl->user_data);
+            if (item != NULL)
+            {
+                SDLUI_DrawControlText(xx + SDLUI_MARGIN, row_y, item);
+            }
+        }
+
+        SDLUI_FlushText();
+        SDL_RenderSetClipRect(SDLUI_Core.renderer, was_clipped ? &old_clip : NULL);
+
+        if (has_scrollbar)
+        {
+            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_track);
+            r = { xx + vl->w - vl->scrollbar_thickness, yy, vl->scrollbar_thickness, vl->h };
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_thumb);
+            r = { xx + vl->w - vl->scrollbar_thickness + 1, yy + vl->thumb_pos(), vl->scrollbar_thickness - 4, vl->thumb_size() };
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+        }
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
+        r = { xx, yy, vl->w, vl->h };
+        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+    }
+}
+
+void SDLUI_Render_TextEditor(SDLUI_Control_TextEditor* ed)
+{
+    if (ed->visible)
+    {
+        i32 xx = ed->x;
+        i32 yy = ed->y;
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_textbox_bg);
+        SDL_Rect r = { xx, yy, ed->w, ed->h };
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+        SDL_Rect src = { 0, 0, ed->text_width(), ed->text_height() };
+        SDL_Rect dst = { xx + SDLUI_MARGIN, yy + SDLUI_MARGIN, src.w, src.h };
+        SDL_RenderCopy(SDLUI_Core.renderer, ed->tex_text, &src, &dst);
+
+        if (ed->focused && ed->parent == SDLUI_Core.active_window && SDLUI_Core.active_window != NULL)
+        {
+            i32 row = ed->lines.line_of(ed->cursor) - ed->first_line;
+            i32 cursor_x = ed->cursor_x - ed->scroll_x;
+
+            if (row >= 0 && (row + 1) * ed->line_height <= src.h && cursor_x >= 0 && cursor_x < src.w)
+            {
+                r = { dst.x + cursor_x, dst.y + row * ed->line_height, 2, ed->line_height };
+                SDLUI_SetColor(SDLUI_Core.theme.col_white);
+                SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+            }
+        }
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_track);
+        r = { xx + ed->w - ed->scrollbar_thickness, yy, ed->scrollbar_thickness, ed->h };
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+        if (ed->max_first_line() > 0)
+        {
+            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_thumb);
+            r = { xx + ed->w - ed->scrollbar_thickness + 1, yy + ed->thumb_pos(), ed->scrollbar_thickness - 4, ed->thumb_size() };
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+        }
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
+        r = { xx, yy, ed->w, ed->h };
+        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+    }
+}
+
+void SDLUI_Render_Console(SDLUI_Control_Console* con)
+{
+    if (con->visible)
+    {
+        i32 xx = con->x;
+        i32 yy = con->y;
+
+        SDL_Rect r = { xx, yy, con->w, con->h };
+        SDLUI_SetColor(SDLUI_Core.theme.col_list_bg);
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+        bool has_scrollbar = con->content_height() > con->h;
+        i32 row_width = has_scrollbar ? con->w - con->scrollbar_thickness : con->w;
+
+        SDL_Rect old_clip;
+        bool was_clipped = SDL_RenderIsClipEnabled(SDLUI_Core.renderer);
+        SDL_RenderGetClipRect(SDLUI_Core.renderer, &old_clip);
+
+        SDL_Rect clip = { xx, yy, row_width, con->h };
+        if (was_clipped)
+        {
+            SDL_IntersectRect(&clip, &old_clip, &clip);
+        }
+        SDL_RenderSetClipRect(SDLUI_Core.renderer, &clip);
+
+        i32 first = con->scroll_y / con->item_height;
+        i32 last = (con->scroll_y + con->h) / con->item_height + 1;
+        if (last > con->num_matches)
+        {
+            last = con->num_matches;
+        }
+
+        SDL_Texture* target = SDL_GetRenderTarget(SDLUI_Core.renderer);
+        char text[SDLUI_LOG_LINE_SIZE];
+        i32 length;
+
+        for (int i = first; i < last; ++i)
+        {
+            // a line overwritten since it was matched is left blank until the scan drops it.
+            if (SDLUI_LogRing.read(con->match(i), text, &length) == SDLUI_LOG_LINE_READY)
+            {
+                SDLUI_DrawTextRange(xx + SDLUI_MARGIN, yy + i * con->item_height - con->scroll_y, text, 0, length, target);
+            }
+        }
+
+        SDLUI_FlushText();
+        SDL_RenderSetClipRect(SDLUI_Core.renderer, was_clipped ? &old_clip : NULL);
+
+        if (has_scrollbar)
+        {
+            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_track);
+            r = { xx + con->w - con->scrollbar_thickness, yy, con->scrollbar_thickness, con->h };
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_thumb);
+            r = { xx + con->w - con->scrollbar_thickness + 1, yy + con->thumb_pos(), con->scrollbar_thickness - 4, con->thumb_size() };
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+        }
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
+        r = { xx, yy, con->w, con->h };
+        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+    }
+}
+
+// Reduces the samples to one min and max per column of the plot and builds the triangles for them.
+void SDLUI_BuildPlotGeometry(SDLUI_Control_Plot* plot)
+{
+    SDL_Rect area = { plot->x + 1, plot->y + 1, plot->w - 2, plot->h - 2 };
+    bool histogram = plot->plot_type == SDLUI_PLOT_TYPE_HISTOGRAM;
+
+    plot->num_vertices = 0;
+    plot->num_indices = 0;
+    plot->geometry_x = plot->x;
+    plot->geometry_y = plot->y;
+    plot->geometry_dirty = false;
+
+    if (plot->count == 0 || area.w < 2 || area.h < 2)
+    {
+        return;
+    }
+
+    // bars get at least two pixels each, so they still take no more than two vertices per column.
+    i32 max_columns = histogram ? area.w / 2 : area.w;
+    i32 columns = plot->count < max_columns ? plot->count : max_columns;
+    i32 verts_per_column = histogram ? 4 : 2;
+
+    // the two buffers grow on their own, the plot type can change between builds and needs different amounts of each.
+    if (columns * verts_per_column + 4 > plot->vertex_capacity)
+    {
+        plot->vertex_capacity = columns * verts_per_column + 4;
+        plot->vertices = (SDL_Vertex*)realloc(plot->vertices, plot->vertex_capacity * sizeof(SDL_Vertex));
+    }
+
+    if ((columns + 1) * 6 > plot->index_capacity)
+    {
+        plot->index_capacity = (columns + 1) * 6;
+        plot->indices = (i32*)realloc(plot->indices, plot->index_capacity * sizeof(i32));
+    }
+
+    // min and max of each column go in the vertices first, they are turned into positions once the range is known.
+    float lo = FLT_MAX;
+    float hi = -FLT_MAX;
+
+    for (int c = 0; c < columns; ++c)
+    {
+        i32 first = (i32)((i64)c * plot->count / columns);
+        i32 last = (i32)((i64)(c + 1) * plot->count / columns);
+        float col_min = plot->sample(first);
+        float col_max = col_min;
+
+        for (int i = first + 1; i < last; ++i)
+        {
+            float v = plot->sample(i);
+            col_min = v < col_min ? v : col_min;
+            col_max = v > col_max ? v : col_max;
+        }
+
+        plot->vertices[c * 2].position.y = col_max;
+        plot->vertices[c * 2 + 1].position.y = col_min;
+        lo = col_min < lo ? col_min : lo;
+        hi = col_max > hi ? col_max : hi;
+    }
+
+    if (plot->min != plot->max)
+    {
+        lo = plot->min;
+        hi = plot->max;
+    }
+    if (hi <= lo)
+    {
+        hi = lo + 1.0f;
+    }
+
+    plot->drawn_min = lo;
+    plot->drawn_max = hi;
+
+    float bottom = (float)(area.y + area.h);
+    float scale = area.h / (hi - lo);
+
+    // histograms spread from the back so the column values aren't overwritten before they are read.
+    for (int c = columns - 1; c >= 0; --c)
+    {
+        float top = bottom - (SDLUI_Clamp(plot->vertices[c * 2].position.y, lo, hi) - lo) * scale;
+        float low = bottom - (SDLUI_Clamp(plot->vertices[c * 2 + 1].position.y, lo, hi) - lo) * scale;
+
+        if (histogram)
+        {
+            float bar_w = (float)area.w / columns;
+            float x0 = area.x + c * bar_w;
+            float x1 = x0 + (bar_w >= 3.0f ? bar_w - 1.0f : bar_w);
+            SDL_Vertex* v = plot->vertices + c * 4;
+
+            v[0] = { { x0, top }, plot->color, { 0, 0 } };
+            v[1] = { { x1, top }, plot->color, { 0, 0 } };
+            v[2] = { { x1, bottom }, plot->color, { 0, 0 } };
+            v[3] = { { x0, bottom }, plot->color, { 0, 0 } };
+
+            i32* idx = plot->indices + c * 6;
+            idx[0] = c * 4; idx[1] = c * 4 + 1; idx[2] = c * 4 + 2;
+            idx[3] = c * 4; idx[4] = c * 4 + 2; idx[5] = c * 4 + 3;
+        }
+        else
+        {
+            float x = area.x + (columns > 1 ? (float)c * (area.w - 1) / (columns - 1) : 0.0f);
+
+            // a line is the band between min and max, kept at least a pixel and a half thick.
+            if (plot->plot_type == SDLUI_PLOT_TYPE_AREA)
+            {
+                low = bottom;
+            }
+            else if (low - top < 1.5f)
+            {
+                low = top + 1.5f;
+            }
+
+            plot->vertices[c * 2] = { { x, top }, plot->color, { 0, 0 } };
+            plot->vertices[c * 2 + 1] = { { x, low }, plot->color, { 0, 0 } };
+        }
+    }
+
+    if (histogram)
+    {
+        plot->num_vertices = columns * 4;
+        plot->num_indices = columns * 6;
+        return;
+    }
+
+    // a single column still gets some width.
+    if (columns == 1)
+    {
+        plot->vertices[2] = plot->vertices[0];
+        plot->vertices[3] = plot->vertices[1];
+        plot->vertices[2].position.x += 2.0f;
+        plot->vertices[3].position.x += 2.0f;
+        columns = 2;
+    }
+
+    for (int c = 0; c < columns - 1; ++c)
+    {
+        i32* idx = plot->indices + c * 6;
+        idx[0] = c * 2; idx[1] = c * 2 + 2; idx[2] = c * 2 + 3;
+        idx[3] = c * 2; idx[4] = c * 2 + 3; idx[5] = c * 2 + 1;
+    }
+
+    plot->num_vertices = columns * 2;
+    plot->num_indices = (columns - 1) * 6;
+}
+
+void SDLUI_Render_Plot(SDLUI_Control_Plot* plot)
+{
+    if (plot->visible)
+    {
+        i32 xx = plot->x;
+        i32 yy = plot->y;
+
+        SDL_Rect r = { xx, yy, plot->w, plot->h };
+        SDLUI_SetColor(SDLUI_Core.theme.col_list_bg);
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+        if (plot->geometry_dirty || plot->geometry_x != xx || plot->geometry_y != yy)
+        {
+            SDLUI_BuildPlotGeometry(plot);
+        }
+
+        if (plot->num_indices > 0)
+        {
+            SDL_RenderGeometry(SDLUI_Core.renderer, NULL, plot->vertices, plot->num_vertices, plot->indices, plot->num_indices);
+
+            char label[32];
+            snprintf(label, sizeof(label), "%.2f", plot->drawn_max);
+            SDLUI_DrawControlText(xx + SDLUI_MARGIN / 2, yy, label);
+            snprintf(label, sizeof(label), "%.2f", plot->drawn_min);
+            SDLUI_DrawControlText(xx + SDLUI_MARGIN / 2, yy + plot->h - SDLUI_Font.height, label);
+        }
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
+        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+    }
+}
+
+void SDLUI_Render_Inspector(SDLUI_Control_Inspector* insp)
+{
+    if (insp->visible)
+    {
+        i32 xx = insp->x;
+        i32 yy = insp->y;
+
+        SDL_Rect r = { xx, yy, insp->w, insp->h };
+        SDLUI_SetColor(SDLUI_Core.theme.col_list_bg);
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+        SDL_Rect old_clip;
+        bool was_clipped = SDL_RenderIsClipEnabled(SDLUI_Core.renderer);
+        SDL_RenderGetClipRect(SDLUI_Core.renderer, &old_clip);
+
+        SDL_Rect clip = r;
+        if (was_clipped)
+        {
+            SDL_IntersectRect(&clip, &old_clip, &clip);
+        }
+        SDL_RenderSetClipRect(SDLUI_Core.renderer, &clip);
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
+        SDL_RenderDrawLine(SDLUI_Core.renderer, xx + insp->value_x - SDLUI_MARGIN / 2, yy, xx + insp->value_x - SDLUI_MARGIN / 2, yy + insp->h - 1);
+
+        // names and values all go through the glyph batch, so the rows cost one draw between them.
+        SDL_Texture* target = SDL_GetRenderTarget(SDLUI_Core.renderer);
+        i32 rows = insp->h / insp->item_height + 1;
+        for (i32 i = 0; i < insp->num_fields && i < rows; ++i)
+        {
+            i32 row_y = yy + i * insp->item_height;
+            SDLUI_InspectorField* field = &insp->fields[i];
+
+            SDLUI_DrawText(xx + SDLUI_MARGIN / 2, row_y, field->name, target);
+            SDLUI_DrawTextRange(xx + insp->value_x, row_y, insp->field_text(i), 0, field->length, target);
+        }
+
+        SDLUI_FlushText();
+        SDL_RenderSetClipRect(SDLUI_Core.renderer, was_clipped ? &old_clip : NULL);
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
+        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+    }
+}
+
+void SDLUI_RenderChild(SDLUI_CONTROL_TYPE type, SDLUI_Control* ctrl)
+{
+    switch (type)
+    {
+    case SDLUI_CONTROL_TYPE_BUTTON:
+    {
+        SDLUI_Render_Button((SDLUI_Control_Button*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_SLIDER_INT:
+    {
+        SDLUI_Render_SliderInt((SDLUI_Control_SliderInt*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_CHECKBOX:
+    {
+        SDLUI_Render_CheckBox((SDLUI_Control_CheckBox*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_TOGGLE_BUTTON:
+    {
+        SDLUI_Render_ToggleButton((SDLUI_Control_ToggleButton*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_RADIO_BUTTON:
+    {
+        SDLUI_Render_RadioButton((SDLUI_Control_RadioButton*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_TEXT:
+    {
+        SDLUI_Render_Text((SDLUI_Control_Text*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_TAB_CONTAINER:
+    {
+        SDLUI_Render_Tabcontainer((SDLUI_Control_TabContainer*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_SCROLL_AREA:
+    {
+        SDLUI_Render_ScrollArea((SDLUI_Control_ScrollArea*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_TEXTBOX:
+    {
+        SDLUI_Render_TextBox((SDLUI_Control_TextBox*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_VIRTUAL_LIST:
+    {
+        SDLUI_Render_VirtualList((SDLUI_Control_VirtualList*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_TEXT_EDITOR:
+    {
+        SDLUI_Render_TextEditor((SDLUI_Control_TextEditor*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_CONSOLE:
+    {
+        SDLUI_Render_Console((SDLUI_Control_Console*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_PLOT:
+    {
+        SDLUI_Render_Plot((SDLUI_Control_Plot*)ctrl);
+    }
+    break;
+
+    case SDLUI_CONTROL_TYPE_INSPECTOR:
+    {
+        SDLUI_Render_Inspector((SDLUI_Control_Inspector*)ctrl);
+    }
+    break;
+    }
+}
+
+// Where a control is on screen. Positions are stored relative to the parent, so this walks up the parents,
+// but only after something has moved since the last time it was asked.
+SDL_Rect SDLUI_GetScreenRect(SDLUI_Control* ctrl)
+{
+    if (ctrl->layout_generation != SDLUI_Core.layout_generation)
+    {
+        ctrl->screen_x = ctrl->x;
+        ctrl->screen_y = ctrl->y;
+
+        if (ctrl->parent != NULL)
+        {
+            SDL_Rect parent = SDLUI_GetScreenRect(ctrl->parent);
+            ctrl->screen_x += parent.x;
+            ctrl->screen_y += parent.y;
+        }
+
+        ctrl->layout_generation = SDLUI_Core.layout_generation;
+    }
+
+    return { ctrl->screen_x, ctrl->screen_y, ctrl->w, ctrl->h };
+}
+
+// Area of the window texture a control draws into, including the labels next to check boxes and the like.
+SDL_Rect SDLUI_GetControlBounds(SDLUI_Control* ctrl)
+{
+    SDL_Rect r = { ctrl->x, ctrl->y, ctrl->w, ctrl->h };
+    SDLUI_String* label = NULL;
+
+    switch (ctrl->type)
+    {
+    case SDLUI_CONTROL_TYPE_CHECKBOX:
+        label = &((SDLUI_Control_CheckBox*)ctrl)->text;
+        break;
+
+    case SDLUI_CONTROL_TYPE_TOGGLE_BUTTON:
+        label = &((SDLUI_Control_ToggleButton*)ctrl)->text;
+        break;
+
+    case SDLUI_CONTROL_TYPE_RADIO_BUTTON:
+        label = &((SDLUI_Control_RadioButton*)ctrl)->text;
+        break;
+
+    case SDLUI_CONTROL_TYPE_SLIDER_INT:
+        // the thumb hangs a little past the end of the track.
+        r.w += 2;
+        r.h += 2;
+        break;
+
+    default:
+        break;
+    }
+
+    if (label != NULL && label->length > 0)
+    {
+        r.w += SDLUI_MARGIN + SDLUI_MeasureText(label->data);
+        r.h = SDLUI_Max(r.h, 2 + SDLUI_Font.height);
+    }
+
+    return r;
+}
+
+// Marks a control for redrawing. Only needed when its fields are changed from outside of sdlui.
+void SDLUI_Invalidate(SDLUI_Control* ctrl)
+{
+    ctrl->dirty = true;
+
+    if (ctrl->type == SDLUI_CONTROL_TYPE_WINDOW)
+    {
+        ((SDLUI_Control_Window*)ctrl)->hit_grid.dirty = true;
+    }
+    else if (ctrl->parent != NULL)
+    {
+        ((SDLUI_Control_Window*)ctrl->parent)->hit_grid.dirty = true;
+    }
+}
+
+// Places a control at x, y relative to its window.
+void SDLUI_MoveControl(SDLUI_Control* ctrl, i32 x, i32 y)
+{
+    if (ctrl->x == x && ctrl->y == y)
+    {
+        return;
+    }
+
+    SDLUI_Invalidate(ctrl);
+    ctrl->x = x;
+    ctrl->y = y;
+    SDLUI_Invalidate(ctrl);
+    SDLUI_Core.layout_generation++;
+}
+
+void SDLUI_BuildHitGrid(SDLUI_Control_Window* wnd)
+{
+    SDLUI_HitGrid* grid = &wnd->hit_grid;
+    grid->cols = wnd->w / SDLUI_HIT_CELL_SIZE + 1;
+    grid->rows = wnd->h / SDLUI_HIT_CELL_SIZE + 1;
+    grid->num_controls = wnd->children.size;
+    grid->dirty = false;
+
+    i32 num_cells = grid->cols * grid->rows;
+    grid->cell_start = (i32*)realloc(grid->cell_start, (num_cells + 1) * sizeof(i32));
+    memset(grid->cell_start, 0, (num_cells + 1) * sizeof(i32));
+
+    if (wnd->children.size > grid->bounds_capacity)
+    {
+        grid->bounds_capacity = wnd->children.size > grid->bounds_capacity * 2 ? wnd->children.size : grid->bounds_capacity * 2;
+        grid->bounds = (SDL_Rect*)realloc(grid->bounds, grid->bounds_capacity * sizeof(SDL_Rect));
+    }
+
+    SDL_Rect* bounds = grid->bounds;
+    SDL_Rect cells;
+
+    // first pass counts how many controls land in each cell, the second one fills them in.
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (int i = 0; i < wnd->children.size; ++i)
+        {
+            if (pass == 0)
+            {
+                bounds[i] = SDLUI_GetControlBounds(wnd->children.data[i]);
+            }
+
+            cells.x = SDLUI_Clamp(bounds[i].x / SDLUI_HIT_CELL_SIZE, 0, grid->cols - 1);
+            cells.y = SDLUI_Clamp(bounds[i].y / SDLUI_HIT_CELL_SIZE, 0, grid->rows - 1);
+            cells.w = SDLUI_Clamp((bounds[i].x + bounds[i].w) / SDLUI_HIT_CELL_SIZE, 0, grid->cols - 1);
+            cells.h = SDLUI_Clamp((bounds[i].y + bounds[i].h) / SDLUI_HIT_CELL_SIZE, 0, grid->rows - 1);
+
+            for (int cy = cells.y; cy <= cells.h; ++cy)
+            {
+                for (int cx = cells.x; cx <= cells.w; ++cx)
+                {
+                    i32 cell = cy * grid->cols + cx;
+
+                    if (pass == 0)
+                    {
+                        grid->cell_start[cell + 1]++;
+                    }
+                    else
+                    {
+                        grid->entries[grid->cell_start[cell]++] = i;
+                    }
+                }
+            }
+        }
+
+        if (pass == 0)
+        {
+            for (int c = 0; c < num_cells; ++c)
+            {
+                grid->cell_start[c + 1] += grid->cell_start[c];
+            }
+
+            grid->entries = (i32*)realloc(grid->entries, (grid->cell_start[num_cells] + 1) * sizeof(i32));
+        }
+    }
+
+    // filling moved every start to the end of its cell, which is where the next cell starts.
+    for (int c = num_cells; c > 0; --c)
+    {
+        grid->cell_start[c] = grid->cell_start[c - 1];
+    }
+    grid->cell_start[0] = 0;
+}
+
+// Returns the topmost visible child of wnd under the point, or NULL.
+// Tab containers only count when none of the controls in them is hit.
+SDLUI_Control* SDLUI_HitTest(SDLUI_Control_Window* wnd, i32 mx, i32 my)
+{
+    SDLUI_HitGrid* grid = &wnd->hit_grid;
+
+    if (grid->dirty || grid->num_controls != wnd->children.size || grid->cols != wnd->w / SDLUI_HIT_CELL_SIZE + 1 || grid->rows != wnd->h / SDLUI_HIT_CELL_SIZE + 1)
+    {
+        SDLUI_BuildHitGrid(wnd);
+    }
+
+    i32 x = mx - wnd->x;
+    i32 y = my - wnd->y;
+
+    if (x < 0 || y < 0 || x >= wnd->w || y >= wnd->h)
+    {
+        return NULL;
+    }
+
+    i32 cell = (y / SDLUI_HIT_CELL_SIZE) * grid->cols + (x / SDLUI_HIT_CELL_SIZE);
+    SDLUI_Control* container = NULL;
+
+    for (int i = grid->cell_start[cell + 1] - 1; i >= grid->cell_start[cell]; --i)
+    {
+        SDLUI_Control* ctrl = wnd->children.data[grid->entries[i]];
+
+        if (!ctrl->visible || !ctrl->do_process)
+        {
+            continue;
+        }
+
+        SDL_Rect r = SDLUI_GetControlBounds(ctrl);
+
+        if (SDLUI_PointInRect(r, x, y))
+        {
+            if (ctrl->type != SDLUI_CONTROL_TYPE_TAB_CONTAINER)
+            {
+                return ctrl;
+            }
+
+            if (container == NULL)
+            {
+                container = ctrl;
+            }
+        }
+    }
+
+    return container;
+}
+
+// Renders a child drawn by its window. Text is batched until a control is about to draw over some of it,
+// queued is what the text waiting in the batch may cover.
+void SDLUI_RenderWindowChild(SDLUI_Control* ctrl, SDL_Rect* queued)
+{
+    SDL_Rect bounds = SDLUI_GetControlBounds(ctrl);
+
+    if (SDL_HasIntersection(&bounds, queued))
+    {
+        SDLUI_FlushText();
+        *queued = bounds;
+    }
+    else
+    {
+        SDL_UnionRect(queued, &bounds, queued);
+    }
+
+    SDLUI_RenderChild(ctrl->type, ctrl);
+}
+
+void SDLUI_DrawWindow(SDLUI_Control_Window* wnd);
+
+// Redraws only the parts of the window that changed since the last frame. The area a dirty child covers now and
+// covered before is cleared and everything the window draws there is drawn again, so neighbours and containers under
+// it are kept. Children of tab containers are drawn by their container, so a change to one redraws the whole window.
+void SDLUI_RenderDirtyChildren(SDLUI_Control_Window* wnd)
+{
+    SDL_Rect client = { 1, 30, wnd->w - 2, wnd->h - 31 };
+    SDL_Rect bounds, clip;
+    SDLUI_Control* ctrl;
+
+    for (int i = 0; i < wnd->children.size; ++i)
+    {
+        ctrl = wnd->children.data[i];
+
+        if (ctrl->dirty && !ctrl->owned_by_window)
+        {
+            SDLUI_DrawWindow(wnd);
+            return;
+        }
+    }
+
+    for (int i = 0; i < wnd->children.size; ++i)
+    {
+        ctrl = wnd->children.data[i];
+
+        if (!ctrl->dirty)
+        {
+            continue;
+        }
+
+        ctrl->dirty = false;
+        bounds = SDLUI_GetControlBounds(ctrl);
+        SDL_UnionRect(&ctrl->drawn, &bounds, &clip);
+
+        if (SDL_IntersectRect(&clip, &client, &clip))
+        {
+            SDL_RenderSetClipRect(SDLUI_Core.renderer, &clip);
+            SDLUI_SetColor(SDLUI_Core.theme.col_window_bg);
+            SDL_RenderFillRect(SDLUI_Core.renderer, &clip);
+
+            SDL_Rect queued = { 0, 0, 0, 0 };
+
+            for (int j = 0; j < wnd->children.size; ++j)
+            {
+                SDLUI_Control* other = wnd->children.data[j];
+
+                if (other->owned_by_window && other->visible && other->do_process)
+                {
+                    SDL_Rect other_bounds = SDLUI_GetControlBounds(other);
+
+                    if (SDL_HasIntersection(&other_bounds, &clip))
+                    {
+                        SDLUI_RenderWindowChild(other, &queued);
+                    }
+                }
+            }
+
+            SDLUI_FlushText();
+            SDL_RenderSetClipRect(SDLUI_Core.renderer, NULL);
+        }
+
+        ctrl->drawn = ctrl->visible && ctrl->do_process ? bounds : SDL_Rect{ 0, 0, 0, 0 };
+    }
+}
+
+// Draws the whole window, title bar and all its children, into the current target.
+void SDLUI_DrawWindow(SDLUI_Control_Window* wnd)
+{
+    SDLUI_SetColor(wnd->active ? SDLUI_Core.theme.col_active_window_bar : SDLUI_Core.theme.col_inactive_window_bar);
+    SDL_Rect r = { 0, 0, wnd->w, 30 };
+    SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+    SDLUI_DrawText(SDLUI_MARGIN, SDLUI_MARGIN, wnd->title.data, wnd->tex_rect);
+
+    SDLUI_SetColor(SDLUI_Core.theme.col_window_bg);
+    r = { 0, 0 + 30, wnd->w, wnd->h - 30 };
+    SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+    if (wnd->has_close_button)
+    {
+        if (wnd->close_hovered)
+        {
+            SDLUI_SetColor(SDLUI_Core.theme.col_red);
+            r = { wnd->w - 29, 1, 28, 28 };
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+        }
+
+        r = { 0 + wnd->w - 30, 0, 30, 30 };
+        SDLUI_DrawIcon(SDLUI_ICON_CLOSE, &r, SDLUI_Core.theme.col_white);
+    }
+
+    SDLUI_Control* ctrl;
+    SDL_Rect queued = { 0, 0, 0, 0 };
+
+    for (int j = 0; j < wnd->children.size; ++j)
+    {
+        ctrl = wnd->children.data[j];
+
+        if (ctrl->owned_by_window && ctrl->do_process)
+        {
+            if (ctrl->x < wnd->w && ctrl->y < wnd->h)
+            {
+                SDLUI_RenderWindowChild(ctrl, &queued);
+            }
+        }
+    }
+
+    SDLUI_FlushText();
+
+    SDLUI_SetColor(SDLUI_Core.theme.col_grey);
+    r = { 0, 0, wnd->w, wnd->h };
+    SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+
+    for (int j = 0; j < wnd->children.size; ++j)
+    {
+        ctrl = wnd->children.data[j];
+        ctrl->dirty = false;
+        ctrl->drawn = ctrl->visible && ctrl->do_process ? SDLUI_GetControlBounds(ctrl) : SDL_Rect{ 0, 0, 0, 0 };
+    }
+
+    wnd->dirty = false;
+}
+
+void SDLUI_Render_Window(SDLUI_Control_Window* wnd)
+{
+    if (!wnd->do_process)
+    {
+        return;
+    }
+
+    if (wnd->visible != wnd->visible_last_frame)
+    {
+        for (int i = 0; i < wnd->children.size; ++i)
+        {
+            wnd->children.data[i]->visible = wnd->visible;
+            wnd->visible_last_frame = wnd->visible;
+        }
+
+        wnd->dirty = true;
+    }
+
+    if (wnd->enabled != wnd->enabled_last_frame)
+    {
+        for (int i = 0; i < wnd->children.size; ++i)
+        {
+            wnd->children.data[i]->enabled = wnd->enabled;
+            wnd->enabled_last_frame = wnd->enabled;
+        }
+
+    }
+
+    if (wnd->visible)
+    {
+        bool active = wnd == SDLUI_Core.active_window;
+        bool close_hovered = false;
+
+        if (active && wnd->has_close_button && !wnd->is_resized)
+        {
+            i32 mx = SDLUI_Input.mouse_x;
+            i32 my = SDLUI_Input.mouse_y;
+            SDL_Rect r = { wnd->x + wnd->w - 30, wnd->y, 30, 30 };
+            close_hovered = SDLUI_PointInRect(r, mx, my);
+        }
+
+        if (active != wnd->active || close_hovered != wnd->close_hovered)
+        {
+            wnd->active = active;
+            wnd->close_hovered = close_hovered;
+            wnd->dirty = true;
+        }
+
+        if (wnd->tex_rect == NULL)
+        {
+            // the backbuffer doesn't keep last frame's window around, so direct mode draws all of it every frame.
+            SDL_Rect viewport = { wnd->x, wnd->y, wnd->w, wnd->h };
+            SDL_Rect clip = { 0, 0, wnd->w, wnd->h };
+            SDL_RenderSetViewport(SDLUI_Core.renderer, &viewport);
+            SDL_RenderSetClipRect(SDLUI_Core.renderer, &clip);
+
+            SDLUI_DrawWindow(wnd);
+
+            SDL_RenderSetClipRect(SDLUI_Core.renderer, NULL);
+            SDL_RenderSetViewport(SDLUI_Core.renderer, NULL);
+            return;
+        }
+
+        SDL_SetRenderTarget(SDLUI_Core.renderer, wnd->tex_rect);
+
+        if (wnd->dirty)
+        {
+            SDLUI_DrawWindow(wnd);
+        }
+        else
+        {
+            SDLUI_RenderDirtyChildren(wnd);
+        }
+
+        SDL_Rect src = { 0, 0, wnd->w, wnd->h };
+        SDL_Rect r = { wnd->x, wnd->y, wnd->w, wnd->h };
+        SDL_SetRenderTarget(SDLUI_Core.renderer, NULL);
+        SDL_RenderCopy(SDLUI_Core.renderer, wnd->tex_rect, &src, &r);
+    }
+}
+
+// Makes every window redraw itself completely the next time it is rendered.
+void SDLUI_ForceReDraw()
+{
+    for (int i = 0; i < SDLUI_Window_Collection.size; ++i)
+    {
+        SDLUI_Window_Collection.data[i]->dirty = true;
+    }
+}
+
+// Textures gives every window a render target of its own and only redraws the controls that changed.
+// Direct draws each window straight to the screen every frame, clipped to the window, which saves
+// a window-sized texture per window and a target switch per window each frame.
+void SDLUI_SetCompositor(SDLUI_COMPOSITOR compositor)
+{
+    if (compositor == SDLUI_Core.compositor)
+    {
+        return;
+    }
+
+    SDLUI_FlushText();
+    SDLUI_Core.compositor = compositor;
+
+    for (int i = 0; i < SDLUI_Window_Collection.size; ++i)
+    {
+        SDLUI_Control_Window* wnd = (SDLUI_Control_Window*)SDLUI_Window_Collection.data[i];
+
+        if (compositor == SDLUI_COMPOSITOR_DIRECT)
+        {
+            SDLUI_ReleaseTarget(wnd->tex_rect);
+            wnd->tex_rect = NULL;
+        }
+        else
+        {
+            wnd->tex_rect = SDLUI_AcquireTarget(wnd->w, wnd->h);
+        }
+
+        wnd->dirty = true;
+    }
+}
+
+void SDLUI_Render()
+{
+    SDLUI_Control_Window* wnd;
+
+    // lists and text boxes queue their text up during the frame, it has to land before the windows are drawn.
+    SDLUI_FlushText();
+
+    for (int i = 0; i < SDLUI_Window_Collection.size; ++i)
+    {
+        wnd = (SDLUI_Control_Window*)SDLUI_Window_Collection.data[i];
+        SDLUI_Render_Window(wnd);
+
+        // nothing queued by one window may land on top of the windows drawn after it.
+        SDLUI_FlushText();
+    }
+
+    SDLUI_InputReset();
+}
+
+SDLUI_Control_Window* SDLUI_CreateWindow(i32 x, i32 y, i32 w, i32 h, char* title)
+{
+    SDLUI_Control_Window* wnd = (SDLUI_Control_Window*)malloc(sizeof(SDLUI_Control_Window));
+
+    wnd->type = SDLUI_CONTROL_TYPE_WINDOW;
+    wnd->parent = NULL;
+    wnd->title.create(title);
+    wnd->id = 0;
+    SDLUI_Core.window_counter++;
+    SDLUI_SetControlID(wnd, SDLUI_HashID(&SDLUI_Core.window_counter, sizeof(SDLUI_Core.window_counter), SDLUI_GetID(title)));
+    wnd->resize_direction = SDLUI_RESIZE_NONE;
+    wnd->x = x;
+    wnd->y = y;
+    wnd->drag_x = 0;
+    wnd->drag_y = 0;
+    wnd->w = w;
+    wnd->h = h;
+    wnd->visible = true;
+    wnd->enabled = true;
+    wnd->is_resized = false;
+    wnd->do_process = false;
+    wnd->dirty = true;
+    wnd->drawn = { 0, 0, 0, 0 };
+    wnd->layout_generation = 0;
+    wnd->layout_item = NULL;
+    wnd->has_close_button = true;
+    wnd->can_be_resized = true;
+    wnd->active = false;
+    wnd->close_hovered = false;
+    wnd->hit_grid = { 0, 0, NULL, NULL, 0, true, NULL, 0 };
+    wnd->arena.create();
+    wnd->root_layout = NULL;
+
+    wnd->tex_rect = SDLUI_Core.compositor == SDLUI_COMPOSITOR_TEXTURES ? SDLUI_AcquireTarget(w, h) : NULL;
+
+    wnd->children.create();
+    SDLUI_Window_Collection.push(wnd);
+
+    return wnd;
+}
+
+SDLUI_Control_Button* SDLUI_CreateButton(SDLUI_Control_Window* wnd, i32 x, i32 y, char* text)
+{
+    SDLUI_Control_Button* btn = (SDLUI_Control_Button*)wnd->arena.alloc(sizeof(SDLUI_Control_Button));
+
+    btn->type = SDLUI_CONTROL_TYPE_BUTTON;
+    btn->do_process = false;
+    btn->dirty = true;
+    btn->drawn = { 0, 0, 0, 0 };
+    btn->layout_generation = 0;
+    btn->layout_item = NULL;
+    btn->id = 0;
+    SDLUI_SetControlID(btn, SDLUI_NextChildID(wnd));
+    btn->text.create(text);
+    btn->x = x;
+    btn->y = y;
+    btn->w = 100;
+    btn->h = 30;
+    btn->visible = true;
+    btn->enabled = true;
+    btn->owned_by_window = true;
+    btn->align = SDLUI_ALIGN_CENTER;
+    btn->state = SDLUI_BUTTON_STATE_NORMAL;
+    btn->parent = wnd;
+
+    wnd->children.push(btn);
+    return btn;
+}
+
+SDLUI_Control_SliderInt* SDLUI_CreateSliderInt(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 min, i32 max, i32 value, SDLUI_ORIENTATION orientation = SDLUI_ORIENTATION_HORIZONTAL)
+{
+    SDLUI_Control_SliderInt* si = (SDLUI_Control_SliderInt*)wnd->arena.alloc(sizeof(SDLUI_Control_SliderInt));
+
+    si->type = SDLUI_CONTROL_TYPE_SLIDER_INT;
+    si->do_process = false;
+    si->dirty = true;
+    si->drawn = { 0, 0, 0, 0 };
+    si->layout_generation = 0;
+    si->layout_item = NULL;
+    si->id = 0;
+    SDLUI_SetControlID(si, SDLUI_NextChildID(wnd));
+    si->x = x;
+    si->y = y;
+    si->visible = true;
+    si->enabled = true;
+    si->owned_by_window = true;
+    si->min = min;
+    si->max = max;
+    si->value = value;
+    si->thumb_size = 12;
+    si->is_changing = false;
+    si->orientation = orientation;
+    si->parent = wnd;
+
+    if (si->orientation == SDLUI_ORIENTATION_HORIZONTAL)
+    {
+        si->w = 100;
+        si->h = 16;
+    }
+    else
+    {
+        si->w = 16;
+        si->h = 100;
+    }
+
+    wnd->children.push(si);
+    return si;
+}
+
+SDLUI_Control_CheckBox* SDLUI_CreateCheckBox(SDLUI_Control_Window* wnd, i32 x, i32 y, char* text, bool checked)
+{
+    SDLUI_Control_CheckBox* chk = (SDLUI_Control_CheckBox*)wnd->arena.alloc(sizeof(SDLUI_Control_CheckBox));
+
+    chk->type = SDLUI_CONTROL_TYPE_CHECKBOX;
+    chk->do_process = false;
+    chk->dirty = true;
+    chk->drawn = { 0, 0, 0, 0 };
+    chk->layout_generation = 0;
+    chk->layout_item = NULL;
+    chk->id = 0;
+    SDLUI_SetControlID(chk, SDLUI_NextChildID(wnd));
+    chk->x = x;
+    chk->y = y;
+    chk->w = 16;
+    chk->h = 16;
+    chk->visible = true;
+    chk->enabled = true;
+    chk->owned_by_window = true;
+    chk->checked = checked;
+    chk->parent = wnd;
+
+    chk->text.create(text);
+
+    wnd->children.push(chk);
+    return chk;
+}
+
+SDLUI_Control_Text* SDLUI_CreateText(SDLUI_Control_Window* wnd, i32 x, i32 y, char* text)
+{
+    SDLUI_Control_Text* txt = (SDLUI_Control_Text*)wnd->arena.alloc(sizeof(SDLUI_Control_Text));
+
+    txt->type = SDLUI_CONTROL_TYPE_TEXT;
+    txt->do_process = false;
+    txt->dirty = true;
+    txt->drawn = { 0, 0, 0, 0 };
+    txt->layout_generation = 0;
+    txt->layout_item = NULL;
+    txt->id = 0;
+    SDLUI_SetControlID(txt, SDLUI_NextChildID(wnd));
+    txt->text.create(text);
+    txt->x = x;
+    txt->y = y;
+    txt->w = SDLUI_MeasureText(txt->text.data);
+    txt->h = SDLUI_Font.height;
+    txt->visible = true;
+    txt->enabled = true;
+    txt->owned_by_window = true;
+    txt->parent = wnd;
+
+    wnd->children.push(txt);
+    return txt;
+}
+
+SDLUI_Control_ToggleButton* SDLUI_CreateToggleButton(SDLUI_Control_Window* wnd, i32 x, i32 y, char* text, bool checked)
+{
+    SDLUI_Control_ToggleButton* tb = (SDLUI_Control_ToggleButton*)wnd->arena.alloc(sizeof(SDLUI_Control_ToggleButton));
+
+    tb->type = SDLUI_CONTROL_TYPE_TOGGLE_BUTTON;
+    tb->do_process = false;
+    tb->dirty = true;
+    tb->drawn = { 0, 0, 0, 0 };
+    tb->layout_generation = 0;
+    tb->layout_item = NULL;
+    tb->id = 0;
+    SDLUI_SetControlID(tb, SDLUI_NextChildID(wnd));
+    tb->x = x;
+    tb->y = y;
+    tb->w = 32;
+    tb->h = 16;
+    tb->visible = true;
+    tb->enabled = true;
+    tb->owned_by_window = true;
+    tb->checked = checked;
+    tb->parent = wnd;
+
+    tb->text.create(text);
+
+    wnd->children.push(tb);
+
+    return tb;
+}
+
+SDLUI_ArrayOfControls SDLUI_CreateRadioButtonGroup()
+{
+    SDLUI_ArrayOfControls rb_group;
+    rb_group.create();
+    return rb_group;
+}
+
+SDLUI_Control_RadioButton* SDLUI_CreateRadioButton(SDLUI_Control_Window* wnd, SDLUI_ArrayOfControls& group, i32 x, i32 y, char* text, bool checked)
+{
+    SDLUI_Control_RadioButton* rb = (SDLUI_Control_RadioButton*)wnd->arena.alloc(sizeof(SDLUI_Control_RadioButton));
+
+    rb->type = SDLUI_CONTROL_TYPE_RADIO_BUTTON;
+    rb->do_process = false;
+    rb->dirty = true;
+    rb->drawn = { 0, 0, 0, 0 };
+    rb->layout_generation = 0;
+    rb->layout_item = NULL;
+    rb->id = 0;
+    SDLUI_SetControlID(rb, SDLUI_NextChildID(wnd));
+    rb->x = x;
+    rb->y = y;
+    rb->w = 16;
+    rb->h = 16;
+    rb->visible = true;
+    rb->enabled = true;
+    rb->owned_by_window = true;
+    rb->checked = checked;
+    rb->group = &group;
+    rb->group->push(rb);
+    rb->parent = wnd;
+
+    rb->text.create(text);
+
+    wnd->children.push(rb);
+
+    return rb;
+}
+
+SDLUI_Control_TabContainer* SDLUI_CreateTabContainer(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 w, i32 h)
+{
+    SDLUI_Control_TabContainer* tbc = (SDLUI_Control_TabContainer*)wnd->arena.alloc(sizeof(SDLUI_Control_TabContainer));
+
+    tbc->type = SDLUI_CONTROL_TYPE_TAB_CONTAINER;
+    tbc->do_process = false;
+    tbc->dirty = true;
+    tbc->drawn = { 0, 0, 0, 0 };
+    tbc->layout_generation = 0;
+    tbc->layout_item = NULL;
+    tbc->id = 0;
+    SDLUI_SetControlID(tbc, SDLUI_NextChildID(wnd));
+    tbc->tabs.create();
+    tbc->x = x;
+    tbc->y = y;
+    tbc->w = w;
+    tbc->h = h;
+    tbc->visible = true;
+    tbc->enabled = true;
+    tbc->owned_by_window = true;
+    tbc->bar_height = 30;
+    tbc->active_tab = NULL;
+    tbc->parent = wnd;
+
+    wnd->children.push(tbc);
+    return tbc;
+
+}
+
+SDLUI_Control_ScrollArea* SDLUI_CreateScrollArea(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 w, i32 h, SDL_Texture* tex)
+{
+    SDLUI_Control_ScrollArea* sa = (SDLUI_Control_ScrollArea*)wnd->arena.alloc(sizeof(SDLUI_Control_ScrollArea));
+
+    sa->type = SDLUI_CONTROL_TYPE_SCROLL_AREA;
+    sa->do_process = false;
+    sa->dirty = true;
+    sa->drawn = { 0, 0, 0, 0 };
+    sa->layout_generation = 0;
+    sa->layout_item = NULL;
+    sa->id = 0;
+    SDLUI_SetControlID(sa, SDLUI_NextChildID(wnd));
+    sa->x = x;
+    sa->y = y;
+    sa->w = w;
+    sa->h = h;
+    sa->visible = true;
+    sa->enabled = true;
+    sa->owned_by_window = true;
+    sa->scrollbar_thickness = 12;
+    sa->track_size_h = sa->w - sa->scrollbar_thickness;
+    sa->track_size_v = sa->h - sa->scrollbar_thickness;
+    sa->scroll_x = 0;
+    sa->scroll_y = 0;
+    sa->is_changing_v = false;
+    sa->is_changing_h = false;
+    sa->tex_rect = tex;
+    sa->content_width = 0;
+    sa->content_height = 0;
+
+    if (tex != NULL)
+    {
+        SDL_QueryTexture(tex, NULL, NULL, &sa->content_width, &sa->content_height);
+    }
+
+    SDLUI_UpdateScrollAreaClient(sa);
+
+    sa->parent = wnd;
+
+    wnd->children.push(sa);
+    return sa;
+}
+
+SDLUI_Control_List* SDLUI_CreateList(SDLUI_Control_Window* wnd, SDLUI_Control_ScrollArea* sa, i32 num_items)
+{
+    SDLUI_Control_List* lst = (SDLUI_Control_List*)wnd->arena.alloc(sizeof(SDLUI_Control_List));
+
+    lst->type = SDLUI_CONTROL_TYPE_LIST;
+    lst->do_process = false;
+    lst->dirty = true;
+    lst->drawn = { 0, 0, 0, 0 };
+    lst->layout_generation = 0;
+    lst->layout_item = NULL;
+    lst->id = SDLUI_GetID("list", sa->id);
+    lst->scroll_area = sa;
+    lst->num_items = num_items;
+    lst->selected_index = 0;
+    lst->max_string_width = 0;
+
+    i32 h = num_items * SDLUI_Font.height;
+    if (h < sa->h)
+    {
+        h = sa->h;
+    }
+    sa->tex_rect = SDLUI_AcquireTarget(sa->w, h);
+    sa->content_width = sa->w;
+    sa->content_height = h;
+
+    SDLUI_UpdateScrollAreaClient(sa);
+
+    return lst;
+}
+
+// A list that asks get_item only for the rows that are visible, so it can hold any number of items.
+SDLUI_Control_VirtualList* SDLUI_CreateVirtualList(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 w, i32 h, i32 num_items, SDLUI_ListItemProvider get_item, void* user_data = NULL)
+{
+    SDLUI_Control_VirtualList* vl = (SDLUI_Control_VirtualList*)wnd->arena.alloc(sizeof(SDLUI_Control_VirtualList));
+
+    vl->type = SDLUI_CONTROL_TYPE_VIRTUAL_LIST;
+    vl->do_process = false;
+    vl->dirty = true;
+    vl->drawn = { 0, 0, 0, 0 };
+    vl->layout_generation = 0;
+    vl->layout_item = NULL;
+    vl->id = 0;
+    SDLUI_SetControlID(vl, SDLUI_NextChildID(wnd));
+    vl->x = x;
+    vl->y = y;
+    vl->w = w;
+    vl->h = h;
+    vl->visible = true;
+    vl->enabled = true;
+    vl->owned_by_window = true;
+    vl->num_items = num_items;
+    vl->selected_index = -1;
+    vl->item_height = SDLUI_Font.height;
+    vl->scroll_y = 0;
+    vl->scrollbar_thickness = 12;
+    vl->drag_offset = 0;
+    vl->is_dragging = false;
+    vl->get_item = get_item;
+    vl->user_data = user_data;
+    vl->parent = wnd;
+
+    wnd->children.push(vl);
+    return vl;
+}
+
+SDLUI_Control_TextBox* SDLUI_CreateTextBox(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 w)
+{
+    SDLUI_Control_TextBox* tbx = (SDLUI_Control_TextBox*)wnd->arena.alloc(sizeof(SDLUI_Control_TextBox));
+
+    tbx->do_process = false;
+
+    tbx->type = SDLUI_CONTROL_TYPE_TEXTBOX;
+    tbx->do_process = false;
+    tbx->dirty = true;
+    tbx->drawn = { 0, 0, 0, 0 };
+    tbx->layout_generation = 0;
+    tbx->layout_item = NULL;
+    tbx->id = 0;
+    SDLUI_SetControlID(tbx, SDLUI_NextChildID(wnd));
+    tbx->x = x;
+    tbx->y = y;
+    tbx->w = w;
+    tbx->h = 30;
+    tbx->visible = true;
+    tbx->enabled = true;
+    tbx->owned_by_window = true;
+    tbx->text.create("");
+    tbx->select_start = 0;
+    tbx->select_end = 0;
+    tbx->cursor_pos = 0;
+    tbx->focused = false;
+    tbx->scroll = 0;
+
+    tbx->tex_text = SDLUI_AcquireTarget(SDLUI_Max(1, w - (2 * SDLUI_MARGIN)), SDLUI_Font.height);
+
+    tbx->parent = wnd;
+    wnd->children.push(tbx);
+
+    return tbx;
+}
+
+SDLUI_Control_TextEditor* SDLUI_CreateTextEditor(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 w, i32 h)
+{
+    SDLUI_Control_TextEditor* ed = (SDLUI_Control_TextEditor*)wnd->arena.alloc(sizeof(SDLUI_Control_TextEditor));
+
+    ed->type = SDLUI_CONTROL_TYPE_TEXT_EDITOR;
+    ed->do_process = false;
+    ed->dirty = true;
+    ed->drawn = { 0, 0, 0, 0 };
+    ed->layout_generation = 0;
+    ed->layout_item = NULL;
+    ed->id = 0;
+    SDLUI_SetControlID(ed, SDLUI_NextChildID(wnd));
+    ed->x = x;
+    ed->y = y;
+    ed->w = w;
+    ed->h = h;
+    ed->visible = true;
+    ed->enabled = true;
+    ed->owned_by_window = true;
+    ed->buffer.create();
+    ed->lines.create();
+    ed->cursor = 0;
+    ed->anchor = 0;
+    ed->cursor_x = 0;
+    ed->preferred_x = 0;
+    ed->first_line = 0;
+    ed->scroll_x = 0;
+    ed->line_height = SDLUI_Font.height;
+    ed->scrollbar_thickness = 12;
+    ed->drag_offset = 0;
+    ed->is_dragging = false;
+    ed->is_selecting = false;
+    ed->focused = false;
+    ed->dirty_first = 0;
+    ed->dirty_last = SDLUI_LAST_LINE;
+    ed->undo = NULL;
+    ed->num_undo = 0;
+    ed->undo_pos = 0;
+    ed->undo_capacity = 0;
+    ed->undo_text = NULL;
+    ed->undo_text_length = 0;
+    ed->undo_text_capacity = 0;
+    ed->undo_group = 0;
+    ed->last_edit = SDLUI_EDIT_KIND_NONE;
+    ed->scratch = NULL;
+    ed->scratch_capacity = 0;
+
+    ed->tex_text = SDLUI_AcquireTarget(ed->text_width(), ed->text_height());
+
+    ed->parent = wnd;
+    wnd->children.push(ed);
+
+    return ed;
+}
+
+SDLUI_Control_Console* SDLUI_CreateConsole(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 w, i32 h)
+{
+    SDLUI_Control_Console* con = (SDLUI_Control_Console*)wnd->arena.alloc(sizeof(SDLUI_Control_Console));
+
+    con->type = SDLUI_CONTROL_TYPE_CONSOLE;
+    con->do_process = false;
+    con->dirty = true;
+    con->drawn = { 0, 0, 0, 0 };
+    con->layout_generation = 0;
+    con->layout_item = NULL;
+    con->id = 0;
+    SDLUI_SetControlID(con, SDLUI_NextChildID(wnd));
+    con->x = x;
+    con->y = y;
+    con->w = w;
+    con->h = h;
+    con->visible = true;
+    con->enabled = true;
+    con->owned_by_window = true;
+    con->scanned = 0;
+    con->match_start = 0;
+    con->num_matches = 0;
+    con->filter[0] = '\0';
+    con->item_height = SDLUI_Font.height;
+    con->scroll_y = 0;
+    con->scrollbar_thickness = 12;
+    con->drag_offset = 0;
+    con->is_dragging = false;
+    con->follow = true;
+    con->parent = wnd;
+
+    wnd->children.push(con);
+    return con;
+}
+
+SDLUI_Control_Plot* SDLUI_CreatePlot(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 w, i32 h, i32 capacity, SDLUI_PLOT_TYPE plot_type = SDLUI_PLOT_TYPE_LINE)
+{
+    SDLUI_Control_Plot* plot = (SDLUI_Control_Plot*)wnd->arena.alloc(sizeof(SDLUI_Control_Plot));
+
+    plot->type = SDLUI_CONTROL_TYPE_PLOT;
+    plot->do_process = false;
+    plot->dirty = true;
+    plot->drawn = { 0, 0, 0, 0 };
+    plot->layout_generation = 0;
+    plot->layout_item = NULL;
+    plot->id = 0;
+    SDLUI_SetControlID(plot, SDLUI_NextChildID(wnd));
+    plot->x = x;
+    plot->y = y;
+    plot->w = w;
+    plot->h = h;
+    plot->visible = true;
+    plot->enabled = true;
+    plot->owned_by_window = true;
+    plot->plot_type = plot_type;
+    plot->capacity = capacity > 0 ? capacity : 1;
+    plot->samples = (float*)malloc(plot->capacity * sizeof(float));
+    plot->count = 0;
+    plot->head = 0;
+    plot->min = 0.0f;
+    plot->max = 0.0f;
+    plot->color = SDLUI_Core.theme.col_highlight;
+    plot->vertices = NULL;
+    plot->indices = NULL;
+    plot->num_vertices = 0;
+    plot->num_indices = 0;
+    plot->vertex_capacity = 0;
+    plot->index_capacity = 0;
+    plot->geometry_x = x;
+    plot->geometry_y = y;
+    plot->drawn_min = 0.0f;
+    plot->drawn_max = 0.0f;
+    plot->geometry_dirty = true;
+    plot->parent = wnd;
+
+    wnd->children.push(plot);
+    return plot;
+}
+
+SDLUI_Control_Inspector* SDLUI_CreateInspector(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 w, i32 h)
+{
+    SDLUI_Control_Inspector* insp = (SDLUI_Control_Inspector*)wnd->arena.alloc(sizeof(SDLUI_Control_Inspector));
+
+    insp->type = SDLUI_CONTROL_TYPE_INSPECTOR;
+    insp->do_process = false;
+    insp->dirty = true;
+    insp->drawn = { 0, 0, 0, 0 };
+    insp->layout_generation = 0;
+    insp->layout_item = NULL;
+    insp->id = 0;
+    SDLUI_SetControlID(insp, SDLUI_NextChildID(wnd));
+    insp->x = x;
+    insp->y = y;
+    insp->w = w;
+    insp->h = h;
+    insp->visible = true;
+    insp->enabled = true;
+    insp->owned_by_window = true;
+    insp->fields = NULL;
+    insp->text = NULL;
+    insp->num_fields = 0;
+    insp->capacity = 0;
+    insp->item_height = SDLUI_Font.height;
+    insp->value_x = SDLUI_MARGIN;
+    insp->parent = wnd;
+
+    wnd->children.push(insp);
+    return insp;
+}
+
+// Frees a window and everything created in it. The controls all live in the window's arena,
+// so they go away in one release instead of one free each.
+void SDLUI_DestroyWindow(SDLUI_Control_Window* wnd)
+{
+    SDLUI_FlushText();
+
+    for (int i = 0; i < wnd->children.size; ++i)
+    {
+        SDLUI_Control* ctrl = wnd->children.data[i];
+
+        if (SDLUI_FindControl(ctrl->id) == ctrl)
+        {
+            SDLUI_ControlMap.remove(ctrl->id);
+        }
+        SDLUI_FreeState(ctrl->id);
+
+        switch (ctrl->type)
+        {
+        case SDLUI_CONTROL_TYPE_BUTTON:
+            ((SDLUI_Control_Button*)ctrl)->text.destroy();
+            break;
+
+        case SDLUI_CONTROL_TYPE_CHECKBOX:
+            ((SDLUI_Control_CheckBox*)ctrl)->text.destroy();
+            break;
+
+        case SDLUI_CONTROL_TYPE_TOGGLE_BUTTON:
+            ((SDLUI_Control_ToggleButton*)ctrl)->text.destroy();
+            break;
+
+        case SDLUI_CONTROL_TYPE_TEXT:
+            ((SDLUI_Control_Text*)ctrl)->text.destroy();
+            break;
+
+        case SDLUI_CONTROL_TYPE_RADIO_BUTTON:
+        {
+            SDLUI_Control_RadioButton* rb = (SDLUI_Control_RadioButton*)ctrl;
+            rb->group->pop(rb);
+            rb->text.destroy();
+            break;
+        }
+
+        case SDLUI_CONTROL_TYPE_TAB_CONTAINER:
+        {
+            SDLUI_Control_TabContainer* tbc = (SDLUI_Control_TabContainer*)ctrl;
+            for (int j = 0; j < tbc->tabs.size; ++j)
+            {
+                SDLUI_Control_Tab* tab = (SDLUI_Control_Tab*)tbc->tabs.data[j];
+                tab->text.destroy();
+                tab->children.destroy();
+            }
+            tbc->tabs.destroy();
+            break;
+        }
+
+        case SDLUI_CONTROL_TYPE_SCROLL_AREA:
+        {
+            // textures handed in by the user stay theirs, only the ones a list took from the pool go back.
+            SDLUI_Control_ScrollArea* sa = (SDLUI_Control_ScrollArea*)ctrl;
+            SDLUI_FreeState(SDLUI_GetID("list", sa->id));
+            if (sa->tex_rect != NULL && SDLUI_TargetPool.find(sa->tex_rect) != NULL)
+            {
+                SDLUI_ReleaseTarget(sa->tex_rect);
+            }
+            break;
+        }
+
+        case SDLUI_CONTROL_TYPE_TEXTBOX:
+        {
+            SDLUI_Control_TextBox* tbx = (SDLUI_Control_TextBox*)ctrl;
+            tbx->text.destroy();
+            SDLUI_ReleaseTarget(tbx->tex_text);
+            break;
+        }
+
+        case SDLUI_CONTROL_TYPE_PLOT:
+        {
+            SDLUI_Control_Plot* plot = (SDLUI_Control_Plot*)ctrl;
+            free(plot->samples);
+            free(plot->vertices);
+            free(plot->indices);
+            break;
+        }
+
+        case SDLUI_CONTROL_TYPE_INSPECTOR:
+        {
+            SDLUI_Control_Inspector* insp = (SDLUI_Control_Inspector*)ctrl;
+            free(insp->fields);
+            free(insp->text);
+            break;
+        }
+
+        case SDLUI_CONTROL_TYPE_TEXT_EDITOR:
+        {
+            SDLUI_Control_TextEditor* ed = (SDLUI_Control_TextEditor*)ctrl;
+            ed->buffer.destroy();
+            ed->lines.destroy();
+            free(ed->undo);
+            free(ed->undo_text);
+            free(ed->scratch);
+            SDLUI_ReleaseTarget(ed->tex_text);
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    if (SDLUI_Core.active_window == wnd)
+    {
+        SDLUI_Core.active_window = NULL;
+    }
+    if (SDLUI_Core.hot_control != NULL && (SDLUI_Core.hot_control == wnd || SDLUI_Core.hot_control->parent == wnd))
+    {
+        SDLUI_Core.hot_control = NULL;
+    }
+
+    SDLUI_Window_Collection.pop(wnd);
+    if (SDLUI_FindControl(wnd->id) == wnd)
+    {
+        SDLUI_ControlMap.remove(wnd->id);
+    }
+    SDLUI_FreeState(wnd->id);
+    if (wnd->tex_rect != NULL)
+    {
+        SDLUI_ReleaseTarget(wnd->tex_rect);
+    }
+
+    free(wnd->hit_grid.cell_start);
+    free(wnd->hit_grid.entries);
+    free(wnd->hit_grid.bounds);
+    wnd->title.destroy();
+    wnd->children.destroy();
+    wnd->arena.release();
+    free(wnd);
+}
+
+void SDLUI_EventHandler(SDL_Event const& ev)
+{
+    switch (ev.type)
+    {
+    case SDL_MOUSEMOTION:
+        SDLUI_Input.mouse_x = ev.motion.x;
+        SDLUI_Input.mouse_y = ev.motion.y;
+        break;
+
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        SDLUI_Input.mouse_x = ev.button.x;
+        SDLUI_Input.mouse_y = ev.button.y;
+
+        if (ev.button.button < 6)
+        {
+            bool down = ev.type == SDL_MOUSEBUTTONDOWN;
+            SDLUI_Input.mouse_down[ev.button.button] = down;
+            SDLUI_Input.mouse_pressed[ev.button.button] |= down;
+            SDLUI_Input.mouse_released[ev.button.button] |= !down;
+        }
+        break;
+
+    case SDL_MOUSEWHEEL:
+        SDLUI_Input.wheel_x += ev.wheel.x;
+        SDLUI_Input.wheel_y += ev.wheel.y;
+        break;
+
+    case SDL_WINDOWEVENT:
+        if (ev.window.event == SDL_WINDOWEVENT_RESIZED)
+        {
+            SDLUI_ForceReDraw();
+        }
+        break;
+
+    case SDL_KEYDOWN:
+    case SDL_TEXTINPUT:
+        if (SDLUI_Input.num_events < SDLUI_MAX_INPUT_EVENTS)
+        {
+            SDLUI_Input.events[SDLUI_Input.num_events++] = ev;
+        }
+        break;
+    }
+}
+
+bool SDLUI_Window(SDLUI_Control_Window* wnd)
+{
+    if (!wnd->visible)
+    {
+        return false;
+    }
+
+    wnd->do_process = true;
+    SDLUI_UpdateLayout(wnd);
+
+    if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_RELEASED || SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_NONE)
+    {
+        wnd->is_dragged = false;
+    }
+
+    if (wnd == SDLUI_Core.active_window)
+    {
+        i32 mx = SDLUI_Input.mouse_x;
+        i32 my = SDLUI_Input.mouse_y;
+
+        SDL_Rect r = { wnd->x, wnd->y, wnd->w, wnd->h };
+
+        if (SDLUI_PointInRect(r, mx, my))
+        {
+            wnd->is_hovered = true;
+        }
+        else
+        {
+            wnd->is_hovered = false;
+        }
+
+        SDLUI_Core.hot_control = wnd->is_hovered ? SDLUI_HitTest(wnd, mx, my) : NULL;
+
+        if (wnd->has_close_button)
+        {
+            r = { wnd->x + wnd->w - 30, wnd->y, 30, 30 };
+
+            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED && SDLUI_PointInRect(r, mx, my))
+            {
+                wnd->visible = false;
+                SDLUI_Core.active_window = NULL;
+            }
+        }
+
+        r = { wnd->x,wnd->y,wnd->w - (wnd->has_close_button * 30), 30 };
+
+        if (SDLUI_PointInRect(r, mx, my))
+        {
+            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED && !wnd->is_dragged)
+            {
+                wnd->is_dragged = true;
+                wnd->drag_x = mx - wnd->x;
+                wnd->drag_y = my - wnd->y;
+            }
+        }
+
+        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD && wnd->is_dragged)
+        {
+            SDL_SetCursor(SDLUI_Core.cursor_arrow);
+
+            // children are placed relative to the window, so moving it is all there is to do.
+            if (wnd->x != mx - wnd->drag_x || wnd->y != my - wnd->drag_y)
+            {
+                wnd->x = mx - wnd->drag_x;
+                wnd->y = my - wnd->drag_y;
+                SDLUI_Core.layout_generation++;
+            }
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+bool SDLUI_Button(SDLUI_Control_Button* btn)
+{
+    btn->do_process = true;
+
+    SDLUI_BUTTON_STATE old_state = btn->state;
+    bool clicked = false;
+    btn->state = SDLUI_BUTTON_STATE_NORMAL;
+
+    if (btn->visible && btn->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    {
+        if (SDLUI_Core.hot_control == btn)
+        {
+            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+            {
+                btn->state = SDLUI_BUTTON_STATE_CLICK;
+                clicked = true;
+            }
+            else if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD)
+            {
+                btn->state = SDLUI_BUTTON_STATE_CLICK;
+            }
+            else
+            {
+                btn->state = SDLUI_BUTTON_STATE_HOVER;
+            }
+        }
+    }
 
-        SDLUI_SetColor(SDLUI_Core.theme.col_white);
-        SDL_Rect r = { xx, yy, txt->w, txt->h };
-        SDL_RenderCopy(SDLUI_Core.renderer, txt->tex_text, NULL, &r);
+    if (btn->state != old_state || btn->text.modified)
+    {
+        btn->text.modified = false;
+        btn->dirty = true;
     }
+
+    return clicked;
 }
 
-void SDLUI_Render_ToggleButton(SDLUI_Control_ToggleButton* tb)
+bool SDLUI_SliderInt(SDLUI_Control_SliderInt* si)
 {
-    if (tb->visible)
-    {
-        i32 xx = tb->x - tb->parent->x;
-        i32 yy = tb->y - tb->parent->y;
+    si->do_process = true;
 
-        SDL_Rect r = { xx, yy, tb->w, tb->h };
-        SDLUI_Colorize(SDLUI_Core.tex_circle, SDLUI_Core.theme.col_white);
-        SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_toggle, NULL, &r);
+    if (si->visible && si->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    {
+        i32 mx = SDLUI_Input.mouse_x;
+        i32 my = SDLUI_Input.mouse_y;
+        SDL_Rect sr = SDLUI_GetScreenRect(si);
 
-        if (tb->checked)
+        if (SDLUI_Core.hot_control == si)
         {
-            r = { xx + 16, yy, tb->w - 16, tb->h };
-            SDLUI_Colorize(SDLUI_Core.tex_circle_fill_2, SDLUI_Core.theme.col_highlight);
-            SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_circle_fill_2, NULL, &r);
+            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+            {
+                // if(si->orientation == SDLUI_ORIENTATION_HORIZONTAL)
+                // {
+                // 	si->value = SDLUI_Map(si->x, si->x + si->w, si->min, si->max, mx);
+                // }
+                // else
+                // {
+                // 	si->value = SDLUI_Map(si->y + si->h, si->y, si->min, si->max, my);
+                // }
+
+                si->is_changing = true;
+            }
         }
-        else
+
+        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD && si->is_changing)
         {
-            r = { xx, yy, tb->w - 16, tb->h };
-            SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_circle_fill_2, NULL, &r);
-        }
+            if (si->orientation == SDLUI_ORIENTATION_HORIZONTAL)
+            {
+                si->value = SDLUI_Map(sr.x, sr.x + si->w, si->min, si->max, mx);
+                si->value = SDLUI_Clamp(si->value, si->min, si->max);
+            }
+            else
+            {
+                si->value = SDLUI_Map(sr.y + si->h, sr.y, si->min, si->max, my);
+                si->value = SDLUI_Clamp(si->value, si->min, si->max);
+            }
 
-        SDLUI_Colorize(SDLUI_Core.tex_circle_fill_2, SDLUI_Core.theme.col_white);
+            si->dirty = true;
+
+            // NOTE: Return here or on mouse release?
+            return true;
+        }
 
-        if (tb->tex_text != NULL)
+        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_RELEASED && si->is_changing)
         {
-            i32 tex_w, tex_h;
-            SDL_QueryTexture(tb->tex_text, NULL, NULL, &tex_w, &tex_h);
-            r = { xx + tb->w + SDLUI_MARGIN, yy + 2, tex_w, tex_h };
-            SDL_RenderCopy(SDLUI_Core.renderer, tb->tex_text, NULL, &r);
+            si->is_changing = false;
+            return true;
         }
+
+        return false;
     }
+
+    //si->is_changing = false;
+    return false;
 }
 
-void SDLUI_Render_RadioButton(SDLUI_Control_RadioButton* rb)
+bool SDLUI_CheckBox(SDLUI_Control_CheckBox* chk)
 {
-    if (rb->visible)
-    {
-        i32 xx = rb->x - rb->parent->x;
-        i32 yy = rb->y - rb->parent->y;
-
-        SDLUI_Colorize(SDLUI_Core.tex_circle, SDLUI_Core.theme.col_white);
-        SDL_Rect r = { xx, yy, rb->w, rb->h };
-        SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_circle, NULL, &r);
+    chk->do_process = true;
 
-        if (rb->checked)
+    if (chk->visible && chk->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    {
+        if (SDLUI_Core.hot_control == chk)
         {
-            SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_circle_fill_2, NULL, &r);
+            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+            {
+                chk->checked = !chk->checked;
+                chk->dirty = true;
+                return true;
+            }
         }
+        return false;
+    }
+    return false;
+}
+
+bool SDLUI_ToggleButton(SDLUI_Control_ToggleButton* tb)
+{
+    tb->do_process = true;
 
-        if (rb->tex_text != NULL)
+    if (tb->visible && tb->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    {
+        if (SDLUI_Core.hot_control == tb)
         {
-            i32 tex_w, tex_h;
-            SDL_QueryTexture(rb->tex_text, NULL, NULL, &tex_w, &tex_h);
-            r = { xx + rb->w + SDLUI_MARGIN, yy + 2, tex_w, tex_h };
-            SDL_RenderCopy(SDLUI_Core.renderer, rb->tex_text, NULL, &r);
+            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+            {
+                tb->checked = !tb->checked;
+                tb->dirty = true;
+                return true;
+            }
         }
+
+        return false;
     }
+    return false;
 }
 
-void SDLUI_RenderChild(SDLUI_CONTROL_TYPE type, SDLUI_Control* ctrl);
-
-void SDLUI_Render_Tabcontainer(SDLUI_Control_TabContainer* tbc)
+bool SDLUI_RadioButton(SDLUI_Control_RadioButton* rb)
 {
-    if (tbc->visible)
+    rb->do_process = true;
+
+    if (rb->visible && rb->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
     {
-        i32 xx = tbc->x - tbc->parent->x;
-        i32 yy = tbc->y - tbc->parent->y;
-        i32 offset = 0;
+        if (SDLUI_Core.hot_control == rb)
+        {
+            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+            {
+                SDLUI_Control_RadioButton* cur;
 
-        SDL_Rect r = { xx, yy, tbc->w, tbc->bar_height };
-        SDLUI_SetColor(SDLUI_Core.theme.col_inactive_window_bar);
-        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+                for (int i = 0; i < rb->group->size; ++i)
+                {
+                    cur = (SDLUI_Control_RadioButton*)rb->group->data[i];
+                    cur->dirty |= cur->checked;
+                    cur->checked = false;
+                }
 
-        SDLUI_Control_Tab* tab;
+                rb->checked = true;
+                rb->dirty = true;
 
-        for (int i = 0; i < tbc->tabs.size; ++i)
-        {
-            tab = (SDLUI_Control_Tab*)tbc->tabs.data[i];
+                return true;
+            }
+        }
 
-            SDLUI_SetColor(SDLUI_Core.theme.col_white);
-            r = { SDLUI_MARGIN + xx + offset, yy + SDLUI_MARGIN, tab->w, tab->h };
-            SDL_RenderCopy(SDLUI_Core.renderer, tab->tex_text, NULL, &r);
+        return false;
+    }
+    return false;
+}
 
-            if (tab == tbc->active_tab)
-            {
-                SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
-                r.y += 2 * SDLUI_MARGIN;
-                r.h = 2;
-                SDL_RenderFillRect(SDLUI_Core.renderer, &r);
-            }
+bool SDLUI_Text(SDLUI_Control_Text* txt)
+{
+    txt->do_process = true;
 
-            offset += SDLUI_MARGIN + tab->w;
+    if (txt->text.modified)
+    {
+        i32 w = SDLUI_MeasureText(txt->text.data);
+        if (w != txt->w)
+        {
+            txt->w = w;
+            SDLUI_InvalidateLayout(txt);
         }
+        txt->text.modified = false;
+        SDLUI_Invalidate(txt);
+    }
 
-        SDLUI_SetColor(SDLUI_Core.theme.col_window_bg);
-        r = { xx, yy + tbc->bar_height, tbc->w, tbc->h - tbc->bar_height };
-        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
-
-        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
-        r = { xx, yy, tbc->w, tbc->h };
-        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+    if (txt->visible && txt->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    {
+        return true;
+    }
+    return false;
+}
 
-        tab = (SDLUI_Control_Tab*)tbc->active_tab;
+bool SDLUI_TabContainer(SDLUI_Control_TabContainer* tbc)
+{
+    tbc->do_process = true;
 
-        SDLUI_CONTROL_TYPE type;
-        SDLUI_Control* ctrl;
+    if (tbc->visible && tbc->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    {
+        i32 mx = SDLUI_Input.mouse_x;
+        i32 my = SDLUI_Input.mouse_y;
+        SDL_Rect sr = SDLUI_GetScreenRect(tbc);
+        SDL_Rect r = { sr.x,sr.y,tbc->w,tbc->bar_height };
+        SDL_Rect tab_r;
+        i32 offset = 0;
+        SDLUI_Control_Tab* tab;
 
-        for (int j = 0; j < tab->children.size; ++j)
+        if (SDLUI_Core.hot_control == tbc && SDLUI_PointInRect(r, mx, my))
         {
-            type = tab->children.data[j]->type;
-            ctrl = tab->children.data[j];
+            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+            {
+                for (int i = 0; i < tbc->tabs.size; ++i)
+                {
+                    tab = (SDLUI_Control_Tab*)tbc->tabs.data[i];
+                    tab_r = { sr.x + offset, sr.y, tab->w + SDLUI_MARGIN, 30 };
 
-            ctrl->visible = true;
+                    if (SDLUI_PointInRect(tab_r, mx, my))
+                    {
+                        for (int j = 0; j < tbc->active_tab->children.size; ++j)
+                        {
+                            SDLUI_Control* ctrl = tbc->active_tab->children.data[j];
+                            ctrl->visible = false;
+                        }
+                        tbc->active_tab = tab;
+                        tbc->dirty = true;
+                    }
 
-            if (ctrl->do_process)
-            {
-                SDLUI_RenderChild(type, ctrl);
+                    offset += SDLUI_MARGIN + tab->w;
+                }
             }
         }
     }
+    return false;
 }
 
-void SDLUI_Render_ScrollArea(SDLUI_Control_ScrollArea* sa)
+bool SDLUI_ScrollArea(SDLUI_Control_ScrollArea* sa)
 {
-    if (sa->visible)
-    {
-        i32 xx = sa->x - sa->parent->x;
-        i32 yy = sa->y - sa->parent->y;
+    sa->do_process = true;
 
-        SDL_Rect r;
-        SDL_Rect dst = { xx, yy, sa->client_width, sa->client_height };
+    if (sa->visible && sa->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    {
+        i32 mx = SDLUI_Input.mouse_x;
+        i32 my = SDLUI_Input.mouse_y;
+        SDL_Rect sr = SDLUI_GetScreenRect(sa);
+        SDLUI_ScrollAreaState* state = (SDLUI_ScrollAreaState*)SDLUI_GetState(sa->id, sizeof(SDLUI_ScrollAreaState));
+        SDL_Rect rv, rh;
 
         if (sa->content_height > sa->h)
         {
-            // vertical scrollbar
-            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_track);
-            r = { xx + sa->w - sa->scrollbar_thickness, yy, sa->scrollbar_thickness, sa->track_size_v };
-            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+            if (SDLUI_Core.hot_control == sa)
+            {
+                // mouse wheel vertical
+                if (SDLUI_Input.wheel_y != 0)
+                {
+                    sa->scroll_y -= SDLUI_Input.wheel_y;
+                    sa->scroll_y = SDLUI_Clamp(sa->scroll_y, 0, sa->track_size_v - sa->thumb_size_v);
+                    sa->dirty = true;
+                    SDLUI_Input.wheel_y = 0;
+                    return true;
+                }
+            }
 
-            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_thumb);
-            sa->thumb_size_v = (float)(sa->track_size_v * (sa->h - sa->scrollbar_thickness)) / (float)sa->content_height;
+            rv = { sr.x + sa->w - sa->scrollbar_thickness, sr.y + sa->scroll_y, sa->scrollbar_thickness, sa->thumb_size_v };
+            if (SDLUI_PointInRect(rv, mx, my))
+            {
+                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+                {
+                    state->my_offset = my - sa->scroll_y;
+                    sa->is_changing_v = true;
+                }
+            }
+
+            // scroll per page
+            rv.y = sr.y;
+            rv.h = sa->scroll_y;
+
+            if (SDLUI_PointInRect(rv, mx, my))
+            {
+                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+                {
+                    float pages = (float)sa->content_height / (float)sa->h;
+                    float pixels_per_page = (float)sa->track_size_v / pages;
+                    sa->scroll_y -= pixels_per_page;
+                    sa->scroll_y = SDLUI_Clamp(sa->scroll_y, 0, sa->track_size_v - sa->thumb_size_v);
+                    sa->dirty = true;
+                    return true;
+                }
+            }
+
+            rv.y = sr.y + sa->scroll_y + sa->thumb_size_v;
+            rv.h = sa->track_size_v - sa->thumb_size_v - sa->scroll_y;
+
+            if (SDLUI_PointInRect(rv, mx, my))
+            {
+                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+                {
+                    float pages = (float)sa->content_height / (float)sa->h;
+                    float pixels_per_page = (float)sa->track_size_v / pages;
+                    sa->scroll_y += pixels_per_page;
+                    sa->scroll_y = SDLUI_Clamp(sa->scroll_y, 0, sa->track_size_v - sa->thumb_size_v);
+                    sa->dirty = true;
+                    return true;
+                }
+            }
+
+            if (sa->is_changing_v)
+            {
+                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD)
+                {
+                    sa->scroll_y = my - state->my_offset;
+                    sa->scroll_y = SDLUI_Clamp(sa->scroll_y, 0, sa->track_size_v - sa->thumb_size_v);
+                    sa->dirty = true;
+                }
 
-            r = { xx + sa->w - sa->scrollbar_thickness + 1, yy + sa->scroll_y, sa->scrollbar_thickness - 4, sa->thumb_size_v };
-            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_RELEASED)
+                {
+                    sa->is_changing_v = false;
+                    return true;
+                }
+            }
         }
 
         if (sa->content_width > sa->w)
         {
-            // horizontal scrollbar
-            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_track);
-            r = { xx, yy + sa->h - sa->scrollbar_thickness, sa->track_size_h, sa->scrollbar_thickness };
-            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
-
-            SDLUI_SetColor(SDLUI_Core.theme.col_scrollbar_thumb);
-            sa->thumb_size_h = (float)(sa->track_size_h * (sa->w - sa->scrollbar_thickness)) / (float)sa->content_width;
-
-            r = { xx + sa->scroll_x, yy + sa->h - sa->scrollbar_thickness + 1, sa->thumb_size_h, sa->scrollbar_thickness - 4 };
-            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
-        }
+            if (SDLUI_Core.hot_control == sa)
+            {
+                // mouse wheel horizontal
+                if (SDLUI_Input.wheel_x != 0)
+                {
+                    sa->scroll_x += SDLUI_Input.wheel_x;
+                    sa->scroll_x = SDLUI_Clamp(sa->scroll_x, 0, sa->track_size_h - sa->thumb_size_h);
+                    sa->dirty = true;
+                    SDLUI_Input.wheel_x = 0;
+                    return true;
+                }
+            }
 
-        // Texture
-        if (SDL_QueryTexture(sa->tex_rect, NULL, NULL, &sa->content_width, &sa->content_height) == 0)
-        {
-            if (sa->content_width > sa->w)
+            rh = { sr.x + sa->scroll_x, sr.y + sa->h - sa->scrollbar_thickness, sa->thumb_size_h, sa->scrollbar_thickness };
+            if (SDLUI_PointInRect(rh, mx, my))
             {
-                sa->client_height = sa->h - sa->scrollbar_thickness;
+                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+                {
+                    state->mx_offset = mx - sa->scroll_x;
+                    sa->is_changing_h = true;
+                }
             }
-            if (sa->content_height > sa->h)
+
+            // scroll per page
+            rh.x = sr.x;
+            rh.w = sa->scroll_x;
+
+            if (SDLUI_PointInRect(rh, mx, my))
             {
-                sa->client_width = sa->w - sa->scrollbar_thickness;
+                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+                {
+                    float pages = (float)sa->content_width / (float)sa->w;
+                    float pixels_per_page = (float)sa->track_size_h / pages;
+                    sa->scroll_x -= pixels_per_page;
+                    sa->scroll_x = SDLUI_Clamp(sa->scroll_x, 0, sa->track_size_h - sa->thumb_size_h);
+                    sa->dirty = true;
+                    return true;
+                }
             }
-        }
-        else
-        {
-            sa->client_width = sa->w;
-            sa->client_height = sa->h;
-        }
 
-        float ratio_y = (float)sa->content_height / sa->client_height;
-        float ratio_x = (float)sa->content_width / sa->client_width;
+            rh.x = sr.x + sa->scroll_x + sa->thumb_size_h;
+            rh.w = sa->track_size_h - sa->thumb_size_h - sa->scroll_x;
 
-        float offset_x = sa->scroll_x * ratio_x;
-        float offset_y = sa->scroll_y * ratio_y;
+            if (SDLUI_PointInRect(rh, mx, my))
+            {
+                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+                {
+                    float pages = (float)sa->content_width / (float)sa->w;
+                    float pixels_per_page = (float)sa->track_size_h / pages;
+                    sa->scroll_x += pixels_per_page;
+                    sa->scroll_x = SDLUI_Clamp(sa->scroll_x, 0, sa->track_size_h - sa->thumb_size_h);
+                    sa->dirty = true;
+                    return true;
+                }
+            }
 
-        offset_x = SDLUI_Clamp(offset_x, 0, sa->content_width - sa->client_width);
-        offset_y = SDLUI_Clamp(offset_y, 0, sa->content_height - sa->client_height);
+            if (sa->is_changing_h)
+            {
+                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD)
+                {
+                    sa->scroll_x = mx - state->mx_offset;
+                    sa->scroll_x = SDLUI_Clamp(sa->scroll_x, 0, sa->track_size_h - sa->thumb_size_h);
+                    sa->dirty = true;
+                }
 
-        SDL_Rect src = { (i32)offset_x, (i32)offset_y, sa->client_width, sa->client_height };
-        SDL_RenderCopy(SDLUI_Core.renderer, sa->tex_rect, &src, &dst);
+                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_RELEASED)
+                {
+                    sa->is_changing_h = false;
+                    return true;
+                }
+            }
 
-        // Container rect
-        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
-        r = { xx, yy, sa->w, sa->h };
-        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+        }
+        return false;
     }
+    return false;
 }
 
-void SDLUI_Render_TextBox(SDLUI_Control_TextBox* tbx)
+bool SDLUI_List(SDLUI_Control_List* lst, const char* cur_item, i32 num_items, i32 cur_index)
 {
-    if (tbx->visible)
-    {
-        i32 xx = tbx->x - tbx->parent->x;
-        i32 yy = tbx->y - tbx->parent->y;
+    lst->do_process = true;
 
-        SDLUI_SetColor(SDLUI_Core.theme.col_textbox_bg);
-        SDL_Rect r = { xx, yy, tbx->w, tbx->h };
-        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+    // where the list is in feeding its items is kept per list, so any number of them can be filled at once.
+    SDLUI_ListState* state = (SDLUI_ListState*)SDLUI_GetState(lst->id, sizeof(SDLUI_ListState));
 
-        SDLUI_SetColor(SDLUI_Core.theme.col_grey);
-        SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+    if (lst->scroll_area->visible && lst->scroll_area->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    {
+        i32 mx = SDLUI_Input.mouse_x;
+        i32 my = SDLUI_Input.mouse_y;
+        SDL_Rect sr = SDLUI_GetScreenRect(lst->scroll_area);
+        SDL_Rect r = { sr.x, sr.y, lst->scroll_area->client_width, lst->scroll_area->client_height };
 
-        if (tbx->text.length > 0)
+        if (SDLUI_Core.hot_control == lst->scroll_area && SDLUI_PointInRect(r, mx, my) && cur_index == 0)
         {
-            i32 tex_w, tex_h;
-            SDL_QueryTexture(tbx->tex_text, NULL, NULL, &tex_w, &tex_h);
-            SDL_Rect src = { 0, 0, tex_w, tex_h };
-            SDL_Rect dst = { xx + SDLUI_MARGIN, yy + SDLUI_MARGIN, src.w, src.h };
-            SDL_RenderCopy(SDLUI_Core.renderer, tbx->tex_text, &src, &dst);
+            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+            {
+                float ratio = (float)lst->scroll_area->content_height / (float)lst->scroll_area->client_height;
+                float oy = my - sr.y + ((float)lst->scroll_area->scroll_y * ratio);
+                lst->selected_index = oy / SDLUI_Font.height;
+                state->clicked = true;
+            }
         }
+    }
 
-        if (tbx->focused && tbx->parent == SDLUI_Core.active_window && SDLUI_Core.active_window != NULL)
+    if (lst->num_items != num_items)
+    {
+        lst->num_items = num_items;
+        i32 h = num_items * SDLUI_Font.height;
+
+        if (h < lst->scroll_area->h)
         {
-            r = { xx + SDLUI_MARGIN + ((tbx->cursor_pos - tbx->scroll) * SDLUI_Font.width), yy + 6, 2, tbx->h - 12 };
-            SDLUI_SetColor(SDLUI_Core.theme.col_white);
-            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+            h = lst->scroll_area->h;
         }
-    }
-}
 
-void SDLUI_RenderChild(SDLUI_CONTROL_TYPE type, SDLUI_Control* ctrl)
-{
-    switch (type)
-    {
-    case SDLUI_CONTROL_TYPE_BUTTON:
-    {
-        SDLUI_Render_Button((SDLUI_Control_Button*)ctrl);
+        lst->scroll_area->content_height = h;
+        lst->scroll_area->tex_rect = SDLUI_ResizeTarget(lst->scroll_area->tex_rect, lst->scroll_area->content_width, h);
+        SDLUI_UpdateScrollAreaClient(lst->scroll_area);
     }
-    break;
 
-    case SDLUI_CONTROL_TYPE_SLIDER_INT:
+    if (state->counter == 0)
     {
-        SDLUI_Render_SliderInt((SDLUI_Control_SliderInt*)ctrl);
+        state->content = SDLUI_HashID(&lst->selected_index, sizeof(lst->selected_index), SDLUI_HashID(&lst->scroll_area->scroll_x, sizeof(lst->scroll_area->scroll_x), 0));
+        SDLUI_FlushText();
+        SDLUI_SetColor(SDLUI_Core.theme.col_list_bg);
+        SDL_Rect r = { 0, 0, lst->scroll_area->content_width, lst->scroll_area->content_height };
+        SDL_SetRenderTarget(SDLUI_Core.renderer, lst->scroll_area->tex_rect);
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+        SDL_SetRenderTarget(SDLUI_Core.renderer, NULL);
     }
-    break;
 
-    case SDLUI_CONTROL_TYPE_CHECKBOX:
+    if (state->counter == lst->selected_index)
     {
-        SDLUI_Render_CheckBox((SDLUI_Control_CheckBox*)ctrl);
+        SDL_SetRenderTarget(SDLUI_Core.renderer, lst->scroll_area->tex_rect);
+        SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
+
+        float ratio = (float)lst->scroll_area->content_width / (float)lst->scroll_area->client_width;
+        i32 offset_x = lst->scroll_area->scroll_x * ratio;
+        SDL_Rect r = { offset_x, lst->selected_index * SDLUI_Font.height, lst->scroll_area->w, SDLUI_Font.height };
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
     }
-    break;
 
-    case SDLUI_CONTROL_TYPE_TOGGLE_BUTTON:
+    i32 item_width = SDLUI_MARGIN + SDLUI_MeasureText(cur_item);
+    if (item_width > lst->max_string_width)
     {
-        SDLUI_Render_ToggleButton((SDLUI_Control_ToggleButton*)ctrl);
+        lst->max_string_width = item_width;
     }
-    break;
 
-    case SDLUI_CONTROL_TYPE_RADIO_BUTTON:
+    if (lst->max_string_width > lst->scroll_area->content_width)
     {
-        SDLUI_Render_RadioButton((SDLUI_Control_RadioButton*)ctrl);
+        lst->scroll_area->content_width = lst->max_string_width;
+        lst->scroll_area->tex_rect = SDLUI_ResizeTarget(lst->scroll_area->tex_rect, lst->max_string_width, lst->scroll_area->content_height);
+        SDLUI_UpdateScrollAreaClient(lst->scroll_area);
     }
-    break;
 
-    case SDLUI_CONTROL_TYPE_TEXT:
+    SDLUI_DrawText(SDLUI_MARGIN, state->offset_y, cur_item, lst->scroll_area->tex_rect);
+    state->content = SDLUI_GetID(cur_item, state->content);
+    state->offset_y += SDLUI_Font.height;
+    state->counter++;
+
+    if (state->counter == num_items)
     {
-        SDLUI_Render_Text((SDLUI_Control_Text*)ctrl);
+        state->offset_y = 0;
+        state->counter = 0;
+
+        // the items are drawn again every pass, the window only has to pick them up when they look different.
+        if (state->content != state->drawn_content)
+        {
+            state->drawn_content = state->content;
+            lst->scroll_area->dirty = true;
+        }
+
+        if (state->clicked)
+        {
+            state->clicked = false;
+            return true;
+        }
     }
-    break;
 
-    case SDLUI_CONTROL_TYPE_TAB_CONTAINER:
+    return false;
+}
+
+i32 SDLUI_PreviousCodepoint(const char* text, i32 index)
+{
+    do
     {
-        SDLUI_Render_Tabcontainer((SDLUI_Control_TabContainer*)ctrl);
-    }
-    break;
+        index--;
+    } while (index > 0 && ((u8)text[index] & 0xC0) == 0x80);
 
-    case SDLUI_CONTROL_TYPE_SCROLL_AREA:
+    return index;
+}
+
+// Scrolls the text box so the cursor is visible and redraws its text texture.
+void SDLUI_UpdateTextBoxText(SDLUI_Control_TextBox* tbx)
+{
+    i32 visible_width = tbx->w - (2 * SDLUI_MARGIN);
+
+    if (tbx->cursor_pos < tbx->scroll)
     {
-        SDLUI_Render_ScrollArea((SDLUI_Control_ScrollArea*)ctrl);
+        tbx->scroll = tbx->cursor_pos;
     }
-    break;
 
-    case SDLUI_CONTROL_TYPE_TEXTBOX:
+    while (SDLUI_MeasureTextRange(tbx->text.data, tbx->scroll, tbx->cursor_pos - tbx->scroll) > visible_width)
     {
-        SDLUI_Render_TextBox((SDLUI_Control_TextBox*)ctrl);
-    }
-    break;
+        SDLUI_DecodeUTF8(tbx->text.data, &tbx->scroll);
     }
+
+    SDLUI_FlushText();
+    SDL_SetRenderTarget(SDLUI_Core.renderer, tbx->tex_text);
+    SDL_Rect r = { 0, 0, tbx->w, tbx->h };
+    SDLUI_SetColor(SDLUI_Core.theme.col_textbox_bg);
+    SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+    SDL_SetRenderTarget(SDLUI_Core.renderer, NULL);
+
+    SDLUI_DrawTextRange(0, 0, tbx->text.data, tbx->scroll, tbx->text.length - tbx->scroll, tbx->tex_text);
+    tbx->dirty = true;
 }
 
-void SDLUI_Render_Window(SDLUI_Control_Window* wnd)
+bool SDLUI_TextBox(SDLUI_Control_TextBox* tbx)
 {
-    if (!wnd->do_process)
-    {
-        return;
-    }
+    tbx->do_process = true;
 
-    if (wnd->visible != wnd->visible_last_frame)
+    if (tbx->visible && tbx->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
     {
-        for (int i = 0; i < wnd->children.size; ++i)
+        if (SDLUI_Core.hot_control == tbx)
         {
-            wnd->children.data[i]->visible = wnd->visible;
-            wnd->visible_last_frame = wnd->visible;
+            SDL_SetCursor(SDLUI_Core.cursor_ibeam);
+        }
+        else
+        {
+            SDL_SetCursor(SDLUI_Core.cursor_arrow);
         }
 
-    }
 
-    if (wnd->enabled != wnd->enabled_last_frame)
-    {
-        for (int i = 0; i < wnd->children.size; ++i)
+        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
         {
-            wnd->children.data[i]->enabled = wnd->enabled;
-            wnd->enabled_last_frame = wnd->enabled;
-        }
+            bool focused = SDLUI_Core.hot_control == tbx;
+            tbx->dirty |= focused != tbx->focused;
+            tbx->focused = focused;
 
+            if (focused)
+            {
+                return true;
+            }
+        }
     }
 
-    if (wnd->visible)
+    if (tbx->focused && tbx->parent == SDLUI_Core.active_window)
     {
-        if (wnd == SDLUI_Core.active_window)
+        for (int e = 0; e < SDLUI_Input.num_events; ++e)
         {
-            SDL_SetRenderTarget(SDLUI_Core.renderer, wnd->tex_rect);
-
-            SDLUI_SetColor(SDLUI_Core.theme.col_active_window_bar);
-            SDL_Rect r = { 0, 0, wnd->w, 30 };
-            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
-
-            SDLUI_SetColor(SDLUI_Core.theme.col_white);
-            i32 tex_w, tex_h;
-            SDL_QueryTexture(wnd->tex_title, NULL, NULL, &tex_w, &tex_h);
-            r = { SDLUI_MARGIN, SDLUI_MARGIN, tex_w, tex_h };
-            SDL_RenderCopy(SDLUI_Core.renderer, wnd->tex_title, NULL, &r);
-
-            SDLUI_SetColor(SDLUI_Core.theme.col_window_bg);
-            r = { 0, 0 + 30, wnd->w, wnd->h - 30 };
-            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
-
-            i32 mx, my;
-            SDL_GetMouseState(&mx, &my);
-            r = { wnd->x + wnd->w - 30, wnd->y, 30, 30 };
+            SDL_Event* ev = &SDLUI_Input.events[e];
 
-            if (wnd->has_close_button)
+            if (ev->type == SDL_TEXTINPUT)
             {
-                if (SDLUI_PointInRect(r, mx, my) && !wnd->is_resized)
-                {
-                    SDLUI_SetColor(SDLUI_Core.theme.col_red);
-                    r = { wnd->w - 29, 1, 28, 28 };
-                    SDL_RenderFillRect(SDLUI_Core.renderer, &r);
-                }
-                else
+                const char* input = ev->text.text;
+
+                for (int i = 0; input[i] != '\0'; ++i)
                 {
-                    SDLUI_SetColor(SDLUI_Core.theme.col_active_window_bar);
-                    r = { wnd->w - 29, 1, 28, 28 };
-                    SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+                    tbx->text.insert_char(input[i], tbx->cursor_pos);
+                    tbx->cursor_pos++;
                 }
 
-                r = { 0 + wnd->w - 30, 0, 30, 30 };
-                SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_close, NULL, &r);
+                SDLUI_UpdateTextBoxText(tbx);
             }
 
-            SDLUI_CONTROL_TYPE type;
-            SDLUI_Control* ctrl;
-
-            for (int j = 0; j < wnd->children.size; ++j)
+            if (ev->type == SDL_KEYDOWN)
             {
-                type = wnd->children.data[j]->type;
-                ctrl = wnd->children.data[j];
-
-                if (ctrl->owned_by_window && ctrl->do_process)
+                if (ev->key.keysym.scancode == SDL_SCANCODE_LEFT)
                 {
-                    if (ctrl->x < wnd->x + wnd->w && ctrl->y < wnd->y + wnd->h)
+                    if (tbx->cursor_pos > 0)
                     {
-                        SDLUI_RenderChild(type, ctrl);
+                        tbx->cursor_pos = SDLUI_PreviousCodepoint(tbx->text.data, tbx->cursor_pos);
+                        SDLUI_UpdateTextBoxText(tbx);
                     }
                 }
-            }
-
-            SDLUI_SetColor(SDLUI_Core.theme.col_grey);
-            r = { 0, 0, wnd->w, wnd->h };
-            SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
-            r = { wnd->x, wnd->y, wnd->w, wnd->h };
-            SDL_SetRenderTarget(SDLUI_Core.renderer, NULL);
-            SDL_RenderCopy(SDLUI_Core.renderer, wnd->tex_rect, NULL, &r);
-        }
-        else
-        {
-            SDL_SetRenderTarget(SDLUI_Core.renderer, wnd->tex_rect);
-            SDL_Rect r = { 0, 0, wnd->w, 30 };
-            SDLUI_SetColor(SDLUI_Core.theme.col_inactive_window_bar);
-            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
-
-            SDLUI_SetColor(SDLUI_Core.theme.col_white);
-            i32 tex_w, tex_h;
-            SDL_QueryTexture(wnd->tex_title, NULL, NULL, &tex_w, &tex_h);
-            r = { SDLUI_MARGIN, SDLUI_MARGIN, tex_w, tex_h };
-            SDL_RenderCopy(SDLUI_Core.renderer, wnd->tex_title, NULL, &r);
-
-            if (wnd->has_close_button)
-            {
-                r = { 0 + wnd->w - 30, 0, 30, 30 };
-                SDL_RenderCopy(SDLUI_Core.renderer, SDLUI_Core.tex_close, NULL, &r);
-            }
+                else if (ev->key.keysym.scancode == SDL_SCANCODE_RIGHT)
+                {
+                    if (tbx->cursor_pos < tbx->text.length)
+                    {
+                        SDLUI_DecodeUTF8(tbx->text.data, &tbx->cursor_pos);
+                        SDLUI_UpdateTextBoxText(tbx);
+                    }
+                }
+                else if (ev->key.keysym.scancode == SDL_SCANCODE_BACKSPACE)
+                {
+                    if (tbx->cursor_pos > 0)
+                    {
+                        i32 start = SDLUI_PreviousCodepoint(tbx->text.data, tbx->cursor_pos);
 
-            SDLUI_SetColor(SDLUI_Core.theme.col_grey);
-            r = { 0, 0, wnd->w, wnd->h };
-            SDL_RenderDrawRect(SDLUI_Core.renderer, &r);
+                        while (tbx->cursor_pos > start)
+                        {
+                            tbx->text.delete_char(tbx->cursor_pos - 1);
+                            tbx->cursor_pos--;
+                        }
 
-            r = { wnd->x, wnd->y, wnd->w, wnd->h };
-            SDL_SetRenderTarget(SDLUI_Core.renderer, NULL);
-            SDL_RenderCopy(SDLUI_Core.renderer, wnd->tex_rect, NULL, &r);
+                        SDLUI_UpdateTextBoxText(tbx);
+                    }
+                }
+            }
         }
     }
+
+    return false;
 }
 
-void SDLUI_ForceReDraw()
+void SDLUI_TextEditorMarkLines(SDLUI_Control_TextEditor* ed, i32 first, i32 last)
 {
-    SDLUI_Control_Window* wnd;
-    SDLUI_Control_Window* aw = SDLUI_Core.active_window;
+    ed->dirty_first = first < ed->dirty_first ? first : ed->dirty_first;
+    ed->dirty_last = last > ed->dirty_last ? last : ed->dirty_last;
+}
 
-    for (int i = 0; i < SDLUI_Window_Collection.size; ++i)
+// Inserts size bytes at pos and patches the line index, the undo history is left alone.
+void SDLUI_TextEditorInsertRaw(SDLUI_Control_TextEditor* ed, i32 pos, const char* text, i32 size)
+{
+    i32 line = ed->lines.line_of(pos);
+    i32 num_new = 0;
+
+    for (int i = 0; i < size; ++i)
     {
-        wnd = (SDLUI_Control_Window*)SDLUI_Window_Collection.data[i];
-        SDLUI_Core.active_window = wnd;
-        SDLUI_Render_Window(wnd);
+        num_new += text[i] == '\n';
     }
 
-    SDLUI_Core.active_window = aw;
-}
+    ed->buffer.insert(pos, text, size);
+    ed->lines.reserve(num_new);
 
-void SDLUI_Render()
-{
-    SDLUI_Control_Window* wnd;
+    i32* starts = ed->lines.starts;
+    memmove(starts + line + 1 + num_new, starts + line + 1, (ed->lines.count - line - 1) * sizeof(i32));
+    ed->lines.count += num_new;
 
-    static bool once = false;
-    if (!once)
+    for (int i = line + 1 + num_new; i < ed->lines.count; ++i)
     {
-        SDLUI_ForceReDraw();
-        once = true;
+        starts[i] += size;
     }
 
-    for (int i = 0; i < SDLUI_Window_Collection.size; ++i)
+    i32 next = line + 1;
+    for (int i = 0; i < size; ++i)
     {
-        wnd = (SDLUI_Control_Window*)SDLUI_Window_Collection.data[i];
-        SDLUI_Render_Window(wnd);
+        if (text[i] == '\n')
+        {
+            starts[next++] = pos + i + 1;
+        }
     }
 
-    SDLUI_MouseStateReset();
+    SDLUI_TextEditorMarkLines(ed, line, num_new > 0 ? SDLUI_LAST_LINE : line);
 }
 
-SDLUI_Control_Window* SDLUI_CreateWindow(i32 x, i32 y, i32 w, i32 h, char* title)
+// Erases size bytes at pos and patches the line index, the undo history is left alone.
+void SDLUI_TextEditorEraseRaw(SDLUI_Control_TextEditor* ed, i32 pos, i32 size)
 {
-    SDLUI_Control_Window* wnd = (SDLUI_Control_Window*)malloc(sizeof(SDLUI_Control_Window));
-
-    wnd->type = SDLUI_CONTROL_TYPE_WINDOW;
-    wnd->title.create(title);
-    wnd->x = x;
-    wnd->y = y;
-    wnd->drag_x = 0;
-    wnd->drag_y = 0;
-    wnd->w = w;
-    wnd->h = h;
-    wnd->visible = true;
-    wnd->enabled = true;
-    wnd->is_resized = false;
-    wnd->do_process = false;
-    wnd->has_close_button = true;
-    wnd->can_be_resized = true;
+    i32 first = ed->lines.line_of(pos);
+    i32 last = ed->lines.line_of(pos + size);
 
-    SDL_Surface* s = TTF_RenderText_Blended(SDLUI_Font.handle, wnd->title.data, SDLUI_Core.theme.col_white);
-    wnd->tex_title = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-    SDL_FreeSurface(s);
+    ed->buffer.erase(pos, size);
 
-    wnd->tex_rect = SDL_CreateTexture(SDLUI_Core.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    i32* starts = ed->lines.starts;
+    memmove(starts + first + 1, starts + last + 1, (ed->lines.count - last - 1) * sizeof(i32));
+    ed->lines.count -= last - first;
 
-    wnd->children.create();
-    SDLUI_Window_Collection.push(wnd);
+    for (int i = first + 1; i < ed->lines.count; ++i)
+    {
+        starts[i] -= size;
+    }
 
-    return wnd;
+    SDLUI_TextEditorMarkLines(ed, first, last > first ? SDLUI_LAST_LINE : first);
 }
 
-SDLUI_Control_Button* SDLUI_CreateButton(SDLUI_Control_Window* wnd, i32 x, i32 y, char* text)
+// Adds size bytes of the buffer at pos to the undo history. Called after an insertion and before an erase,
+// so the bytes are still there to copy.
+void SDLUI_TextEditorRecord(SDLUI_Control_TextEditor* ed, bool inserted, i32 pos, i32 size)
 {
-    SDLUI_Control_Button* btn = (SDLUI_Control_Button*)malloc(sizeof(SDLUI_Control_Button));
+    // whatever was undone can't be redone once something new has been edited.
+    if (ed->undo_pos < ed->num_undo)
+    {
+        ed->undo_text_length = ed->undo[ed->undo_pos].text;
+        ed->num_undo = ed->undo_pos;
+    }
 
-    btn->type = SDLUI_CONTROL_TYPE_BUTTON;
-    btn->do_process = false;
-    btn->text.create(text);
-    btn->x = wnd->x + x;
-    btn->y = wnd->y + y;
-    btn->w = 100;
-    btn->h = 30;
-    btn->visible = true;
-    btn->enabled = true;
-    btn->owned_by_window = true;
-    btn->align = SDLUI_ALIGN_CENTER;
-    btn->state = SDLUI_BUTTON_STATE_NORMAL;
-    btn->parent = wnd;
+    if (ed->undo_text_length + size > ed->undo_text_capacity)
+    {
+        ed->undo_text_capacity = ed->undo_text_capacity == 0 ? 1024 : ed->undo_text_capacity;
+        while (ed->undo_text_length + size > ed->undo_text_capacity)
+        {
+            ed->undo_text_capacity *= 2;
+        }
+        ed->undo_text = (char*)realloc(ed->undo_text, ed->undo_text_capacity);
+    }
 
-    SDL_Surface* s = TTF_RenderText_Blended(SDLUI_Font.handle, text, SDLUI_Core.theme.col_white);
-    btn->tex_text = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-    SDL_FreeSurface(s);
+    ed->buffer.copy(pos, size, ed->undo_text + ed->undo_text_length);
 
-    wnd->children.push(btn);
-    return btn;
+    // typing a word or pressing delete a few times grows the last record instead of adding one per key.
+    SDLUI_EditRecord* last = ed->num_undo > 0 ? &ed->undo[ed->num_undo - 1] : NULL;
+    if (last != NULL && last->group == ed->undo_group && last->inserted == inserted && last->text + last->length == ed->undo_text_length &&
+        (inserted ? last->pos + last->length == pos : last->pos == pos))
+    {
+        last->length += size;
+        ed->undo_text_length += size;
+        return;
+    }
+
+    if (ed->num_undo >= ed->undo_capacity)
+    {
+        ed->undo_capacity = ed->undo_capacity == 0 ? 64 : ed->undo_capacity * 2;
+        ed->undo = (SDLUI_EditRecord*)realloc(ed->undo, ed->undo_capacity * sizeof(SDLUI_EditRecord));
+    }
+
+    SDLUI_EditRecord* rec = &ed->undo[ed->num_undo++];
+    rec->pos = pos;
+    rec->length = size;
+    rec->text = ed->undo_text_length;
+    rec->inserted = inserted;
+    rec->group = ed->undo_group;
+    rec->cursor = ed->cursor;
+    rec->anchor = ed->anchor;
+
+    ed->undo_text_length += size;
+    ed->undo_pos = ed->num_undo;
 }
 
-SDLUI_Control_SliderInt* SDLUI_CreateSliderInt(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 min, i32 max, i32 value, SDLUI_ORIENTATION orientation = SDLUI_ORIENTATION_HORIZONTAL)
+// Edits of the same kind in a row are undone together, anything else starts a new undo step.
+void SDLUI_TextEditorBeginEdit(SDLUI_Control_TextEditor* ed, SDLUI_EDIT_KIND kind)
 {
-    SDLUI_Control_SliderInt* si = (SDLUI_Control_SliderInt*)malloc(sizeof(SDLUI_Control_SliderInt));
+    if (kind == SDLUI_EDIT_KIND_NONE || kind != ed->last_edit)
+    {
+        ed->undo_group++;
+    }
 
-    si->type = SDLUI_CONTROL_TYPE_SLIDER_INT;
-    si->do_process = false;
-    si->x = wnd->x + x;
-    si->y = wnd->y + y;
-    si->visible = true;
-    si->enabled = true;
-    si->owned_by_window = true;
-    si->min = min;
-    si->max = max;
-    si->value = value;
-    si->thumb_size = 12;
-    si->is_changing = false;
-    si->orientation = orientation;
-    si->parent = wnd;
+    ed->last_edit = kind;
+}
 
-    if (si->orientation == SDLUI_ORIENTATION_HORIZONTAL)
+void SDLUI_TextEditorScrollTo(SDLUI_Control_TextEditor* ed, i32 first_line)
+{
+    first_line = SDLUI_Clamp(first_line, 0, ed->max_first_line());
+
+    if (first_line != ed->first_line)
     {
-        si->w = 100;
-        si->h = 16;
+        ed->first_line = first_line;
+        SDLUI_TextEditorMarkLines(ed, 0, SDLUI_LAST_LINE);
+        ed->dirty = true;
+    }
+}
+
+void SDLUI_TextEditorSetSelection(SDLUI_Control_TextEditor* ed, i32 anchor, i32 cursor)
+{
+    // only rows between the old and the new selection change, none at all if nothing was or is selected.
+    if (anchor == ed->anchor)
+    {
+        if (anchor != cursor || ed->anchor != ed->cursor)
+        {
+            i32 from = cursor < ed->cursor ? cursor : ed->cursor;
+            i32 to = cursor > ed->cursor ? cursor : ed->cursor;
+            SDLUI_TextEditorMarkLines(ed, ed->lines.line_of(from), ed->lines.line_of(to));
+        }
     }
     else
     {
-        si->w = 16;
-        si->h = 100;
+        if (ed->anchor != ed->cursor)
+        {
+            SDLUI_TextEditorMarkLines(ed, ed->lines.line_of(ed->selection_start()), ed->lines.line_of(ed->selection_end()));
+        }
+
+        if (anchor != cursor)
+        {
+            SDLUI_TextEditorMarkLines(ed, ed->lines.line_of(anchor < cursor ? anchor : cursor), ed->lines.line_of(anchor > cursor ? anchor : cursor));
+        }
     }
 
-    wnd->children.push(si);
-    return si;
+    ed->anchor = anchor;
+    ed->cursor = cursor;
+
+    i32 line = ed->lines.line_of(cursor);
+    i32 length;
+    const char* text = SDLUI_TextEditorLine(ed, line, &length);
+    ed->cursor_x = SDLUI_MeasureTextRange(text, 0, cursor - ed->lines.starts[line]);
+    ed->preferred_x = ed->cursor_x;
+
+    // keep the cursor in view.
+    if (line < ed->first_line)
+    {
+        SDLUI_TextEditorScrollTo(ed, line);
+    }
+    else if (line >= ed->first_line + ed->visible_lines())
+    {
+        SDLUI_TextEditorScrollTo(ed, line - ed->visible_lines() + 1);
+    }
+
+    i32 tw = ed->text_width();
+    if (ed->cursor_x < ed->scroll_x || ed->cursor_x > ed->scroll_x + tw - 2)
+    {
+        ed->scroll_x = SDLUI_Max(0, ed->cursor_x - tw / 2);
+        SDLUI_TextEditorMarkLines(ed, 0, SDLUI_LAST_LINE);
+    }
+
+    ed->dirty = true;
 }
 
-SDLUI_Control_CheckBox* SDLUI_CreateCheckBox(SDLUI_Control_Window* wnd, i32 x, i32 y, char* text, bool checked)
+void SDLUI_TextEditorSetCursor(SDLUI_Control_TextEditor* ed, i32 pos, bool extend)
 {
-    SDLUI_Control_CheckBox* chk = (SDLUI_Control_CheckBox*)malloc(sizeof(SDLUI_Control_CheckBox));
-
-    chk->type = SDLUI_CONTROL_TYPE_CHECKBOX;
-    chk->do_process = false;
-    chk->x = wnd->x + x;
-    chk->y = wnd->y + y;
-    chk->w = 16;
-    chk->h = 16;
-    chk->visible = true;
-    chk->enabled = true;
-    chk->owned_by_window = true;
-    chk->checked = checked;
-    chk->parent = wnd;
+    SDLUI_TextEditorSetSelection(ed, extend ? ed->anchor : pos, pos);
+}
 
-    if (strlen(text) > 0)
+// Replaces the bytes from start to end with text, as one step of the undo history.
+void SDLUI_TextEditorReplace(SDLUI_Control_TextEditor* ed, i32 start, i32 end, const char* text, i32 size)
+{
+    if (end > start)
     {
-        chk->text.create(text);
-        SDL_Surface* s = TTF_RenderText_Blended(SDLUI_Font.handle, text, SDLUI_Core.theme.col_white);
-        chk->tex_text = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-        SDL_FreeSurface(s);
+        SDLUI_TextEditorRecord(ed, false, start, end - start);
+        SDLUI_TextEditorEraseRaw(ed, start, end - start);
     }
-    else
+
+    if (size > 0)
     {
-        chk->tex_text = NULL;
+        SDLUI_TextEditorInsertRaw(ed, start, text, size);
+        SDLUI_TextEditorRecord(ed, true, start, size);
     }
 
-    wnd->children.push(chk);
-    return chk;
+    // the old cursor may be past the end of the text now, it only has to be somewhere valid.
+    ed->anchor = ed->cursor = start;
+    SDLUI_TextEditorSetSelection(ed, start + size, start + size);
 }
 
-SDLUI_Control_Text* SDLUI_CreateText(SDLUI_Control_Window* wnd, i32 x, i32 y, char* text)
+void SDLUI_TextEditorReplaceSelection(SDLUI_Control_TextEditor* ed, const char* text, i32 size)
 {
-    SDLUI_Control_Text* txt = (SDLUI_Control_Text*)malloc(sizeof(SDLUI_Control_Text));
+    SDLUI_TextEditorReplace(ed, ed->selection_start(), ed->selection_end(), text, size);
+}
 
-    txt->type = SDLUI_CONTROL_TYPE_TEXT;
-    txt->do_process = false;
-    txt->text.create(text);
-    txt->x = wnd->x + x;
-    txt->y = wnd->y + y;
-    txt->w = (txt->text.length) * SDLUI_Font.width;
-    txt->h = SDLUI_Font.height;
-    txt->visible = true;
-    txt->enabled = true;
-    txt->owned_by_window = true;
-    txt->parent = wnd;
+// Both return whether there was anything to undo or redo.
+bool SDLUI_TextEditorUndo(SDLUI_Control_TextEditor* ed)
+{
+    if (ed->undo_pos == 0)
+    {
+        return false;
+    }
 
-    SDL_Surface* s = TTF_RenderText_Blended(SDLUI_Font.handle, txt->text.data, SDLUI_Core.theme.col_white);
-    txt->tex_text = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-    SDL_FreeSurface(s);
+    u32 group = ed->undo[ed->undo_pos - 1].group;
+    SDLUI_EditRecord* rec = NULL;
 
-    wnd->children.push(txt);
-    return txt;
+    while (ed->undo_pos > 0 && ed->undo[ed->undo_pos - 1].group == group)
+    {
+        rec = &ed->undo[--ed->undo_pos];
+
+        if (rec->inserted)
+        {
+            SDLUI_TextEditorEraseRaw(ed, rec->pos, rec->length);
+        }
+        else
+        {
+            SDLUI_TextEditorInsertRaw(ed, rec->pos, ed->undo_text + rec->text, rec->length);
+        }
+    }
+
+    ed->anchor = ed->cursor = 0;
+    SDLUI_TextEditorSetSelection(ed, rec->anchor, rec->cursor);
+    ed->last_edit = SDLUI_EDIT_KIND_NONE;
+    return true;
 }
 
-SDLUI_Control_ToggleButton* SDLUI_CreateToggleButton(SDLUI_Control_Window* wnd, i32 x, i32 y, char* text, bool checked)
+bool SDLUI_TextEditorRedo(SDLUI_Control_TextEditor* ed)
 {
-    SDLUI_Control_ToggleButton* tb = (SDLUI_Control_ToggleButton*)malloc(sizeof(SDLUI_Control_ToggleButton));
+    if (ed->undo_pos == ed->num_undo)
+    {
+        return false;
+    }
 
-    tb->type = SDLUI_CONTROL_TYPE_TOGGLE_BUTTON;
-    tb->do_process = false;
-    tb->x = wnd->x + x;
-    tb->y = wnd->y + y;
-    tb->w = 32;
-    tb->h = 16;
-    tb->visible = true;
-    tb->enabled = true;
-    tb->owned_by_window = true;
-    tb->checked = checked;
-    tb->parent = wnd;
+    u32 group = ed->undo[ed->undo_pos].group;
+    SDLUI_EditRecord* rec = NULL;
 
-    if (strlen(text) > 0)
+    while (ed->undo_pos < ed->num_undo && ed->undo[ed->undo_pos].group == group)
     {
-        tb->text.create(text);
-        SDL_Surface* s = TTF_RenderText_Blended(SDLUI_Font.handle, text, SDLUI_Core.theme.col_white);
-        tb->tex_text = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-        SDL_FreeSurface(s);
+        rec = &ed->undo[ed->undo_pos++];
+
+        if (rec->inserted)
+        {
+            SDLUI_TextEditorInsertRaw(ed, rec->pos, ed->undo_text + rec->text, rec->length);
+        }
+        else
+        {
+            SDLUI_TextEditorEraseRaw(ed, rec->pos, rec->length);
+        }
     }
-    else
+
+    i32 pos = rec->inserted ? rec->pos + rec->length : rec->pos;
+    ed->anchor = ed->cursor = 0;
+    SDLUI_TextEditorSetSelection(ed, pos, pos);
+    ed->last_edit = SDLUI_EDIT_KIND_NONE;
+    return true;
+}
+
+// Replaces all of the text. The buffer is filled with one copy and the lines found in one pass,
+// and the undo history starts over.
+void SDLUI_TextEditorSetText(SDLUI_Control_TextEditor* ed, const char* text, i32 length = -1)
+{
+    if (length < 0)
     {
-        tb->tex_text = NULL;
+        length = strlen(text);
     }
 
-    wnd->children.push(tb);
+    ed->buffer.destroy();
+    ed->buffer.create();
+    ed->lines.count = 1;
+    SDLUI_TextEditorInsertRaw(ed, 0, text, length);
+
+    ed->num_undo = 0;
+    ed->undo_pos = 0;
+    ed->undo_text_length = 0;
+    ed->last_edit = SDLUI_EDIT_KIND_NONE;
+
+    ed->first_line = 0;
+    ed->scroll_x = 0;
+    ed->anchor = ed->cursor = 0;
+    SDLUI_TextEditorSetSelection(ed, 0, 0);
+    SDLUI_TextEditorMarkLines(ed, 0, SDLUI_LAST_LINE);
+}
 
-    return tb;
+// All of the text as one string. The gap is moved to the end to make it contiguous, the pointer is
+// good until the next edit.
+const char* SDLUI_TextEditorGetText(SDLUI_Control_TextEditor* ed)
+{
+    SDLUI_GapBuffer* b = &ed->buffer;
+
+    b->move_gap(b->length());
+    b->reserve(1);
+    b->data[b->gap_start] = '\0';
+
+    return b->data;
 }
 
-SDLUI_ArrayOfControls SDLUI_CreateRadioButtonGroup()
+i32 SDLUI_TextEditorPreviousCodepoint(SDLUI_Control_TextEditor* ed, i32 pos)
 {
-    SDLUI_ArrayOfControls rb_group;
-    rb_group.create();
-    return rb_group;
+    do
+    {
+        pos--;
+    } while (pos > 0 && ((u8)ed->buffer.at(pos) & 0xC0) == 0x80);
+
+    return pos;
 }
 
-SDLUI_Control_RadioButton* SDLUI_CreateRadioButton(SDLUI_Control_Window* wnd, SDLUI_ArrayOfControls& group, i32 x, i32 y, char* text, bool checked)
+i32 SDLUI_TextEditorNextCodepoint(SDLUI_Control_TextEditor* ed, i32 pos)
 {
-    SDLUI_Control_RadioButton* rb = (SDLUI_Control_RadioButton*)malloc(sizeof(SDLUI_Control_RadioButton));
+    i32 length = ed->buffer.length();
 
-    rb->type = SDLUI_CONTROL_TYPE_RADIO_BUTTON;
-    rb->do_process = false;
-    rb->x = wnd->x + x;
-    rb->y = wnd->y + y;
-    rb->w = 16;
-    rb->h = 16;
-    rb->visible = true;
-    rb->enabled = true;
-    rb->owned_by_window = true;
-    rb->checked = checked;
-    rb->group = &group;
-    rb->group->push(rb);
-    rb->parent = wnd;
+    do
+    {
+        pos++;
+    } while (pos < length && ((u8)ed->buffer.at(pos) & 0xC0) == 0x80);
+
+    return pos;
+}
+
+// Byte offset under a point given relative to the text area. Points above or below it land on the lines there.
+i32 SDLUI_TextEditorOffsetAt(SDLUI_Control_TextEditor* ed, i32 x, i32 y)
+{
+    i32 row = y >= 0 ? y / ed->line_height : (y - ed->line_height + 1) / ed->line_height;
+    i32 line = SDLUI_Clamp(ed->first_line + row, 0, ed->lines.count - 1);
+    i32 length;
+    const char* text = SDLUI_TextEditorLine(ed, line, &length);
 
-    if (strlen(text) > 0)
+    return ed->lines.starts[line] + SDLUI_TextOffsetAtX(text, length, x + ed->scroll_x);
+}
+
+// Moves the cursor up or down by lines, staying as close as it can to the column it was in.
+void SDLUI_TextEditorMoveLines(SDLUI_Control_TextEditor* ed, i32 delta, bool extend)
+{
+    i32 line = ed->lines.line_of(ed->cursor);
+    i32 target = SDLUI_Clamp(line + delta, 0, ed->lines.count - 1);
+    i32 preferred_x = ed->preferred_x;
+    i32 pos;
+
+    if (target == line)
     {
-        rb->text.create(text);
-        SDL_Surface* s = TTF_RenderText_Blended(SDLUI_Font.handle, text, SDLUI_Core.theme.col_white);
-        rb->tex_text = SDL_CreateTextureFromSurface(SDLUI_Core.renderer, s);
-        SDL_FreeSurface(s);
+        pos = delta < 0 ? 0 : ed->buffer.length();
     }
     else
     {
-        rb->tex_text = NULL;
+        i32 length;
+        const char* text = SDLUI_TextEditorLine(ed, target, &length);
+        pos = ed->lines.starts[target] + SDLUI_TextOffsetAtX(text, length, preferred_x);
     }
 
-    wnd->children.push(rb);
-
-    return rb;
+    SDLUI_TextEditorSetCursor(ed, pos, extend);
+    ed->preferred_x = preferred_x;
+    ed->last_edit = SDLUI_EDIT_KIND_NONE;
 }
 
-SDLUI_Control_TabContainer* SDLUI_CreateTabContainer(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 w, i32 h)
+void SDLUI_TextEditorMoveCursor(SDLUI_Control_TextEditor* ed, i32 pos, bool extend)
 {
-    SDLUI_Control_TabContainer* tbc = (SDLUI_Control_TabContainer*)malloc(sizeof(SDLUI_Control_TabContainer));
-
-    tbc->type = SDLUI_CONTROL_TYPE_TAB_CONTAINER;
-    tbc->do_process = false;
-    tbc->tabs.create();
-    tbc->x = wnd->x + x;
-    tbc->y = wnd->y + y;
-    tbc->w = w;
-    tbc->h = h;
-    tbc->visible = true;
-    tbc->enabled = true;
-    tbc->owned_by_window = true;
-    tbc->bar_height = 30;
-    tbc->active_tab = NULL;
-    tbc->parent = wnd;
-
-    wnd->children.push(tbc);
-    return tbc;
-
+    SDLUI_TextEditorSetCursor(ed, pos, extend);
+    ed->last_edit = SDLUI_EDIT_KIND_NONE;
 }
 
-SDLUI_Control_ScrollArea* SDLUI_CreateScrollArea(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 w, i32 h, SDL_Texture* tex)
+// Queues the part of a line that is inside the text area. Glyphs left of it are stepped over without
+// being queued and nothing right of it is looked at, so very long lines cost no more than short ones.
+void SDLUI_TextEditorDrawLine(SDLUI_Control_TextEditor* ed, const char* text, i32 length, i32 y)
 {
-    SDLUI_Control_ScrollArea* sa = (SDLUI_Control_ScrollArea*)malloc(sizeof(SDLUI_Control_ScrollArea));
+    u32 previous = 0;
+    i32 pen = 0;
+    i32 start = 0;
 
-    sa->type = SDLUI_CONTROL_TYPE_SCROLL_AREA;
-    sa->do_process = false;
-    sa->x = wnd->x + x;
-    sa->y = wnd->y + y;
-    sa->w = w;
-    sa->h = h;
-    sa->visible = true;
-    sa->enabled = true;
-    sa->owned_by_window = true;
-    sa->scrollbar_thickness = 12;
-    sa->track_size_h = sa->w - sa->scrollbar_thickness;
-    sa->track_size_v = sa->h - sa->scrollbar_thickness;
-    sa->scroll_x = 0;
-    sa->scroll_y = 0;
-    sa->is_changing_v = false;
-    sa->is_changing_h = false;
-    sa->tex_rect = tex;
-    if (SDL_QueryTexture(sa->tex_rect, NULL, NULL, &sa->content_width, &sa->content_height) == 0)
+    while (start < length)
     {
-        if (sa->content_width > sa->w)
-        {
-            sa->client_height = sa->h - sa->scrollbar_thickness;
-        }
-        if (sa->content_height > sa->h)
+        i32 next = start;
+        u32 codepoint = previous;
+        i32 advance = SDLUI_GlyphAdvance(text, &next, &codepoint);
+
+        if (pen + advance > ed->scroll_x)
         {
-            sa->client_width = sa->w - sa->scrollbar_thickness;
+            break;
         }
+
+        pen += advance;
+        start = next;
+        previous = codepoint;
     }
-    else
+
+    i32 end = start;
+    i32 end_x = pen;
+    i32 right = ed->scroll_x + ed->text_width();
+
+    while (end < length && end_x < right)
     {
-        sa->client_width = sa->w;
-        sa->client_height = sa->h;
+        end_x += SDLUI_GlyphAdvance(text, &end, &previous);
     }
 
-    sa->parent = wnd;
-
-    wnd->children.push(sa);
-    return sa;
+    if (end > start)
+    {
+        SDLUI_DrawTextRange(pen - ed->scroll_x, y, text, start, end - start, ed->tex_text);
+    }
 }
 
-SDLUI_Control_List* SDLUI_CreateList(SDLUI_Control_Window* wnd, SDLUI_Control_ScrollArea* sa, i32 num_items)
+// Draws the rows of tex_text showing dirty lines, the other rows already show the right thing.
+void SDLUI_TextEditorRedraw(SDLUI_Control_TextEditor* ed)
 {
-    SDLUI_Control_List* lst = (SDLUI_Control_List*)malloc(sizeof(SDLUI_Control_List));
+    i32 lh = ed->line_height;
+    i32 first = ed->dirty_first > ed->first_line ? ed->dirty_first : ed->first_line;
+    i32 last = ed->first_line + ed->text_height() / lh;
+    last = ed->dirty_last < last ? ed->dirty_last : last;
 
-    lst->type = SDLUI_CONTROL_TYPE_LIST;
-    lst->do_process = false;
-    lst->scroll_area = sa;
-    lst->num_items = num_items;
-    lst->selected_index = 0;
-    lst->max_string_width = 0;
+    ed->dirty_first = SDLUI_LAST_LINE;
+    ed->dirty_last = -1;
 
-    i32 h = num_items * SDLUI_Font.height;
-    if (h < sa->h)
+    if (first > last)
     {
-        h = sa->h;
+        return;
     }
-    sa->tex_rect = SDL_CreateTexture(SDLUI_Core.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, sa->w, h);
-    sa->content_width = sa->w;
-    sa->content_height = h;
 
-    sa->client_height = sa->h - sa->scrollbar_thickness;
+    i32 sel_start = ed->selection_start();
+    i32 sel_end = ed->selection_end();
+
+    SDLUI_FlushText();
+    SDL_Texture* previous = SDL_GetRenderTarget(SDLUI_Core.renderer);
+    SDL_SetRenderTarget(SDLUI_Core.renderer, ed->tex_text);
 
-    if (SDL_QueryTexture(sa->tex_rect, NULL, NULL, &sa->content_width, &sa->content_height) == 0)
+    for (int line = first; line <= last; ++line)
     {
-        if (sa->content_width > sa->w)
-        {
-            sa->client_height = sa->h - sa->scrollbar_thickness;
-        }
-        if (sa->content_height > sa->h)
+        i32 row_y = (line - ed->first_line) * lh;
+
+        SDLUI_SetColor(SDLUI_Core.theme.col_textbox_bg);
+        SDL_Rect r = { 0, row_y, ed->text_width(), lh };
+        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+
+        if (line >= ed->lines.count)
         {
-            sa->client_width = sa->w - sa->scrollbar_thickness;
+            continue;
         }
-    }
-    else
-    {
-        sa->client_width = sa->w;
-        sa->client_height = sa->h;
-    }
-
-    return lst;
-}
 
-SDLUI_Control_TextBox* SDLUI_CreateTextBox(SDLUI_Control_Window* wnd, i32 x, i32 y, i32 w)
-{
-    SDLUI_Control_TextBox* tbx = (SDLUI_Control_TextBox*)malloc(sizeof(SDLUI_Control_TextBox));
+        i32 length;
+        const char* text = SDLUI_TextEditorLine(ed, line, &length);
+        i32 start = ed->lines.starts[line];
 
-    tbx->do_process = false;
+        if (sel_start != sel_end && sel_end > start && sel_start <= start + length)
+        {
+            i32 s0 = (sel_start > start ? sel_start : start) - start;
+            i32 s1 = (sel_end < start + length ? sel_end : start + length) - start;
+            i32 x0 = SDLUI_MeasureTextRange(text, 0, s0);
+            i32 x1 = x0 + SDLUI_MeasureTextRange(text, s0, s1 - s0);
 
-    tbx->type = SDLUI_CONTROL_TYPE_TEXTBOX;
-    tbx->do_process = false;
-    tbx->x = wnd->x + x;
-    tbx->y = wnd->y + y;
-    tbx->w = w;
-    tbx->h = 30;
-    tbx->visible = true;
-    tbx->enabled = true;
-    tbx->owned_by_window = true;
-    tbx->text.create("");
-    tbx->select_start = 0;
-    tbx->select_end = 0;
-    tbx->cursor_pos = 0;
-    tbx->focused = false;
-    tbx->scroll = 0;
-    tbx->max_chars = (w - (2 * SDLUI_MARGIN)) / SDLUI_Font.width;
+            // a selected newline shows as a little extra past the end of the line.
+            if (sel_end > start + length)
+            {
+                x1 += SDLUI_Font.width;
+            }
 
-    i32 tw = w - (2 * SDLUI_MARGIN);
-    i32 th = SDLUI_Font.height;
-    tbx->tex_text = SDL_CreateTexture(SDLUI_Core.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, tw, th);
+            SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
+            r = { x0 - ed->scroll_x, row_y, x1 - x0, lh };
+            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+        }
 
-    tbx->parent = wnd;
-    wnd->children.push(tbx);
+        SDLUI_TextEditorDrawLine(ed, text, length, row_y);
+    }
 
-    return tbx;
+    SDLUI_FlushText();
+    SDL_SetRenderTarget(SDLUI_Core.renderer, previous);
+    ed->dirty = true;
 }
 
-void SDLUI_EventHandler(SDL_Event const& ev)
+void SDLUI_TextEditorCopy(SDLUI_Control_TextEditor* ed)
 {
-    if (ev.type == SDL_MOUSEBUTTONDOWN || ev.type == SDL_MOUSEBUTTONUP)
+    i32 start = ed->selection_start();
+    i32 size = ed->selection_end() - start;
+
+    if (size > 0)
     {
-        SDLUI_MouseStateSet(ev.type, ev.button.button);
+        char* text = (char*)malloc(size + 1);
+        ed->buffer.copy(start, size, text);
+        text[size] = '\0';
+        SDL_SetClipboardText(text);
+        free(text);
     }
+}
+
+// Returns true when the text was changed this frame.
+bool SDLUI_TextEditor(SDLUI_Control_TextEditor* ed)
+{
+    ed->do_process = true;
+    bool changed = false;
 
-    if (ev.type == SDL_MOUSEWHEEL)
+    if (SDLUI_MouseButton(SDL_BUTTON_LEFT) != SDLUI_MOUSEBUTTON_HELD)
     {
-        SDLUI_Core.mouse_wheel_y = ev.wheel.y;
-        SDLUI_Core.mouse_wheel_x = ev.wheel.x;
+        ed->is_dragging = false;
+        ed->is_selecting = false;
     }
-    else
+
+    i32 mx = SDLUI_Input.mouse_x;
+    i32 my = SDLUI_Input.mouse_y;
+    SDL_Rect sr = SDLUI_GetScreenRect(ed);
+    i32 area_x = sr.x + SDLUI_MARGIN;
+    i32 area_y = sr.y + SDLUI_MARGIN;
+
+    if (ed->visible && ed->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
     {
-        SDLUI_Core.mouse_wheel_y = 0;
-        SDLUI_Core.mouse_wheel_x = 0;
+        SDL_Rect track = { sr.x + ed->w - ed->scrollbar_thickness, sr.y, ed->scrollbar_thickness, ed->h };
+        bool over_track = SDLUI_PointInRect(track, mx, my);
+
+        if (SDLUI_Core.hot_control == ed && !over_track)
+        {
+            SDL_SetCursor(SDLUI_Core.cursor_ibeam);
+        }
+        else
+        {
+            SDL_SetCursor(SDLUI_Core.cursor_arrow);
+        }
+
+        if (SDLUI_Core.hot_control == ed && SDLUI_Input.wheel_y != 0)
+        {
+            SDLUI_TextEditorScrollTo(ed, ed->first_line - SDLUI_Input.wheel_y * 3);
+            SDLUI_Input.wheel_y = 0;
+        }
+
+        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+        {
+            bool focused = SDLUI_Core.hot_control == ed;
+            ed->dirty |= focused != ed->focused;
+            ed->focused = focused;
+
+            if (focused && over_track)
+            {
+                i32 thumb_y = sr.y + ed->thumb_pos();
+
+                if (my < thumb_y || my > thumb_y + ed->thumb_size())
+                {
+                    // clicking the track jumps the thumb there.
+                    thumb_y = my - ed->thumb_size() / 2;
+                    SDLUI_TextEditorScrollTo(ed, SDLUI_Map(0, ed->h - ed->thumb_size(), 0, ed->max_first_line(), thumb_y - sr.y));
+                }
+
+                ed->drag_offset = my - (sr.y + ed->thumb_pos());
+                ed->is_dragging = true;
+            }
+            else if (focused)
+            {
+                bool extend = (SDL_GetModState() & KMOD_SHIFT) != 0;
+                SDLUI_TextEditorMoveCursor(ed, SDLUI_TextEditorOffsetAt(ed, mx - area_x, my - area_y), extend);
+                ed->is_selecting = true;
+            }
+        }
+
+        if (ed->is_dragging && ed->h > ed->thumb_size())
+        {
+            SDLUI_TextEditorScrollTo(ed, SDLUI_Map(0, ed->h - ed->thumb_size(), 0, ed->max_first_line(), my - ed->drag_offset - sr.y));
+        }
     }
 
-    if (ev.type == SDL_WINDOWEVENT)
+    // dragging a selection past the edges scrolls the text along with it.
+    if (ed->is_selecting)
     {
-        if (ev.window.event == SDL_WINDOWEVENT_RESIZED)
+        i32 pos = SDLUI_TextEditorOffsetAt(ed, mx - area_x, my - area_y);
+        if (pos != ed->cursor)
         {
-            SDLUI_ForceReDraw();
+            SDLUI_TextEditorSetCursor(ed, pos, true);
         }
     }
 
-    if (ev.type > 0)
+    if (ed->focused && ed->parent == SDLUI_Core.active_window)
     {
-        SDLUI_Core.e = ev;
+        for (int e = 0; e < SDLUI_Input.num_events; ++e)
+        {
+            SDL_Event* ev = &SDLUI_Input.events[e];
+
+            if (ev->type == SDL_TEXTINPUT)
+            {
+                SDLUI_TextEditorBeginEdit(ed, SDLUI_EDIT_KIND_TYPING);
+                SDLUI_TextEditorReplaceSelection(ed, ev->text.text, strlen(ev->text.text));
+                changed = true;
+            }
+
+            if (ev->type == SDL_KEYDOWN)
+            {
+                bool shift = (ev->key.keysym.mod & KMOD_SHIFT) != 0;
+                bool ctrl = (ev->key.keysym.mod & KMOD_CTRL) != 0;
+                bool selected = ed->anchor != ed->cursor;
+                i32 line = ed->lines.line_of(ed->cursor);
+
+                switch (ev->key.keysym.scancode)
+                {
+                case SDL_SCANCODE_LEFT:
+                    if (selected && !shift)
+                    {
+                        SDLUI_TextEditorMoveCursor(ed, ed->selection_start(), false);
+                    }
+                    else if (ed->cursor > 0)
+                    {
+                        SDLUI_TextEditorMoveCursor(ed, SDLUI_TextEditorPreviousCodepoint(ed, ed->cursor), shift);
+                    }
+                    break;
+
+                case SDL_SCANCODE_RIGHT:
+                    if (selected && !shift)
+                    {
+                        SDLUI_TextEditorMoveCursor(ed, ed->selection_end(), false);
+                    }
+                    else if (ed->cursor < ed->buffer.length())
+                    {
+                        SDLUI_TextEditorMoveCursor(ed, SDLUI_TextEditorNextCodepoint(ed, ed->cursor), shift);
+                    }
+                    break;
+
+                case SDL_SCANCODE_UP:
+                    SDLUI_TextEditorMoveLines(ed, -1, shift);
+                    break;
+
+                case SDL_SCANCODE_DOWN:
+                    SDLUI_TextEditorMoveLines(ed, 1, shift);
+                    break;
+
+                case SDL_SCANCODE_PAGEUP:
+                    SDLUI_TextEditorScrollTo(ed, ed->first_line - ed->visible_lines());
+                    SDLUI_TextEditorMoveLines(ed, -ed->visible_lines(), shift);
+                    break;
+
+                case SDL_SCANCODE_PAGEDOWN:
+                    SDLUI_TextEditorScrollTo(ed, ed->first_line + ed->visible_lines());
+                    SDLUI_TextEditorMoveLines(ed, ed->visible_lines(), shift);
+                    break;
+
+                case SDL_SCANCODE_HOME:
+                    SDLUI_TextEditorMoveCursor(ed, ctrl ? 0 : ed->lines.starts[line], shift);
+                    break;
+
+                case SDL_SCANCODE_END:
+                {
+                    i32 end = line + 1 < ed->lines.count ? ed->lines.starts[line + 1] - 1 : ed->buffer.length();
+                    SDLUI_TextEditorMoveCursor(ed, ctrl ? ed->buffer.length() : end, shift);
+                    break;
+                }
+
+                case SDL_SCANCODE_BACKSPACE:
+                    if (selected || ed->cursor > 0)
+                    {
+                        SDLUI_TextEditorBeginEdit(ed, SDLUI_EDIT_KIND_DELETING);
+                        SDLUI_TextEditorReplace(ed, selected ? ed->selection_start() : SDLUI_TextEditorPreviousCodepoint(ed, ed->cursor), ed->selection_end(), NULL, 0);
+                        changed = true;
+                    }
+                    break;
+
+                case SDL_SCANCODE_DELETE:
+                    if (selected || ed->cursor < ed->buffer.length())
+                    {
+                        SDLUI_TextEditorBeginEdit(ed, SDLUI_EDIT_KIND_DELETING);
+                        SDLUI_TextEditorReplace(ed, ed->selection_start(), selected ? ed->selection_end() : SDLUI_TextEditorNextCodepoint(ed, ed->cursor), NULL, 0);
+                        changed = true;
+                    }
+                    break;
+
+                case SDL_SCANCODE_RETURN:
+                case SDL_SCANCODE_KP_ENTER:
+                    SDLUI_TextEditorBeginEdit(ed, SDLUI_EDIT_KIND_TYPING);
+                    SDLUI_TextEditorReplaceSelection(ed, "\n", 1);
+                    changed = true;
+                    break;
+
+                case SDL_SCANCODE_A:
+                    if (ctrl)
+                    {
+                        SDLUI_TextEditorSetSelection(ed, 0, ed->buffer.length());
+                        ed->last_edit = SDLUI_EDIT_KIND_NONE;
+                    }
+                    break;
+
+                case SDL_SCANCODE_C:
+                    if (ctrl)
+                    {
+                        SDLUI_TextEditorCopy(ed);
+                    }
+                    break;
+
+                case SDL_SCANCODE_X:
+                    if (ctrl && selected)
+                    {
+                        SDLUI_TextEditorCopy(ed);
+                        SDLUI_TextEditorBeginEdit(ed, SDLUI_EDIT_KIND_NONE);
+                        SDLUI_TextEditorReplaceSelection(ed, NULL, 0);
+                        changed = true;
+                    }
+                    break;
+
+                case SDL_SCANCODE_V:
+                    if (ctrl)
+                    {
+                        char* clipboard = SDL_GetClipboardText();
+                        if (clipboard != NULL)
+                        {
+                            SDLUI_TextEditorBeginEdit(ed, SDLUI_EDIT_KIND_NONE);
+                            SDLUI_TextEditorReplaceSelection(ed, clipboard, strlen(clipboard));
+                            SDL_free(clipboard);
+                            changed = true;
+                        }
+                    }
+                    break;
+
+                case SDL_SCANCODE_Z:
+                    if (ctrl)
+                    {
+                        changed |= shift ? SDLUI_TextEditorRedo(ed) : SDLUI_TextEditorUndo(ed);
+                    }
+                    break;
+
+                case SDL_SCANCODE_Y:
+                    if (ctrl)
+                    {
+                        changed |= SDLUI_TextEditorRedo(ed);
+                    }
+                    break;
+
+                default:
+                    break;
+                }
+            }
+        }
     }
+
+    SDLUI_TextEditorRedraw(ed);
+
+    return changed;
 }
 
-bool SDLUI_Window(SDLUI_Control_Window* wnd)
+bool SDLUI_VirtualList(SDLUI_Control_VirtualList* vl, i32 num_items)
 {
-    if (!wnd->visible)
+    vl->do_process = true;
+
+    if (vl->num_items != num_items)
     {
-        return false;
+        vl->num_items = num_items;
+        vl->scroll_y = SDLUI_Clamp(vl->scroll_y, 0, vl->max_scroll());
+        vl->dirty = true;
     }
 
-    wnd->do_process = true;
-
-    if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_RELEASED || SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_NONE)
+    if (SDLUI_MouseButton(SDL_BUTTON_LEFT) != SDLUI_MOUSEBUTTON_HELD)
     {
-        wnd->is_dragged = false;
+        vl->is_dragging = false;
     }
 
-    if (wnd == SDLUI_Core.active_window)
+    if (vl->visible && vl->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
     {
-        i32 mx, my;
-        SDL_GetMouseState(&mx, &my);
+        i32 mx = SDLUI_Input.mouse_x;
+        i32 my = SDLUI_Input.mouse_y;
+        SDL_Rect sr = SDLUI_GetScreenRect(vl);
 
-        SDL_Rect r = { wnd->x, wnd->y, wnd->w, wnd->h };
+        SDL_Rect track = { sr.x + vl->w - vl->scrollbar_thickness, sr.y, vl->scrollbar_thickness, vl->h };
+        bool has_scrollbar = vl->content_height() > vl->h;
 
-        if (SDLUI_PointInRect(r, mx, my))
-        {
-            wnd->is_hovered = true;
-        }
-        else
+        if (SDLUI_Core.hot_control == vl && SDLUI_Input.wheel_y != 0)
         {
-            wnd->is_hovered = false;
+            vl->scroll_y -= SDLUI_Input.wheel_y * 3 * vl->item_height;
+            vl->scroll_y = SDLUI_Clamp(vl->scroll_y, 0, vl->max_scroll());
+            SDLUI_Input.wheel_y = 0;
+            vl->dirty = true;
         }
 
-        if (wnd->has_close_button)
+        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
         {
-            r = { wnd->x + wnd->w - 30, wnd->y, 30, 30 };
+            if (has_scrollbar && SDLUI_PointInRect(track, mx, my))
+            {
+                i32 thumb_y = sr.y + vl->thumb_pos();
 
-            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED && SDLUI_PointInRect(r, mx, my))
+                if (my < thumb_y || my > thumb_y + vl->thumb_size())
+                {
+                    // clicking the track jumps the thumb there.
+                    thumb_y = my - vl->thumb_size() / 2;
+                    vl->scroll_y = SDLUI_Map(0, vl->h - vl->thumb_size(), 0, vl->max_scroll(), thumb_y - sr.y);
+                    vl->scroll_y = SDLUI_Clamp(vl->scroll_y, 0, vl->max_scroll());
+                    vl->dirty = true;
+                }
+
+                vl->drag_offset = my - (sr.y + vl->thumb_pos());
+                vl->is_dragging = true;
+            }
+            else if (SDLUI_Core.hot_control == vl)
             {
-                wnd->visible = false;
-                SDLUI_Core.active_window = NULL;
+                i32 index = (my - sr.y + vl->scroll_y) / vl->item_height;
+
+                if (index < vl->num_items)
+                {
+                    vl->selected_index = index;
+                    vl->dirty = true;
+                    return true;
+                }
             }
         }
 
-        r = { wnd->x,wnd->y,wnd->w - (wnd->has_close_button * 30), 30 };
-
-        if (SDLUI_PointInRect(r, mx, my))
+        if (vl->is_dragging && vl->h > vl->thumb_size())
         {
-            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED && !wnd->is_dragged)
+            i32 scroll_y = SDLUI_Map(0, vl->h - vl->thumb_size(), 0, vl->max_scroll(), my - vl->drag_offset - sr.y);
+            scroll_y = SDLUI_Clamp(scroll_y, 0, vl->max_scroll());
+
+            if (scroll_y != vl->scroll_y)
             {
-                wnd->is_dragged = true;
-                wnd->drag_x = mx - wnd->x;
-                wnd->drag_y = my - wnd->y;
+                vl->scroll_y = scroll_y;
+                vl->dirty = true;
             }
         }
+    }
 
-        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD && wnd->is_dragged)
+    return false;
+}
+
+// Adds text to the log, one line per newline in it. Safe on any thread and never waits: if the log
+// is full the oldest line is overwritten, lines longer than SDLUI_LOG_LINE_SIZE are cut.
+void SDLUI_LogText(const char* text)
+{
+    while (*text != '\0')
+    {
+        const char* end = strchr(text, '\n');
+        i32 length = end != NULL ? (i32)(end - text) : (i32)strlen(text);
+
+        u32 ticket = (u32)SDL_AtomicAdd(&SDLUI_LogRing.head, 1);
+        SDLUI_LogLine* line = &SDLUI_LogRing.lines[ticket & (SDLUI_LOG_CAPACITY - 1)];
+
+        // readers skip the line while it reads 0, and notice if it changed while they were copying it.
+        SDL_AtomicSet(&line->sequence, 0);
+        line->length = length < SDLUI_LOG_LINE_SIZE - 1 ? length : SDLUI_LOG_LINE_SIZE - 1;
+        memcpy(line->text, text, line->length);
+        SDL_AtomicSet(&line->sequence, (int)(ticket + 1));
+
+        text += end != NULL ? length + 1 : length;
+    }
+}
+
+void SDLUI_Log(const char* format, ...)
+{
+    char text[SDLUI_LOG_LINE_SIZE];
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    SDLUI_LogText(text);
+}
+
+void SDLUI_ConsolePushMatch(SDLUI_Control_Console* con, u32 ticket)
+{
+    if (con->num_matches == SDLUI_LOG_CAPACITY)
+    {
+        con->match_start++;
+        con->num_matches--;
+    }
+
+    con->matches[(con->match_start + con->num_matches) & (SDLUI_LOG_CAPACITY - 1)] = ticket;
+    con->num_matches++;
+}
+
+// Drops matches whose lines were overwritten and checks up to SDLUI_LOG_SCAN_BUDGET new lines against the filter.
+// Returns true when the list of matches changed.
+bool SDLUI_ConsoleScan(SDLUI_Control_Console* con)
+{
+    u32 head = SDLUI_LogRing.next_ticket();
+    i32 dropped = 0;
+
+    while (con->num_matches > 0 && head - con->match(0) > SDLUI_LOG_CAPACITY)
+    {
+        con->match_start++;
+        con->num_matches--;
+        dropped++;
+    }
+
+    // lines that were overwritten before they were looked at are skipped.
+    if (head - con->scanned > SDLUI_LOG_CAPACITY)
+    {
+        con->scanned = head - SDLUI_LOG_CAPACITY;
+    }
+
+    char text[SDLUI_LOG_LINE_SIZE];
+    i32 length;
+    i32 added = 0;
+
+    for (int budget = SDLUI_LOG_SCAN_BUDGET; budget > 0 && con->scanned != head; --budget)
+    {
+        SDLUI_LOG_LINE_STATE state = SDLUI_LogRing.read(con->scanned, text, &length);
+
+        // the lines after one still being written wait for it, so they stay in order.
+        if (state == SDLUI_LOG_LINE_PENDING)
         {
-            SDL_SetCursor(SDLUI_Core.cursor_arrow);
-            i32 old_x = wnd->x;
-            i32 old_y = wnd->y;
-            wnd->x = mx - wnd->drag_x;
-            wnd->y = my - wnd->drag_y;
+            break;
+        }
 
-            for (int i = 0; i < wnd->children.size; ++i)
-            {
-                wnd->children.data[i]->x += wnd->x - old_x;
-                wnd->children.data[i]->y += wnd->y - old_y;
-            }
+        if (state == SDLUI_LOG_LINE_READY && strstr(text, con->filter) != NULL)
+        {
+            SDLUI_ConsolePushMatch(con, con->scanned);
+            added++;
         }
 
-        return false;
+        con->scanned++;
     }
 
-    return false;
+    // the rows left on screen stay where they are when older ones go.
+    con->scroll_y = SDLUI_Clamp(con->scroll_y - dropped * con->item_height, 0, con->max_scroll());
+
+    if (con->follow)
+    {
+        con->scroll_y = con->max_scroll();
+    }
+
+    return dropped > 0 || added > 0;
 }
 
-bool SDLUI_Button(SDLUI_Control_Button* btn)
+// Only lists lines containing filter. A filter containing the old one narrows down the lines already
+// matched, any other filter searches the whole log again a part per frame.
+void SDLUI_ConsoleSetFilter(SDLUI_Control_Console* con, const char* filter)
 {
-    btn->do_process = true;
+    if (strcmp(filter, con->filter) == 0)
+    {
+        return;
+    }
 
-    if (btn->visible && btn->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    bool narrower = strstr(filter, con->filter) != NULL;
+    i32 length = strlen(filter);
+    length = length < SDLUI_LOG_LINE_SIZE - 1 ? length : SDLUI_LOG_LINE_SIZE - 1;
+    memcpy(con->filter, filter, length);
+    con->filter[length] = '\0';
+
+    if (narrower)
     {
-        i32 mx, my;
-        SDL_GetMouseState(&mx, &my);
+        char text[SDLUI_LOG_LINE_SIZE];
+        i32 line_length;
+        i32 num_matches = con->num_matches;
+        con->num_matches = 0;
 
-        SDL_Rect r = { btn->x,btn->y,btn->w,btn->h };
-        if (SDLUI_PointInRect(r, mx, my))
+        for (int i = 0; i < num_matches; ++i)
         {
-            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
-            {
-                btn->state = SDLUI_BUTTON_STATE_CLICK;
-                return true;
-            }
-            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD)
-            {
-                btn->state = SDLUI_BUTTON_STATE_CLICK;
-            }
-            else
+            u32 ticket = con->matches[(con->match_start + i) & (SDLUI_LOG_CAPACITY - 1)];
+
+            if (SDLUI_LogRing.read(ticket, text, &line_length) == SDLUI_LOG_LINE_READY && strstr(text, con->filter) != NULL)
             {
-                btn->state = SDLUI_BUTTON_STATE_HOVER;
+                con->matches[(con->match_start + con->num_matches) & (SDLUI_LOG_CAPACITY - 1)] = ticket;
+                con->num_matches++;
             }
-
-            return false;
         }
-
-        btn->state = SDLUI_BUTTON_STATE_NORMAL;
-        return false;
+    }
+    else
+    {
+        u32 head = SDLUI_LogRing.next_ticket();
+        con->match_start = 0;
+        con->num_matches = 0;
+        con->scanned = head > SDLUI_LOG_CAPACITY ? head - SDLUI_LOG_CAPACITY : 0;
     }
 
-    btn->state = SDLUI_BUTTON_STATE_NORMAL;
-    return false;
+    con->scroll_y = SDLUI_Clamp(con->scroll_y, 0, con->max_scroll());
+    con->dirty = true;
 }
 
-bool SDLUI_SliderInt(SDLUI_Control_SliderInt* si)
+// Returns true when lines were added or went away this frame.
+bool SDLUI_Console(SDLUI_Control_Console* con)
 {
-    si->do_process = true;
+    con->do_process = true;
 
-    if (si->visible && si->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    bool changed = SDLUI_ConsoleScan(con);
+    con->dirty |= changed;
+
+    if (SDLUI_MouseButton(SDL_BUTTON_LEFT) != SDLUI_MOUSEBUTTON_HELD)
     {
-        i32 mx, my;
-        SDL_GetMouseState(&mx, &my);
+        con->is_dragging = false;
+    }
 
-        SDL_Rect r = { si->x,si->y,si->w,si->h };
-        if (SDLUI_PointInRect(r, mx, my))
-        {
-            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
-            {
-                // if(si->orientation == SDLUI_ORIENTATION_HORIZONTAL)
-                // {
-                // 	si->value = SDLUI_Map(si->x, si->x + si->w, si->min, si->max, mx);
-                // }
-                // else
-                // {
-                // 	si->value = SDLUI_Map(si->y + si->h, si->y, si->min, si->max, my);
-                // }
+    if (con->visible && con->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    {
+        i32 my = SDLUI_Input.mouse_y;
+        i32 mx = SDLUI_Input.mouse_x;
+        SDL_Rect sr = SDLUI_GetScreenRect(con);
+        SDL_Rect track = { sr.x + con->w - con->scrollbar_thickness, sr.y, con->scrollbar_thickness, con->h };
+        i32 scroll_y = con->scroll_y;
 
-                si->is_changing = true;
-            }
+        if (SDLUI_Core.hot_control == con && SDLUI_Input.wheel_y != 0)
+        {
+            scroll_y -= SDLUI_Input.wheel_y * 3 * con->item_height;
+            SDLUI_Input.wheel_y = 0;
         }
 
-        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD && si->is_changing)
+        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED && con->content_height() > con->h && SDLUI_PointInRect(track, mx, my))
         {
-            if (si->orientation == SDLUI_ORIENTATION_HORIZONTAL)
-            {
-                si->value = SDLUI_Map(si->x, si->x + si->w, si->min, si->max, mx);
-                si->value = SDLUI_Clamp(si->value, si->min, si->max);
-            }
-            else
+            i32 thumb_y = sr.y + con->thumb_pos();
+
+            if (my < thumb_y || my > thumb_y + con->thumb_size())
             {
-                si->value = SDLUI_Map(si->y + si->h, si->y, si->min, si->max, my);
-                si->value = SDLUI_Clamp(si->value, si->min, si->max);
+                thumb_y = my - con->thumb_size() / 2;
+                scroll_y = SDLUI_Map(0, con->h - con->thumb_size(), 0, con->max_scroll(), thumb_y - sr.y);
             }
 
-            // NOTE: Return here or on mouse release?
-            return true;
+            con->drag_offset = my - (sr.y + con->thumb_pos());
+            con->is_dragging = true;
         }
 
-        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_RELEASED && si->is_changing)
+        if (con->is_dragging && con->h > con->thumb_size())
         {
-            si->is_changing = false;
-            return true;
+            scroll_y = SDLUI_Map(0, con->h - con->thumb_size(), 0, con->max_scroll(), my - con->drag_offset - sr.y);
         }
 
-        return false;
+        scroll_y = SDLUI_Clamp(scroll_y, 0, con->max_scroll());
+        if (scroll_y != con->scroll_y)
+        {
+            con->scroll_y = scroll_y;
+
+            // scrolled back down to the end, new lines are followed again.
+            con->follow = scroll_y == con->max_scroll();
+            con->dirty = true;
+        }
     }
 
-    //si->is_changing = false;
-    return false;
+    return changed;
 }
 
-bool SDLUI_CheckBox(SDLUI_Control_CheckBox* chk)
+// Adds a sample, dropping the oldest once the plot holds capacity of them.
+void SDLUI_PlotPush(SDLUI_Control_Plot* plot, float value)
 {
-    chk->do_process = true;
+    plot->samples[plot->head] = value;
+    plot->head = (plot->head + 1) % plot->capacity;
+    plot->count = plot->count < plot->capacity ? plot->count + 1 : plot->capacity;
+    plot->geometry_dirty = true;
+    plot->dirty = true;
+}
 
-    if (chk->visible && chk->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
-    {
-        i32 mx, my;
-        SDL_GetMouseState(&mx, &my);
+void SDLUI_PlotClear(SDLUI_Control_Plot* plot)
+{
+    plot->count = 0;
+    plot->head = 0;
+    plot->geometry_dirty = true;
+    plot->dirty = true;
+}
 
-        i32 tex_w, tex_h;
-        SDL_QueryTexture(chk->tex_text, NULL, NULL, &tex_w, &tex_h);
+// Fixes the range the plot shows. With min equal to max it follows the samples instead.
+void SDLUI_PlotSetRange(SDLUI_Control_Plot* plot, float min, float max)
+{
+    plot->min = min;
+    plot->max = max;
+    plot->geometry_dirty = true;
+    plot->dirty = true;
+}
 
-        SDL_Rect r = { chk->x, chk->y, chk->w, chk->h };
-        if (chk->tex_text != NULL)
-        {
-            r.w += SDLUI_MARGIN + tex_w;
-        }
-        if (SDLUI_PointInRect(r, mx, my))
-        {
-            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
-            {
-                chk->checked = !chk->checked;
-                return true;
-            }
-        }
-        return false;
+// Returns true while the mouse is over the plot.
+bool SDLUI_Plot(SDLUI_Control_Plot* plot)
+{
+    plot->do_process = true;
+
+    return plot->visible && plot->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered && SDLUI_Core.hot_control == plot;
+}
+
+// Adds a row showing the value at value. It is read every time SDLUI_Inspector is called,
+// so it has to stay valid until the field is cleared or the window destroyed.
+void SDLUI_InspectorAddField(SDLUI_Control_Inspector* insp, const char* name, SDLUI_VALUE_TYPE value_type, const void* value)
+{
+    if (insp->num_fields == insp->capacity)
+    {
+        insp->capacity = insp->capacity > 0 ? insp->capacity * 2 : 16;
+        insp->fields = (SDLUI_InspectorField*)realloc(insp->fields, insp->capacity * sizeof(SDLUI_InspectorField));
+        insp->text = (char*)realloc(insp->text, insp->capacity * SDLUI_INSPECTOR_VALUE_SIZE);
     }
-    return false;
+
+    SDLUI_InspectorField* field = &insp->fields[insp->num_fields++];
+    field->name = SDLUI_StringTable.intern(name);
+    field->value_type = value_type;
+    field->value = value;
+    field->last = 0;
+    field->length = 0;
+    field->formatted = false;
+
+    // names are only measured here, the values start after the longest one.
+    i32 value_x = SDLUI_MARGIN + SDLUI_MeasureText(field->name) + SDLUI_MARGIN;
+    if (value_x > insp->value_x)
+    {
+        insp->value_x = value_x;
+    }
+
+    insp->dirty = true;
 }
 
-bool SDLUI_ToggleButton(SDLUI_Control_ToggleButton* tb)
+void SDLUI_InspectorClear(SDLUI_Control_Inspector* insp)
 {
-    tb->do_process = true;
+    insp->num_fields = 0;
+    insp->value_x = SDLUI_MARGIN;
+    insp->dirty = true;
+}
 
-    if (tb->visible && tb->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+// Checks every field for a new value and formats the ones that changed. Returns true if any of them did.
+bool SDLUI_Inspector(SDLUI_Control_Inspector* insp)
+{
+    insp->do_process = true;
+
+    bool changed = false;
+    for (i32 i = 0; i < insp->num_fields; ++i)
     {
-        i32 mx, my;
-        SDL_GetMouseState(&mx, &my);
+        SDLUI_InspectorField* field = &insp->fields[i];
 
-        i32 tex_w, tex_h;
-        SDL_QueryTexture(tb->tex_text, NULL, NULL, &tex_w, &tex_h);
+        u32 bits = 0;
+        switch (field->value_type)
+        {
+        case SDLUI_VALUE_TYPE_BOOL: bits = *(const bool*)field->value ? 1 : 0; break;
+        case SDLUI_VALUE_TYPE_INT: memcpy(&bits, field->value, sizeof(i32)); break;
+        case SDLUI_VALUE_TYPE_FLOAT: memcpy(&bits, field->value, sizeof(float)); break;
+        }
 
-        SDL_Rect r = { tb->x,tb->y,tb->w,tb->h };
-        if (tb->tex_text != NULL)
+        if (field->formatted && bits == field->last)
         {
-            r.w += SDLUI_MARGIN + tex_w;
+            continue;
         }
 
-        if (SDLUI_PointInRect(r, mx, my))
+        char* text = insp->field_text(i);
+        i32 length = 0;
+        switch (field->value_type)
         {
-            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
-            {
-                tb->checked = !tb->checked;
-                return true;
-            }
+        case SDLUI_VALUE_TYPE_BOOL: length = snprintf(text, SDLUI_INSPECTOR_VALUE_SIZE, "%s", bits ? "true" : "false"); break;
+        case SDLUI_VALUE_TYPE_INT: length = snprintf(text, SDLUI_INSPECTOR_VALUE_SIZE, "%d", *(const i32*)field->value); break;
+        case SDLUI_VALUE_TYPE_FLOAT: length = snprintf(text, SDLUI_INSPECTOR_VALUE_SIZE, "%.3f", *(const float*)field->value); break;
         }
 
-        return false;
+        field->length = length < SDLUI_INSPECTOR_VALUE_SIZE ? length : SDLUI_INSPECTOR_VALUE_SIZE - 1;
+        field->last = bits;
+        field->formatted = true;
+        changed = true;
     }
-    return false;
-}
 
-bool SDLUI_RadioButton(SDLUI_Control_RadioButton* rb)
-{
-    rb->do_process = true;
-
-    if (rb->visible && rb->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    if (changed)
     {
-        i32 mx, my;
-        SDL_GetMouseState(&mx, &my);
-
-        i32 tex_w, tex_h;
-        SDL_QueryTexture(rb->tex_text, NULL, NULL, &tex_w, &tex_h);
+        insp->dirty = true;
+    }
 
-        SDL_Rect r = { rb->x,rb->y,rb->w,rb->h };
-        if (rb->tex_text != NULL)
-        {
-            r.w += SDLUI_MARGIN + tex_w;
-        }
+    return changed;
+}
 
-        if (SDLUI_PointInRect(r, mx, my))
-        {
-            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
-            {
-                SDLUI_Control_RadioButton* cur;
+// A layout for wnd, allocated with the window. Give it to SDLUI_SetWindowLayout or add it to another layout.
+SDLUI_Layout* SDLUI_CreateLayout(SDLUI_Control_Window* wnd, SDLUI_LAYOUT_TYPE type, i32 columns = 1)
+{
+    SDLUI_Layout* layout = (SDLUI_Layout*)wnd->arena.alloc(sizeof(SDLUI_Layout));
+
+    layout->type = type;
+    layout->window = wnd;
+    layout->item = NULL;
+    layout->first = NULL;
+    layout->last = NULL;
+    layout->num_items = 0;
+    layout->spacing = SDLUI_MARGIN;
+    layout->padding = 0;
+    layout->columns = columns < 1 ? 1 : columns;
+    layout->rect = { 0, 0, 0, 0 };
+    layout->measured_w = 0;
+    layout->measured_h = 0;
+    layout->measure_dirty = true;
+    layout->arrange_dirty = true;
+
+    return layout;
+}
 
-                for (int i = 0; i < rb->group->size; ++i)
-                {
-                    cur = (SDLUI_Control_RadioButton*)rb->group->data[i];
-                    cur->checked = false;
-                }
+// Makes layout fill the client area of its window, it is rearranged whenever the window is resized.
+void SDLUI_SetWindowLayout(SDLUI_Control_Window* wnd, SDLUI_Layout* layout)
+{
+    layout->padding = SDLUI_MARGIN;
+    layout->arrange_dirty = true;
+    wnd->root_layout = layout;
+}
 
-                rb->checked = true;
+// Marks a layout and everything above it for measuring again. Stops at the first one already marked,
+// everything above that is marked too.
+void SDLUI_InvalidateLayoutChain(SDLUI_Layout* layout)
+{
+    while (layout != NULL && !layout->measure_dirty)
+    {
+        layout->measure_dirty = true;
+        layout->arrange_dirty = true;
 
-                return true;
-            }
+        if (layout->item == NULL)
+        {
+            break;
         }
 
-        return false;
+        layout->item->measured = false;
+        layout = layout->item->owner;
     }
-    return false;
 }
 
-bool SDLUI_Text(SDLUI_Control_Text* txt)
+// Call when something changed the size a control wants, like its text.
+void SDLUI_InvalidateLayout(SDLUI_Control* ctrl)
 {
-    txt->do_process = true;
+    if (ctrl->layout_item == NULL)
+    {
+        return;
+    }
 
-    if (txt->visible && txt->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    ctrl->layout_item->measured = false;
+    SDLUI_InvalidateLayoutChain(ctrl->layout_item->owner);
+}
+
+SDLUI_LayoutItem* SDLUI_LayoutAddItem(SDLUI_Layout* layout, SDLUI_SIZE_RULE width_rule, SDLUI_SIZE_RULE height_rule, i32 weight)
+{
+    SDLUI_LayoutItem* item = (SDLUI_LayoutItem*)layout->window->arena.alloc(sizeof(SDLUI_LayoutItem));
+
+    item->owner = layout;
+    item->ctrl = NULL;
+    item->layout = NULL;
+    item->width_rule = width_rule;
+    item->height_rule = height_rule;
+    item->weight = weight < 1 ? 1 : weight;
+    item->natural_w = 0;
+    item->natural_h = 0;
+    item->measured = false;
+    item->next = NULL;
+
+    if (layout->last == NULL)
     {
-        return true;
+        layout->first = item;
     }
-    return false;
+    else
+    {
+        layout->last->next = item;
+    }
+    layout->last = item;
+    layout->num_items++;
+
+    layout->measure_dirty = false;
+    SDLUI_InvalidateLayoutChain(layout);
+
+    return item;
 }
 
-bool SDLUI_TabContainer(SDLUI_Control_TabContainer* tbc)
+// Adds a control of the layout's window. Fill makes it stretch over the space its siblings leave,
+// shared out by weight along the direction of the layout.
+void SDLUI_LayoutAdd(SDLUI_Layout* layout, SDLUI_Control* ctrl, SDLUI_SIZE_RULE width_rule = SDLUI_SIZE_AUTO, SDLUI_SIZE_RULE height_rule = SDLUI_SIZE_AUTO, i32 weight = 1)
 {
-    tbc->do_process = true;
+    SDLUI_LayoutItem* item = SDLUI_LayoutAddItem(layout, width_rule, height_rule, weight);
+    item->ctrl = ctrl;
+    ctrl->layout_item = item;
+
+    // what the control was created with is its smallest size when it fills.
+    SDL_Rect bounds = SDLUI_GetControlBounds(ctrl);
+    item->natural_w = bounds.w;
+    item->natural_h = bounds.h;
+}
 
-    if (tbc->visible && tbc->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+void SDLUI_LayoutAddLayout(SDLUI_Layout* layout, SDLUI_Layout* child, SDLUI_SIZE_RULE width_rule = SDLUI_SIZE_AUTO, SDLUI_SIZE_RULE height_rule = SDLUI_SIZE_AUTO, i32 weight = 1)
+{
+    SDLUI_LayoutItem* item = SDLUI_LayoutAddItem(layout, width_rule, height_rule, weight);
+    item->layout = child;
+    child->item = item;
+}
+
+void SDLUI_MeasureLayout(SDLUI_Layout* layout)
+{
+    if (!layout->measure_dirty)
     {
-        i32 mx, my;
-        SDL_GetMouseState(&mx, &my);
-        SDL_Rect r = { tbc->x,tbc->y,tbc->w,tbc->bar_height };
-        SDL_Rect tab_r;
-        i32 offset = 0;
-        SDLUI_Control_Tab* tab;
+        return;
+    }
 
-        if (SDLUI_PointInRect(r, mx, my))
+    i32 cols = layout->type == SDLUI_LAYOUT_GRID ? layout->columns : 1;
+    i32 col_w[64] = { 0 };
+    i32 index = 0;
+    i32 row_h = 0;
+    i32 total_w = 0;
+    i32 total_h = 0;
+
+    for (SDLUI_LayoutItem* item = layout->first; item != NULL; item = item->next, ++index)
+    {
+        if (!item->measured)
         {
-            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+            if (item->layout != NULL)
             {
-                for (int i = 0; i < tbc->tabs.size; ++i)
+                SDLUI_MeasureLayout(item->layout);
+                item->natural_w = item->layout->measured_w;
+                item->natural_h = item->layout->measured_h;
+            }
+            else
+            {
+                // a filled axis keeps the size it had when it was added, the control's current one is the stretched size.
+                SDL_Rect bounds = SDLUI_GetControlBounds(item->ctrl);
+                if (item->width_rule == SDLUI_SIZE_AUTO)
                 {
-                    tab = (SDLUI_Control_Tab*)tbc->tabs.data[i];
-                    tab_r = { tbc->x + offset, tbc->y, tab->w + SDLUI_MARGIN, 30 };
+                    item->natural_w = bounds.w;
+                }
+                if (item->height_rule == SDLUI_SIZE_AUTO)
+                {
+                    item->natural_h = bounds.h;
+                }
+            }
+            item->measured = true;
+        }
 
-                    if (SDLUI_PointInRect(tab_r, mx, my))
-                    {
-                        for (int j = 0; j < tbc->active_tab->children.size; ++j)
-                        {
-                            SDLUI_Control* ctrl = tbc->active_tab->children.data[j];
-                            ctrl->visible = false;
-                        }
-                        tbc->active_tab = tab;
-                    }
+        if (layout->type == SDLUI_LAYOUT_VERTICAL)
+        {
+            total_w = SDLUI_Max(total_w, item->natural_w);
+            total_h += item->natural_h + (index > 0 ? layout->spacing : 0);
+        }
+        else if (layout->type == SDLUI_LAYOUT_HORIZONTAL)
+        {
+            total_w += item->natural_w + (index > 0 ? layout->spacing : 0);
+            total_h = SDLUI_Max(total_h, item->natural_h);
+        }
+        else
+        {
+            i32 col = index % cols;
+            if (col < 64)
+            {
+                col_w[col] = SDLUI_Max(col_w[col], item->natural_w);
+            }
+            row_h = SDLUI_Max(row_h, item->natural_h);
 
-                    offset += SDLUI_MARGIN + tab->w;
-                }
+            if (col == cols - 1 || item->next == NULL)
+            {
+                total_h += row_h + (index >= cols ? layout->spacing : 0);
+                row_h = 0;
             }
         }
     }
-    return false;
+
+    if (layout->type == SDLUI_LAYOUT_GRID)
+    {
+        for (int i = 0; i < cols && i < 64; ++i)
+        {
+            total_w += col_w[i] + (i > 0 ? layout->spacing : 0);
+        }
+    }
+
+    layout->measured_w = total_w + 2 * layout->padding;
+    layout->measured_h = total_h + 2 * layout->padding;
+    layout->measure_dirty = false;
 }
 
-bool SDLUI_ScrollArea(SDLUI_Control_ScrollArea* sa)
+// Moves and sizes a control that a layout owns, keeping what depends on its size up to date.
+void SDLUI_PlaceControl(SDLUI_Control* ctrl, SDL_Rect r)
 {
-    sa->do_process = true;
+    // the rect includes labels drawn next to the control, which are not part of its own width.
+    SDL_Rect bounds = SDLUI_GetControlBounds(ctrl);
+    i32 w = r.w - (bounds.w - ctrl->w);
+    i32 h = r.h - (bounds.h - ctrl->h);
 
-    if (sa->visible && sa->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    if (ctrl->x == r.x && ctrl->y == r.y && ctrl->w == w && ctrl->h == h)
     {
-        i32 mx, my;
-        SDL_GetMouseState(&mx, &my);
-        SDL_Rect r, rv, rh;
+        return;
+    }
 
-        r = { sa->x, sa->y, sa->w, sa->h };
+    bool resized = ctrl->w != w || ctrl->h != h;
 
-        if (sa->content_height > sa->h)
-        {
-            if (SDLUI_PointInRect(r, mx, my))
-            {
-                // mouse wheel vertical
-                if (SDLUI_Core.mouse_wheel_y != 0)
-                {
-                    sa->scroll_y -= SDLUI_Core.mouse_wheel_y;
-                    sa->scroll_y = SDLUI_Clamp(sa->scroll_y, 0, sa->track_size_v - sa->thumb_size_v);
-                    SDLUI_Core.mouse_wheel_y = 0;
-                    return true;
-                }
-            }
+    SDLUI_Invalidate(ctrl);
+    ctrl->x = r.x;
+    ctrl->y = r.y;
+    ctrl->w = w;
+    ctrl->h = h;
+    SDLUI_Invalidate(ctrl);
+    SDLUI_Core.layout_generation++;
 
-            static i32 my_offset;
+    if (!resized)
+    {
+        return;
+    }
 
-            rv = { sa->x + sa->w - sa->scrollbar_thickness, sa->y + sa->scroll_y, sa->scrollbar_thickness, sa->thumb_size_v };
-            if (SDLUI_PointInRect(rv, mx, my))
-            {
-                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
-                {
-                    my_offset = my - sa->scroll_y;
-                    sa->is_changing_v = true;
-                }
-            }
+    if (ctrl->type == SDLUI_CONTROL_TYPE_SCROLL_AREA)
+    {
+        SDLUI_Control_ScrollArea* sa = (SDLUI_Control_ScrollArea*)ctrl;
+        sa->track_size_h = sa->w - sa->scrollbar_thickness;
+        sa->track_size_v = sa->h - sa->scrollbar_thickness;
+        SDLUI_UpdateScrollAreaClient(sa);
+    }
+    else if (ctrl->type == SDLUI_CONTROL_TYPE_TEXTBOX)
+    {
+        SDLUI_Control_TextBox* tbx = (SDLUI_Control_TextBox*)ctrl;
+        tbx->tex_text = SDLUI_ResizeTarget(tbx->tex_text, SDLUI_Max(1, w - (2 * SDLUI_MARGIN)), SDLUI_Font.height);
+        SDLUI_UpdateTextBoxText(tbx);
+    }
+    else if (ctrl->type == SDLUI_CONTROL_TYPE_VIRTUAL_LIST)
+    {
+        SDLUI_Control_VirtualList* vl = (SDLUI_Control_VirtualList*)ctrl;
+        vl->scroll_y = SDLUI_Clamp(vl->scroll_y, 0, vl->max_scroll());
+    }
+    else if (ctrl->type == SDLUI_CONTROL_TYPE_PLOT)
+    {
+        ((SDLUI_Control_Plot*)ctrl)->geometry_dirty = true;
+    }
+    else if (ctrl->type == SDLUI_CONTROL_TYPE_CONSOLE)
+    {
+        SDLUI_Control_Console* con = (SDLUI_Control_Console*)ctrl;
+        con->scroll_y = con->follow ? con->max_scroll() : SDLUI_Clamp(con->scroll_y, 0, con->max_scroll());
+    }
+    else if (ctrl->type == SDLUI_CONTROL_TYPE_TEXT_EDITOR)
+    {
+        SDLUI_Control_TextEditor* ed = (SDLUI_Control_TextEditor*)ctrl;
+        ed->tex_text = SDLUI_ResizeTarget(ed->tex_text, ed->text_width(), ed->text_height());
+        ed->first_line = SDLUI_Clamp(ed->first_line, 0, ed->max_first_line());
+        SDLUI_TextEditorMarkLines(ed, 0, SDLUI_LAST_LINE);
+    }
+}
+
+void SDLUI_ArrangeLayout(SDLUI_Layout* layout, SDL_Rect rect)
+{
+    if (!layout->arrange_dirty && SDL_RectEquals(&rect, &layout->rect))
+    {
+        return;
+    }
 
-            // scroll per page
-            rv.y = sa->y;
-            rv.h = sa->scroll_y;
+    layout->rect = rect;
+    layout->arrange_dirty = false;
 
-            if (SDLUI_PointInRect(rv, mx, my))
-            {
-                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
-                {
-                    float pages = (float)sa->content_height / (float)sa->h;
-                    float pixels_per_page = (float)sa->track_size_v / pages;
-                    sa->scroll_y -= pixels_per_page;
-                    sa->scroll_y = SDLUI_Clamp(sa->scroll_y, 0, sa->track_size_v - sa->thumb_size_v);
-                    return true;
-                }
-            }
+    i32 inner_x = rect.x + layout->padding;
+    i32 inner_y = rect.y + layout->padding;
+    i32 inner_w = rect.w - 2 * layout->padding;
+    i32 inner_h = rect.h - 2 * layout->padding;
 
-            rv.y = sa->y + sa->scroll_y + sa->thumb_size_v;
-            rv.h = sa->track_size_v - sa->thumb_size_v - sa->scroll_y;
+    if (layout->type == SDLUI_LAYOUT_GRID)
+    {
+        i32 cols = layout->columns < 64 ? layout->columns : 64;
+        i32 col_w[64] = { 0 };
+        bool col_fill[64] = { false };
+        i32 index = 0;
 
-            if (SDLUI_PointInRect(rv, mx, my))
+        for (SDLUI_LayoutItem* item = layout->first; item != NULL; item = item->next, ++index)
+        {
+            i32 col = index % layout->columns;
+            if (col < cols)
             {
-                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
-                {
-                    float pages = (float)sa->content_height / (float)sa->h;
-                    float pixels_per_page = (float)sa->track_size_v / pages;
-                    sa->scroll_y += pixels_per_page;
-                    sa->scroll_y = SDLUI_Clamp(sa->scroll_y, 0, sa->track_size_v - sa->thumb_size_v);
-                    return true;
-                }
+                col_w[col] = SDLUI_Max(col_w[col], item->natural_w);
+                col_fill[col] |= item->width_rule == SDLUI_SIZE_FILL;
             }
+        }
 
-            if (sa->is_changing_v)
-            {
-                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD)
-                {
-                    sa->scroll_y = my - my_offset;
-                    sa->scroll_y = SDLUI_Clamp(sa->scroll_y, 0, sa->track_size_v - sa->thumb_size_v);
-                }
-
-                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_RELEASED)
-                {
-                    sa->is_changing_v = false;
-                    return true;
-                }
-            }
+        // columns holding a filling item share whatever width is left over.
+        i32 used = (cols - 1) * layout->spacing;
+        i32 num_fill = 0;
+        for (int i = 0; i < cols; ++i)
+        {
+            used += col_w[i];
+            num_fill += col_fill[i];
         }
 
-        if (sa->content_width > sa->w)
+        i32 extra = inner_w - used;
+        for (int i = 0; i < cols && num_fill > 0 && extra > 0; ++i)
         {
-            if (SDLUI_PointInRect(r, mx, my))
+            if (col_fill[i])
             {
-                // mouse wheel horizontal
-                if (SDLUI_Core.mouse_wheel_x != 0)
-                {
-                    sa->scroll_x += SDLUI_Core.mouse_wheel_x;
-                    sa->scroll_x = SDLUI_Clamp(sa->scroll_x, 0, sa->track_size_h - sa->thumb_size_h);
-                    SDLUI_Core.mouse_wheel_x = 0;
-                    return true;
-                }
+                col_w[i] += extra / num_fill;
             }
+        }
 
-            static i32 mx_offset;
+        i32 y = inner_y;
+        i32 row_h = 0;
+        i32 x = inner_x;
+        SDLUI_LayoutItem* row_first = layout->first;
+        index = 0;
 
-            rh = { sa->x + sa->scroll_x, sa->y + sa->h - sa->scrollbar_thickness, sa->thumb_size_h, sa->scrollbar_thickness };
-            if (SDLUI_PointInRect(rh, mx, my))
+        for (SDLUI_LayoutItem* item = layout->first; item != NULL; item = item->next, ++index)
+        {
+            i32 col = index % layout->columns;
+            if (col == 0)
             {
-                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+                // the row is as tall as its tallest item.
+                row_h = 0;
+                x = inner_x;
+                row_first = item;
+                i32 n = 0;
+                for (SDLUI_LayoutItem* it = row_first; it != NULL && n < layout->columns; it = it->next, ++n)
                 {
-                    mx_offset = mx - sa->scroll_x;
-                    sa->is_changing_h = true;
+                    row_h = SDLUI_Max(row_h, it->natural_h);
                 }
             }
 
-            // scroll per page
-            rh.x = sa->x;
-            rh.w = sa->scroll_x;
+            i32 cw = col < cols ? col_w[col] : item->natural_w;
+            SDL_Rect r = { x, y, item->width_rule == SDLUI_SIZE_FILL ? cw : item->natural_w, item->height_rule == SDLUI_SIZE_FILL ? row_h : item->natural_h };
 
-            if (SDLUI_PointInRect(rh, mx, my))
+            if (item->layout != NULL)
             {
-                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
-                {
-                    float pages = (float)sa->content_width / (float)sa->w;
-                    float pixels_per_page = (float)sa->track_size_h / pages;
-                    sa->scroll_x -= pixels_per_page;
-                    sa->scroll_x = SDLUI_Clamp(sa->scroll_x, 0, sa->track_size_h - sa->thumb_size_h);
-                    return true;
-                }
+                SDLUI_ArrangeLayout(item->layout, r);
             }
-
-            rh.x = sa->x + sa->scroll_x + sa->thumb_size_h;
-            rh.w = sa->track_size_h - sa->thumb_size_h - sa->scroll_x;
-
-            if (SDLUI_PointInRect(rh, mx, my))
+            else
             {
-                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
-                {
-                    float pages = (float)sa->content_width / (float)sa->w;
-                    float pixels_per_page = (float)sa->track_size_h / pages;
-                    sa->scroll_x += pixels_per_page;
-                    sa->scroll_x = SDLUI_Clamp(sa->scroll_x, 0, sa->track_size_h - sa->thumb_size_h);
-                    return true;
-                }
+                SDLUI_PlaceControl(item->ctrl, r);
             }
 
-            if (sa->is_changing_h)
-            {
-                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_HELD)
-                {
-                    sa->scroll_x = mx - mx_offset;
-                    sa->scroll_x = SDLUI_Clamp(sa->scroll_x, 0, sa->track_size_h - sa->thumb_size_h);
-                }
+            x += cw + layout->spacing;
 
-                if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_RELEASED)
-                {
-                    sa->is_changing_h = false;
-                    return true;
-                }
+            if (col == layout->columns - 1)
+            {
+                y += row_h + layout->spacing;
             }
-
         }
-        return false;
+
+        return;
     }
-    return false;
-}
 
-bool SDLUI_List(SDLUI_Control_List* lst, const char* cur_item, i32 num_items, i32 cur_index)
-{
-    lst->do_process = true;
+    bool vertical = layout->type == SDLUI_LAYOUT_VERTICAL;
+    i32 main_size = vertical ? inner_h : inner_w;
+    i32 cross_size = vertical ? inner_w : inner_h;
 
-    static i32 clicked;
+    // space along the main axis that the items don't need, shared out between the filling ones.
+    i32 used = (layout->num_items - 1) * layout->spacing;
+    i32 total_weight = 0;
 
-    if (lst->scroll_area->visible && lst->scroll_area->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    for (SDLUI_LayoutItem* item = layout->first; item != NULL; item = item->next)
     {
-        i32 mx, my;
-        SDL_GetMouseState(&mx, &my);
-        SDL_Rect r = { lst->scroll_area->x, lst->scroll_area->y, lst->scroll_area->client_width, lst->scroll_area->client_height };
-
-        if (SDLUI_PointInRect(r, mx, my) && cur_index == 0)
+        used += vertical ? item->natural_h : item->natural_w;
+        if ((vertical ? item->height_rule : item->width_rule) == SDLUI_SIZE_FILL)
         {
-            if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
-            {
-                float ratio = (float)lst->scroll_area->content_height / (float)lst->scroll_area->client_height;
-                float oy = my - lst->scroll_area->y + ((float)lst->scroll_area->scroll_y * ratio);
-                lst->selected_index = oy / SDLUI_Font.height;
-                clicked = true;
-            }
+            total_weight += item->weight;
         }
     }
 
-    if (lst->num_items != num_items)
+    i32 extra = SDLUI_Max(0, main_size - used);
+    i32 pos = vertical ? inner_y : inner_x;
+
+    for (SDLUI_LayoutItem* item = layout->first; item != NULL; item = item->next)
     {
-        lst->num_items = num_items;
-        SDL_DestroyTexture(lst->scroll_area->tex_rect);
-        i32 h = num_items * SDLUI_Font.height;
+        i32 main = vertical ? item->natural_h : item->natural_w;
+        i32 cross = vertical ? item->natural_w : item->natural_h;
 
-        if (h < lst->scroll_area->h)
+        if ((vertical ? item->height_rule : item->width_rule) == SDLUI_SIZE_FILL && total_weight > 0)
         {
-            h = lst->scroll_area->h;
+            main += extra * item->weight / total_weight;
         }
 
-        lst->scroll_area->tex_rect = SDL_CreateTexture(SDLUI_Core.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, lst->scroll_area->w, h);
-        lst->scroll_area->content_width = lst->scroll_area->w;
-        lst->scroll_area->content_height = h;
-    }
-
-    static i32 counter;
+        if ((vertical ? item->width_rule : item->height_rule) == SDLUI_SIZE_FILL)
+        {
+            cross = cross_size;
+        }
 
-    if (counter == 0)
-    {
-        SDLUI_SetColor(SDLUI_Core.theme.col_list_bg);
-        SDL_Rect r = { 0, 0, lst->scroll_area->content_width, lst->scroll_area->content_height };
-        SDL_SetRenderTarget(SDLUI_Core.renderer, lst->scroll_area->tex_rect);
-        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
-        SDL_SetRenderTarget(SDLUI_Core.renderer, NULL);
-    }
+        SDL_Rect r = vertical ? SDL_Rect{ inner_x, pos, cross, main } : SDL_Rect{ pos, inner_y, main, cross };
 
-    if (counter == lst->selected_index)
-    {
-        SDL_SetRenderTarget(SDLUI_Core.renderer, lst->scroll_area->tex_rect);
-        SDLUI_SetColor(SDLUI_Core.theme.col_highlight);
+        if (item->layout != NULL)
+        {
+            SDLUI_ArrangeLayout(item->layout, r);
+        }
+        else
+        {
+            SDLUI_PlaceControl(item->ctrl, r);
+        }
 
-        float ratio = (float)lst->scroll_area->content_width / (float)lst->scroll_area->client_width;
-        i32 offset_x = lst->scroll_area->scroll_x * ratio;
-        SDL_Rect r = { offset_x, lst->selected_index * SDLUI_Font.height, lst->scroll_area->w, SDLUI_Font.height };
-        SDL_RenderFillRect(SDLUI_Core.renderer, &r);
+        pos += main + layout->spacing;
     }
+}
 
-    if (strlen(cur_item) * SDLUI_Font.width > lst->max_string_width)
+// Measures what was invalidated and arranges the window's layout over its client area.
+// Called by SDLUI_Window, costs next to nothing when nothing changed.
+void SDLUI_UpdateLayout(SDLUI_Control_Window* wnd)
+{
+    if (wnd->root_layout == NULL)
     {
-        lst->max_string_width = strlen(cur_item) * SDLUI_Font.width;
+        return;
     }
-    i32 cur_tex_width;
-    SDL_QueryTexture(lst->scroll_area->tex_rect, NULL, NULL, &cur_tex_width, NULL);
 
-    if (lst->max_string_width > cur_tex_width)
+    SDLUI_MeasureLayout(wnd->root_layout);
+
+    SDL_Rect client = { 0, 30, wnd->w, wnd->h - 30 };
+    SDLUI_ArrangeLayout(wnd->root_layout, client);
+}
+
+// Hands a recorded list to the UI thread, which runs it in SDLUI_WindowHandler. Safe to call from any thread
+// after SDLUI_Init. The commands are moved out, list is left empty and can be recorded into again.
+void SDLUI_SubmitCommands(SDLUI_CommandList* list)
+{
+    if (list->num_commands == 0)
     {
-        SDL_DestroyTexture(lst->scroll_area->tex_rect);
-        i32 h = num_items * SDLUI_Font.height;
-        if (h < lst->scroll_area->h)
-        {
-            h = lst->scroll_area->h;
-        }
-        lst->scroll_area->tex_rect = SDL_CreateTexture(SDLUI_Core.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, lst->max_string_width, h);
-        lst->scroll_area->content_width = lst->max_string_width;
-        lst->scroll_area->content_height = h;
+        return;
     }
 
-    static i32 offset_y;
+    SDLUI_CommandList* submitted = (SDLUI_CommandList*)malloc(sizeof(SDLUI_CommandList));
+    *submitted = *list;
+    submitted->next = NULL;
+    list->create();
 
-    SDLUI_DrawText(SDLUI_MARGIN, offset_y, cur_item, lst->scroll_area->tex_rect);
-    offset_y += SDLUI_Font.height;
-    counter++;
+    SDL_LockMutex(SDLUI_CommandQueue.mutex);
 
-    if (counter == num_items)
+    if (SDLUI_CommandQueue.tail == NULL)
     {
-        offset_y = 0;
-        counter = 0;
-
-        if (clicked)
-        {
-            clicked = false;
-            return true;
-        }
+        SDLUI_CommandQueue.head = submitted;
+    }
+    else
+    {
+        SDLUI_CommandQueue.tail->next = submitted;
     }
+    SDLUI_CommandQueue.tail = submitted;
 
-    return false;
+    SDL_UnlockMutex(SDLUI_CommandQueue.mutex);
 }
 
-bool SDLUI_TextBox(SDLUI_Control_TextBox* tbx)
+SDLUI_String* SDLUI_GetControlText(SDLUI_Control* ctrl)
 {
-    tbx->do_process = true;
-
-    if (tbx->visible && tbx->parent == SDLUI_Core.active_window && SDLUI_Core.active_window->is_hovered)
+    switch (ctrl->type)
     {
-        i32 mx, my;
-        SDL_GetMouseState(&mx, &my);
+    case SDLUI_CONTROL_TYPE_WINDOW:
+        return &((SDLUI_Control_Window*)ctrl)->title;
+    case SDLUI_CONTROL_TYPE_BUTTON:
+        return &((SDLUI_Control_Button*)ctrl)->text;
+    case SDLUI_CONTROL_TYPE_CHECKBOX:
+        return &((SDLUI_Control_CheckBox*)ctrl)->text;
+    case SDLUI_CONTROL_TYPE_TOGGLE_BUTTON:
+        return &((SDLUI_Control_ToggleButton*)ctrl)->text;
+    case SDLUI_CONTROL_TYPE_RADIO_BUTTON:
+        return &((SDLUI_Control_RadioButton*)ctrl)->text;
+    case SDLUI_CONTROL_TYPE_TEXT:
+        return &((SDLUI_Control_Text*)ctrl)->text;
+    case SDLUI_CONTROL_TYPE_TEXTBOX:
+        return &((SDLUI_Control_TextBox*)ctrl)->text;
+    default:
+        return NULL;
+    }
+}
 
-        SDL_Rect r = { tbx->x,tbx->y,tbx->w,tbx->h };
+void SDLUI_ExecuteCommand(SDLUI_CommandList* list, SDLUI_Command* cmd)
+{
+    char* text = cmd->text >= 0 ? list->text + cmd->text : NULL;
+    SDLUI_Control_Window* wnd = NULL;
+    SDLUI_Control* ctrl = NULL;
 
-        if (SDLUI_PointInRect(r, mx, my))
-        {
-            SDL_SetCursor(SDLUI_Core.cursor_ibeam);
-        }
-        else
+    if (cmd->type >= SDLUI_COMMAND_CREATE_BUTTON && cmd->type <= SDLUI_COMMAND_CREATE_TEXTBOX)
+    {
+        wnd = (SDLUI_Control_Window*)SDLUI_FindControl(cmd->window);
+        if (wnd == NULL || wnd->type != SDLUI_CONTROL_TYPE_WINDOW)
         {
-            SDL_SetCursor(SDLUI_Core.cursor_arrow);
+            return;
         }
-
-
-        if (SDLUI_MouseButton(SDL_BUTTON_LEFT) == SDLUI_MOUSEBUTTON_PRESSED)
+    }
+    else if (cmd->type != SDLUI_COMMAND_CREATE_WINDOW)
+    {
+        ctrl = SDLUI_FindControl(cmd->id);
+        if (ctrl == NULL)
         {
-            if (SDLUI_PointInRect(r, mx, my))
-            {
-                tbx->focused = true;
-                return true;
-            }
-            else
-            {
-                tbx->focused = false;
-            }
+            return;
         }
     }
 
-    if (tbx->focused && tbx->parent == SDLUI_Core.active_window)
+    switch (cmd->type)
     {
-        if (SDLUI_Core.e.type == SDL_TEXTINPUT)
-        {
-            tbx->text.insert_char(SDLUI_Core.e.text.text[0], tbx->cursor_pos);
-            tbx->cursor_pos++;
+    case SDLUI_COMMAND_CREATE_WINDOW:
+        ctrl = SDLUI_CreateWindow(cmd->x, cmd->y, cmd->w, cmd->h, text);
+        break;
 
-            if (tbx->cursor_pos > tbx->max_chars)
-            {
-                tbx->scroll++;
-            }
+    case SDLUI_COMMAND_CREATE_BUTTON:
+        ctrl = SDLUI_CreateButton(wnd, cmd->x, cmd->y, text);
+        break;
 
-            SDL_SetRenderTarget(SDLUI_Core.renderer, tbx->tex_text);
-            SDL_Rect r = { 0, 0, tbx->w, tbx->h };
-            SDLUI_SetColor(SDLUI_Core.theme.col_textbox_bg);
-            SDL_RenderFillRect(SDLUI_Core.renderer, &r);
-            SDL_SetRenderTarget(SDLUI_Core.renderer, NULL);
+    case SDLUI_COMMAND_CREATE_TEXT:
+        ctrl = SDLUI_CreateText(wnd, cmd->x, cmd->y, text);
+        break;
 
-            SDLUI_SetColor(SDLUI_Core.theme.col_white);
+    case SDLUI_COMMAND_CREATE_CHECKBOX:
+        ctrl = SDLUI_CreateCheckBox(wnd, cmd->x, cmd->y, text, cmd->value != 0);
+        break;
+
+    case SDLUI_COMMAND_CREATE_SLIDER_INT:
+        ctrl = SDLUI_CreateSliderInt(wnd, cmd->x, cmd->y, cmd->min, cmd->max, cmd->value);
+        break;
+
+    case SDLUI_COMMAND_CREATE_TEXTBOX:
+        ctrl = SDLUI_CreateTextBox(wnd, cmd->x, cmd->y, cmd->w);
+        break;
+
+    case SDLUI_COMMAND_SET_TEXT:
+    {
+        if (ctrl->type == SDLUI_CONTROL_TYPE_TEXT_EDITOR)
+        {
+            SDLUI_TextEditorSetText((SDLUI_Control_TextEditor*)ctrl, text != NULL ? text : "");
+            return;
+        }
+
+        SDLUI_String* str = SDLUI_GetControlText(ctrl);
+        if (str != NULL && text != NULL)
+        {
+            str->modify(text);
+            SDLUI_Invalidate(ctrl);
+            SDLUI_InvalidateLayout(ctrl);
 
-            if (tbx->text.length <= tbx->max_chars)
+            if (ctrl->type == SDLUI_CONTROL_TYPE_WINDOW)
             {
-                SDLUI_DrawText(0, 0, tbx->text.data, tbx->tex_text);
+                ctrl->dirty = true;
             }
-            else
+            else if (ctrl->type == SDLUI_CONTROL_TYPE_TEXTBOX)
             {
-                SDLUI_DrawTextRange(0, 0, tbx->text.data, tbx->scroll, tbx->max_chars, tbx->tex_text);
+                SDLUI_Control_TextBox* tbx = (SDLUI_Control_TextBox*)ctrl;
+                tbx->cursor_pos = tbx->text.length;
+                tbx->scroll = 0;
+                SDLUI_UpdateTextBoxText(tbx);
             }
         }
+        return;
+    }
 
-        if (SDLUI_Core.e.type == SDL_KEYDOWN)
+    case SDLUI_COMMAND_SET_VALUE:
+        if (ctrl->type == SDLUI_CONTROL_TYPE_SLIDER_INT)
         {
-            if (SDLUI_Core.e.key.keysym.scancode == SDL_SCANCODE_LEFT)
-            {
-                if (tbx->cursor_pos > 0)
-                {
-                    tbx->cursor_pos--;
+            SDLUI_Control_SliderInt* si = (SDLUI_Control_SliderInt*)ctrl;
+            si->value = SDLUI_Clamp(cmd->value, si->min, si->max);
+        }
+        else if (ctrl->type == SDLUI_CONTROL_TYPE_CHECKBOX)
+        {
+            ((SDLUI_Control_CheckBox*)ctrl)->checked = cmd->value != 0;
+        }
+        else if (ctrl->type == SDLUI_CONTROL_TYPE_TOGGLE_BUTTON)
+        {
+            ((SDLUI_Control_ToggleButton*)ctrl)->checked = cmd->value != 0;
+        }
+        SDLUI_Invalidate(ctrl);
+        return;
 
-                    if (tbx->cursor_pos < tbx->scroll)
-                    {
-                        tbx->scroll--;
-                        //0123456789-----15
-                        //asdfghjkl1234567
-                        //          |    |
-                    }
-                }
-            }
-            else if (SDLUI_Core.e.key.keysym.scancode == SDL_SCANCODE_RIGHT)
-            {
-                if (tbx->cursor_pos < tbx->text.length)
-                {
-                    tbx->cursor_pos++;
+    case SDLUI_COMMAND_SET_VISIBLE:
+        ctrl->visible = cmd->value != 0;
+        SDLUI_Invalidate(ctrl);
+        return;
 
-                    if (tbx->cursor_pos > tbx->max_chars)
-                    {
-                        tbx->scroll++;
-                    }
-                }
-            }
-            else if (SDLUI_Core.e.key.keysym.scancode == SDL_SCANCODE_BACKSPACE)
-            {
-                if (tbx->cursor_pos > 0)
-                {
-                    tbx->text.delete_char(tbx->cursor_pos - 1);
-                    tbx->cursor_pos--;
+    case SDLUI_COMMAND_MOVE:
+        if (ctrl->type == SDLUI_CONTROL_TYPE_WINDOW)
+        {
+            ctrl->x = cmd->x;
+            ctrl->y = cmd->y;
+            SDLUI_Core.layout_generation++;
+        }
+        else
+        {
+            SDLUI_MoveControl(ctrl, cmd->x, cmd->y);
+        }
+        return;
+
+    case SDLUI_COMMAND_DESTROY_WINDOW:
+        if (ctrl->type == SDLUI_CONTROL_TYPE_WINDOW)
+        {
+            SDLUI_DestroyWindow((SDLUI_Control_Window*)ctrl);
+        }
+        return;
+    }
 
+    SDLUI_SetControlID(ctrl, cmd->id);
+}
 
-                    SDL_SetRenderTarget(SDLUI_Core.renderer, tbx->tex_text);
-                    SDL_Rect r = { 0, 0, tbx->w, tbx->h };
-                    SDLUI_SetColor(SDLUI_Core.theme.col_textbox_bg);
-                    SDL_RenderFillRect(SDLUI_Core.renderer, &r);
-                    SDL_SetRenderTarget(SDLUI_Core.renderer, NULL);
+// Runs everything submitted since the last call, in the order it was submitted. Called by SDLUI_WindowHandler.
+void SDLUI_ExecuteCommands()
+{
+    if (SDLUI_CommandQueue.mutex == NULL)
+    {
+        return;
+    }
 
-                    SDLUI_SetColor(SDLUI_Core.theme.col_white);
+    SDL_LockMutex(SDLUI_CommandQueue.mutex);
+    SDLUI_CommandList* list = SDLUI_CommandQueue.head;
+    SDLUI_CommandQueue.head = NULL;
+    SDLUI_CommandQueue.tail = NULL;
+    SDL_UnlockMutex(SDLUI_CommandQueue.mutex);
 
-                    if (tbx->text.length <= tbx->max_chars)
-                    {
-                        SDLUI_DrawText(0, 0, tbx->text.data, tbx->tex_text);
-                    }
-                    else
-                    {
-                        SDLUI_DrawTextRange(0, 0, tbx->text.data, 0, 3, tbx->tex_text);
-                    }
-                }
-            }
+    while (list != NULL)
+    {
+        for (int i = 0; i < list->num_commands; ++i)
+        {
+            SDLUI_ExecuteCommand(list, &list->commands[i]);
         }
-    }
 
-    return false;
+        SDLUI_CommandList* next = list->next;
+        list->destroy();
+        free(list);
+        list = next;
+    }
 }
\ No newline at end of file
@@ -5,7 +5,29 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <typeinfo>
+#include <algorithm>
+#include <unordered_map>
 #include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+#include <atomic>
+
+// Define CRISPY_OCTO_SPORK_COUNT_ALLOCATIONS before including this file to count heap allocations per frame. It replaces
+// the global operator new and operator delete at the end of this file, which takes over heap allocation for the whole
+// program, libraries included, so it is never turned on by default.
+#ifdef CRISPY_OCTO_SPORK_COUNT_ALLOCATIONS
+#include <new>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CRISPY_OCTO_SPORK_SSE2
+#endif
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -14,712 +36,3591 @@
 
 namespace CrispyOctoSpork
 {
+#ifdef CRISPY_OCTO_SPORK_COUNT_ALLOCATIONS
 	/// <summary>
-	/// Base class for objects that should be updated and rendered.
+	/// Number of heap allocations made through operator new and by frame allocators spilling over.
 	/// </summary>
-	class Entity
-	{
-	public:
-		/// <summary>
-		/// Default constructor.
-		/// </summary>
-		Entity();
-
-		/// <summary>
-		/// Constructs a new instance of <see cref="Entity"/>.
-		/// </summary>
-		/// <param name="x">The x location of the entity in the engine.</param>
-		/// <param name="y">The y location of the entity in the engine.</param>
-		Entity(float x, float y);
-
-		/// <summary>
-		/// Default deconstructor.
-		/// </summary>
-		~Entity();
+	std::atomic<size_t> allocationCount(0);
+#endif
 
-		/// <summary>
-		/// Called once a frame to be overridden by derived classes.
-		/// </summary>
-		/// <param name="deltaTime">The delta time since the last frame.</param>
-		/// <returns>Returns a boolean.</returns>
-		virtual bool OnUpdate(float deltaTime);
+	/// <summary>
+	/// Receives every line written with Log, on whichever thread wrote it.
+	/// </summary>
+	typedef void (*LogSink)(const char* message, void* userData);
 
-		/// <summary>
-		/// Called once a frame to be overridden by derived classes.
-		/// </summary>
-		/// <param name="deltaTime">The delta time since the last frame.</param>
-		/// <returns>Returns a boolean.</returns>
-		virtual bool OnRender(float deltaTime);
+	/// <summary>
+	/// Where Log sends its lines. Null prints them to stdout.
+	/// </summary>
+	LogSink logSink = nullptr;
+	void* logSinkUserData = nullptr;
 
-	protected:
-		float x;
-		float y;
-	};
+	/// <summary>
+	/// Sends every following Log line to sink. Set it before other threads start logging.
+	/// </summary>
+	/// <param name="sink">The function to call with each line, or nullptr for stdout.</param>
+	/// <param name="userData">Passed along to the sink with every line.</param>
+	void SetLogSink(LogSink sink, void* userData = nullptr)
+	{
+		logSinkUserData = userData;
+		logSink = sink;
+	}
 
 	/// <summary>
-	/// A few SDL_Colors to use.
+	/// Formats a line like printf and hands it to the log sink. The line is formatted on the stack,
+	/// so it is safe to call from any thread without allocating.
 	/// </summary>
-	SDL_Color COLOR_RED = { 255, 0, 0, 255 }, COLOR_GREEN = { 0, 255, 0, 255 }, COLOR_BLUE = { 0, 0, 255, 255 };
+	/// <param name="format">The printf style format string.</param>
+	void Log(const char* format, ...)
+	{
+		char message[512];
+		va_list args;
+
+		va_start(args, format);
+		vsnprintf(message, sizeof(message), format, args);
+		va_end(args);
+
+		if (logSink != nullptr)
+		{
+			logSink(message, logSinkUserData);
+		}
+		else
+		{
+			puts(message);
+		}
+	}
 
 	/// <summary>
-	/// Class for calculating and storing the current frame rate.
+	/// A 2D affine transform stored as the 2x3 matrix [a c tx; b d ty].
 	/// </summary>
-	class FrameRate
+	struct Matrix2D
 	{
-	public:
+		float a = 1;
+		float b = 0;
+		float c = 0;
+		float d = 1;
+		float tx = 0;
+		float ty = 0;
+
 		/// <summary>
-		/// Default constructor.
+		/// Builds a matrix that scales, then rotates, then translates.
 		/// </summary>
-		FrameRate();
+		/// <param name="x">The x translation.</param>
+		/// <param name="y">The y translation.</param>
+		/// <param name="rotation">The rotation in degrees.</param>
+		/// <param name="scaleX">The scale along the x axis.</param>
+		/// <param name="scaleY">The scale along the y axis.</param>
+		/// <returns>Returns the composed matrix.</returns>
+		static Matrix2D FromTransform(float x, float y, float rotation, float scaleX, float scaleY);
 
 		/// <summary>
-		/// Gets the current frame rate.
+		/// Composes two transforms, the right hand side is applied first.
 		/// </summary>
-		/// <returns>Returns an int indicating the number of frames that occurd in the last second.</returns>
-		int GetCurrentFramesPerSecond();
+		Matrix2D operator*(const Matrix2D& other) const;
 
 		/// <summary>
-		/// Called once per frame in order to update the frame rate.
+		/// Transforms a point from local space into the space of this matrix.
 		/// </summary>
-		/// <returns>Returns 0 or the current framerate if there is an update (once per second.)</returns>
-		int OnUpdate();
+		SDL_FPoint TransformPoint(SDL_FPoint point) const;
 
-	private:
-		Uint32 timeStampOfBeginingOfSecond;
-		int currentSecondsFrameCount;
-		int currentFramesPerSecond;
+		/// <summary>
+		/// Gets the rotation of the matrix in degrees.
+		/// </summary>
+		float GetRotation() const;
+
+		/// <summary>
+		/// Gets the length of the x and y basis vectors.
+		/// </summary>
+		SDL_FPoint GetScale() const;
 	};
 
 	/// <summary>
-	/// The main class that games should create an instance of.
+	/// Stores local and world transforms for a tree of nodes. Nodes are kept in arrays sorted by
+	/// depth so that parents always come before their children, which lets <see cref="Update"/>
+	/// recompute only the dirty subtrees in one linear pass.
 	/// </summary>
-	class Engine
+	class TransformHierarchy
 	{
 	public:
 		/// <summary>
-		/// Default constructor.
+		/// Creates a new root node.
 		/// </summary>
-		Engine();
+		/// <param name="x">The local x position.</param>
+		/// <param name="y">The local y position.</param>
+		/// <param name="rotation">The local rotation in degrees.</param>
+		/// <param name="scaleX">The local scale along the x axis.</param>
+		/// <param name="scaleY">The local scale along the y axis.</param>
+		/// <returns>Returns a handle that stays valid until the node is destroyed.</returns>
+		int Create(float x, float y, float rotation = 0.0, float scaleX = 1.0, float scaleY = 1.0);
 
 		/// <summary>
-		/// Overridable deconstructor.
+		/// Destroys a node. Any children become root nodes.
 		/// </summary>
-		virtual ~Engine();
+		/// <param name="handle">The handle of the node to destroy.</param>
+		void Destroy(int handle);
 
 		/// <summary>
-		/// First thing to call after creating an instance of <see cref="Engine"/>.
+		/// Removes every node.
 		/// </summary>
-		/// <param name="name">The name of the game, will be displayed in the title bar.</param>
-		/// <param name="width">The width of the screen in pixels.</param>
-		/// <param name="height">The height of the screen in pixels.</param>
-		/// <param name="vsync">Indicates if the renderer should be created with vsync on.</param>
-		/// <param name="fullscreen">Indicates if the renderer should be created with fullscreen set.</param>
-		/// <returns>Returns a boolean indicating if creation was successful.</returns>
-		bool Create(std::string name, int width, int height, bool vsync, bool fullscreen);
+		void Clear();
 
 		/// <summary>
-		/// Called to start the game engines main game loop.
+		/// Attaches a node to a parent, or detaches it when the parent is -1.
 		/// </summary>
-		/// <returns>Returns a boolean indicating if there was an issue.</returns>
-		bool Start();
+		/// <param name="handle">The handle of the child node.</param>
+		/// <param name="parent">The handle of the new parent or -1.</param>
+		/// <returns>Returns false if the parent is invalid or would create a cycle.</returns>
+		bool SetParent(int handle, int parent);
 
 		/// <summary>
-		/// Called once at engine startup.
+		/// Gets the handle of a node's parent.
 		/// </summary>
-		/// <returns>Returns a boolean.</returns>
-		virtual bool OnCreate();
+		/// <returns>Returns the parent handle or -1 for root nodes.</returns>
+		int GetParent(int handle);
 
 		/// <summary>
-		/// Called once per frame after the engine is started.
+		/// Sets the local transform of a node. The node is only marked dirty if something changed.
 		/// </summary>
-		/// <param name="deltaTime">The time delta from the previous frame.</param>
-		/// <returns>Returns a boolean indicating if the engine should continue running.</returns>
-		virtual bool OnUpdate(float deltaTime);
+		void SetLocal(int handle, float x, float y, float rotation, float scaleX, float scaleY);
 
 		/// <summary>
-		/// Called once per frame after update to render stuff
+		/// Gets the world transform of a node as of the last call to <see cref="Update"/>.
 		/// </summary>
-		/// <param name="deltaTime">The time delta from the previous frame.</param>
-		/// <returns>Returns a boolean indicating if the engine should continue running.</returns>
-		virtual bool OnRender(float deltaTime);
-
-		virtual bool OnEvent(SDL_Event event);
+		const Matrix2D& GetWorld(int handle);
 
 		/// <summary>
-		/// Called before the engine terminates.
+		/// Recomputes the world transforms of every dirty node and its descendants.
 		/// </summary>
-		/// <returns>Returns a boolean.</returns>
-		virtual bool OnDestroy();
+		void Update();
+
+	private:
+		struct LocalTransform
+		{
+			float x;
+			float y;
+			float rotation;
+			float scaleX;
+			float scaleY;
+		};
+
+		// per node, in depth sorted order.
+		std::vector<int> parentIndex;
+		std::vector<LocalTransform> local;
+		std::vector<Matrix2D> world;
+		std::vector<unsigned char> dirty;
+		std::vector<int> indexToHandle;
+
+		// per handle.
+		std::vector<int> handleToIndex;
+		std::vector<int> parentHandle;
+		std::vector<int> freeHandles;
+
+		bool needsSort = false;
 
 		/// <summary>
-		/// Adds an <see cref="Entity"/> to the engines vector of entites. Will be cleaned up by the engine.
+		/// Rebuilds the node arrays so they are ordered by depth.
 		/// </summary>
-		/// <param name="entity">The entity pointer to add to the vector.</param>
-		void AddEntity(Entity* entity);
+		void Sort();
+	};
+
+	class Entity;
+
+	/// <summary>
+	/// The shapes a <see cref="Collider"/> can have.
+	/// </summary>
+	enum ColliderType
+	{
+		COLLIDER_AABB,
+		COLLIDER_CIRCLE,
+		COLLIDER_OBB
+	};
+
+	/// <summary>
+	/// Collision geometry in world space. Boxes are described by their center and half extents.
+	/// </summary>
+	struct Collider
+	{
+		ColliderType type = COLLIDER_AABB;
+		float x = 0;
+		float y = 0;
+		float halfWidth = 0;
+		float halfHeight = 0;
+		float radius = 0;
+		float rotation = 0;
+		Entity* entity = NULL;
 
 		/// <summary>
-		/// Draws a qaud with an optional rotation.
-		/// Realized this is kinda useless right now since SDL doesn't have a way
-		/// to actually fill in the geometry with a color.
+		/// Pairs where neither collider is awake are skipped, leave this false for static geometry.
 		/// </summary>
-		/// <param name="points">The array of points to draw.</param>
-		/// <param name="color">The color to make the quad</param>
-		/// <param name="rotation">The angle to rotate the quad in radians.</param>
-		void DrawQuad(SDL_FPoint* points, SDL_Color color, float rotation = 0.0);
-
-	protected:
-		SDL_Window* window;
-		SDL_Renderer* renderer;
-		int screenWidth;
-		int screenHeight;
-		bool isVsyncEnabled;
-		bool isFullscreenEnabled;
-		std::string name;
-		bool isEngineRunning;
-		std::vector <Entity*> entities;
-		float lastFrameTime;
-		FrameRate frameRate;
+		bool awake = true;
 
 		/// <summary>
-		/// The main loop. To support emscripten the current <see cref="Engine"/> instance is passed in.
+		/// How far the collider is going to move this step. The broad-phase bounds cover the whole sweep
+		/// so fast movers still get paired with anything they could pass through.
 		/// </summary>
-		/// <param name="arg">A pointer to the current <see cref="Engine"/> instance.</param>
-		static void Update(void* arg);
+		float sweepX = 0;
+		float sweepY = 0;
 	};
 
-	class SoundEffect
+	/// <summary>
+	/// Describes how two colliders overlap. The normal points from collider a towards collider b.
+	/// </summary>
+	struct ContactManifold
 	{
-	public:
-		SoundEffect();
-		~SoundEffect();
-		bool LoadSoundFromFile(const char* filepath);
-		bool PlaySound();
-		void Free();
-	private:
-		Mix_Chunk* mixChunk;
+		int a = -1;
+		int b = -1;
+		float normalX = 0;
+		float normalY = 0;
+		float penetration = 0;
+		int pointCount = 0;
+		SDL_FPoint points[2];
 	};
 
 	/// <summary>
-	/// An object for holding texture information and to perform basic renders of it.
+	/// A pair of collider indices whose bounds overlap.
 	/// </summary>
-	class Texture
+	struct ColliderPair
+	{
+		int a;
+		int b;
+	};
+
+	/// <summary>
+	/// Finds contacts between a set of colliders. A sweep and prune broad-phase over the x axis finds
+	/// candidate pairs, their bounds are then tested four at a time with SIMD before the exact
+	/// shape tests run on whatever is left.
+	/// </summary>
+	class CollisionWorld
 	{
 	public:
 		/// <summary>
-		/// Default constructor.
+		/// Adds a collider to the world.
 		/// </summary>
-		Texture();
+		/// <param name="collider">The collider to add.</param>
+		/// <returns>Returns the index of the collider.</returns>
+		int AddCollider(const Collider& collider);
 
 		/// <summary>
-		/// Creates a new instance of <see cref="Texture"/>.
+		/// Gets a collider so it can be moved or changed.
 		/// </summary>
-		Texture(SDL_Renderer* renderer);
+		/// <param name="index">The index returned from <see cref="AddCollider"/>.</param>
+		Collider& GetCollider(int index);
 
 		/// <summary>
-		/// Default deconstructor.
+		/// Gets the number of colliders in the world.
 		/// </summary>
-		~Texture();
+		int GetColliderCount();
 
 		/// <summary>
-		/// Populates the <see cref="SDL_Texture"/> from a file.
+		/// Removes every collider.
 		/// </summary>
-		/// <param name="filepath">The file path to load an image from for the texture.</param>
-		/// <returns>Returns a boolean indicating success.</returns>
-		bool LoadTextureFromFile(const char* filepath);
+		void Clear();
 
 		/// <summary>
-		/// Called to cleanup and free the texture.
+		/// Runs the broad-phase and fills in the pairs of colliders whose bounds overlap.
 		/// </summary>
-		void Free();
+		/// <returns>Returns the candidate pairs, valid until the next call.</returns>
+		const std::vector<ColliderPair>& FindCandidatePairs();
 
 		/// <summary>
-		/// Renders the texture to the current <see cref="SDL_Renderer"/>.
+		/// Finds every pair of colliders that are touching.
 		/// </summary>
-		/// <param name="x">The x location to draw to.</param>
-		/// <param name="y">The y location to draw to.</param>
-		/// <param name="clip">The rectangle to pull texture information from. Useful for sprite sheets.</param>
-		/// <param name="angle">The angle at which to rotate the texture.</param>
-		/// <param name="center">The center to rotate about.</param>
-		/// <param name="flip">Determines if the texture will be flipped.</param>
-		void Render(float x, float y, SDL_Rect* clip = NULL, float angle = 0.0, SDL_FPoint* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE, int alpha = 255);
+		/// <param name="contacts">Cleared and then filled with a manifold for each touching pair.</param>
+		/// <returns>Returns the number of contacts found.</returns>
+		int FindContacts(std::vector<ContactManifold>& contacts);
 
 		/// <summary>
-		/// Gets the current renderer associated with this texture.
+		/// Finds every pair of colliders that are touching, into a buffer owned by the world so calling this
+		/// every frame doesn't allocate once the buffer has grown.
 		/// </summary>
-		/// <returns>Returns a pointer to a <see cref="SDL_Renderer"/>.</returns>
-		SDL_Renderer* GetRenderer();
+		/// <returns>Returns the contacts, valid until the next call.</returns>
+		const std::vector<ContactManifold>& FindContacts();
 
-	private:
-		SDL_Texture* texture;
-		SDL_Renderer* renderer;
-		int width;
-		int height;
-	};
+		/// <summary>
+		/// Gets the axis aligned bounds of a collider.
+		/// </summary>
+		static SDL_FRect GetBounds(const Collider& collider);
 
-	/// <summary>
-	/// Sprite class to hold an entity and a texture.
-	/// </summary>
-	class Sprite : public Entity
-	{
-	public:
 		/// <summary>
-		/// Default constructor.
+		/// Tests two colliders against each other.
 		/// </summary>
-		Sprite();
+		/// <param name="a">The first collider.</param>
+		/// <param name="b">The second collider.</param>
+		/// <param name="manifold">Optional, filled in when the colliders touch.</param>
+		/// <returns>Returns true if the colliders overlap.</returns>
+		static bool TestCollision(const Collider& a, const Collider& b, ContactManifold* manifold);
 
 		/// <summary>
-		/// Creates a new instance of <see cref="Sprite"/>.
+		/// Finds when a moving collider first touches a stationary one.
 		/// </summary>
-		/// <param name="x">The x location of the sprite in the engine.</param>
-		/// <param name="y">The y location of the sprite in the engine.</param>
-		/// <param name="width">The width of the sprite.</param>
-		/// <param name="height">The height of the sprite.</param>
-		/// <param name="texture">A pointer to the texture to use for the sprite.</param>
-		/// <param name="renderer">A pointer to the renderer to render the sprite to.</param>
-		Sprite(float x, float y, float width, float height, Texture* texture, SDL_Renderer* renderer);
+		/// <param name="moving">The collider at the start of its motion.</param>
+		/// <param name="dx">How far the collider moves along x.</param>
+		/// <param name="dy">How far the collider moves along y.</param>
+		/// <param name="target">The collider that isn't moving.</param>
+		/// <param name="timeOfImpact">Filled in with the fraction of the motion, from 0 to 1, at which they touch.</param>
+		/// <param name="normalX">Filled in with the x of the target's surface normal at the point of impact.</param>
+		/// <param name="normalY">Filled in with the y of the target's surface normal at the point of impact.</param>
+		/// <returns>Returns true if the colliders touch during the motion.</returns>
+		static bool SweepTest(const Collider& moving, float dx, float dy, const Collider& target, float* timeOfImpact, float* normalX, float* normalY);
 
 		/// <summary>
-		/// Called once per frame. Renders the sprite to its current location.
+		/// Gets the pairs found by the last broad-phase run.
 		/// </summary>
-		/// <param name="deltaTime">The delta time since the last frame.</param>
-		/// <returns>Returns a boolean indicating success.</returns>
-		virtual bool OnRender(float deltaTime);
+		const std::vector<ColliderPair>& GetCandidatePairs();
 
-	protected:
-		float width;
-		float height;
-		Texture* texture;
-		SDL_Renderer* renderer;
+	private:
+		std::vector<Collider> colliders;
+
+		// bounds of each collider, struct of arrays so they can be gathered cheaply.
+		std::vector<float> minX;
+		std::vector<float> minY;
+		std::vector<float> maxX;
+		std::vector<float> maxY;
+
+		// collider indices sorted by minX, kept between calls since the order rarely changes much.
+		std::vector<int> sortedByMinX;
+		std::vector<ColliderPair> candidatePairs;
+		std::vector<ColliderPair> overlappingPairs;
+		std::vector<ContactManifold> contacts;
+
+		// bounds gathered per candidate pair for the batched overlap test.
+		std::vector<float> batchMinXA, batchMinYA, batchMaxXA, batchMaxYA;
+		std::vector<float> batchMinXB, batchMinYB, batchMaxXB, batchMaxYB;
+
+		void UpdateBounds();
+		void TestBoundsBatch(std::vector<ColliderPair>& overlapping);
+
+		static bool TestCircleCircle(const Collider& a, const Collider& b, ContactManifold* manifold);
+		static bool TestAABBAABB(const Collider& a, const Collider& b, ContactManifold* manifold);
+		static bool TestCircleAABB(const Collider& circle, const Collider& box, ContactManifold* manifold);
+		static bool TestCircleOBB(const Collider& circle, const Collider& box, ContactManifold* manifold);
+		static bool TestOBBOBB(const Collider& a, const Collider& b, ContactManifold* manifold);
+		static void FlipManifold(ContactManifold* manifold);
+		static SDL_FRect GetBoxBounds(const Collider& collider);
+		static bool RayCastAABB(float originX, float originY, float dx, float dy, float minX, float minY, float maxX, float maxY, float* t, float* normalX, float* normalY);
+		static bool RayCastCircle(float originX, float originY, float dx, float dy, float centerX, float centerY, float radius, float* t, float* normalX, float* normalY);
+	};
+
+	/// <summary>
+	/// A body simulated by <see cref="PhysicsWorld"/>. Bodies only move, they don't rotate.
+	/// </summary>
+	struct RigidBody
+	{
+		Collider shape;
+		float velocityX = 0;
+		float velocityY = 0;
+		float inverseMass = 0;
+		float restitution = 0;
+		float friction = 0.5f;
 
+		/// <summary>
+		/// Fast moving bodies should set this so they are swept against everything they pass and
+		/// bounce off what they hit, instead of tunnelling through thin objects. The broad-phase finds what a
+		/// bullet could hit first from its velocity before the contacts are solved, so a contact that speeds it up
+		/// or turns it can still carry it past something outside that sweep.
+		/// </summary>
+		bool bullet = false;
+		bool sleeping = false;
+		float sleepTime = 0;
+		Entity* entity = NULL;
+		float entityOffsetX = 0;
+		float entityOffsetY = 0;
 	};
 
 	/// <summary>
-	/// Class to hold an entity represented by a rectangle.
+	/// An impulse based 2D physics world. Contacts are resolved with a sequential impulse solver and
+	/// bodies that come to rest together are put to sleep as an island, so resting stacks skip
+	/// integration, narrow phase and solving entirely. Given the same bodies added in the same order
+	/// and the same time steps, the simulation always produces the same result.
 	/// </summary>
-	class Rectangle : public Entity
+	class PhysicsWorld
 	{
 	public:
 		/// <summary>
 		/// Default constructor.
 		/// </summary>
-		Rectangle();
+		PhysicsWorld();
 
 		/// <summary>
-		/// Creates a new instance of <see cref="Rectangle"/>.
+		/// Adds a body to the world.
 		/// </summary>
-		/// <param name="x">The x location of the rectangle in the engine.</param>
-		/// <param name="y">The y location of the rectangle in the engine.</param>
-		/// <param name="width">The width of the rectangle.</param>
-		/// <param name="height">The height of the rectangle.</param>
-		/// <param name="color">The color to draw the rectangle with.</param>
-		/// <param name="renderer">A pointer to the renderer to render the rectangle to.</param>
-		Rectangle(float x, float y, float width, float height, SDL_Color color, SDL_Renderer* renderer);
+		/// <param name="shape">The shape of the body, its x and y are the body's starting center.</param>
+		/// <param name="mass">The mass of the body, 0 makes the body static.</param>
+		/// <returns>Returns the index of the body.</returns>
+		int AddBody(const Collider& shape, float mass);
 
 		/// <summary>
-		/// Called once per frame. Renders the rectangle to its current location.
+		/// Gets a body so it can be read or changed. Call <see cref="WakeBody"/> after changing a sleeping body.
 		/// </summary>
-		/// <param name="deltaTime">The delta time since the last frame.</param>
-		/// <returns>Returns a boolean indicating success.</returns>
-		virtual bool OnRender(float deltaTime);
-
-	protected:
-		float width;
-		float height;
-		SDL_Color color;
-		SDL_Renderer* renderer;
-	};
+		RigidBody& GetBody(int index);
+
+		/// <summary>
+		/// Gets the number of bodies in the world.
+		/// </summary>
+		int GetBodyCount();
+
+		/// <summary>
+		/// Wakes a body up so it will be simulated again.
+		/// </summary>
+		void WakeBody(int index);
+
+		/// <summary>
+		/// Removes every body.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Advances the simulation. Should be called with a fixed time step.
+		/// </summary>
+		/// <param name="timeStep">The time to advance in seconds.</param>
+		void Step(float timeStep);
+
+		float gravityX;
+		float gravityY;
+		int iterations;
+		bool sleepingEnabled;
+		float sleepVelocity;
+		float timeToSleep;
+
+	private:
+		struct ContactConstraint
+		{
+			int a;
+			int b;
+			float normalX;
+			float normalY;
+			float penetration;
+			float normalMass;
+			float friction;
+			float bias;
+			float normalImpulse;
+			float tangentImpulse;
+		};
+
+		/// <summary>
+		/// The impulses a pair of bodies ended the last step with, used to warm start them in this one.
+		/// </summary>
+		struct CachedImpulse
+		{
+			unsigned long long key;
+			float normalImpulse;
+			float tangentImpulse;
+
+			bool operator<(const CachedImpulse& other) const
+			{
+				return key < other.key;
+			}
+		};
+
+		std::vector<RigidBody> bodies;
+		CollisionWorld collisionWorld;
+		std::vector<ContactManifold> manifolds;
+		std::vector<ContactConstraint> constraints;
+		std::vector<CachedImpulse> cachedImpulses;
+		std::vector<int> islandParent;
+		std::vector<float> islandSleepTime;
+
+		bool IsAwake(const RigidBody& body);
+		void SolveConstraint(ContactConstraint& constraint);
+		void SweepBullets(float timeStep);
+		int FindIsland(int body);
+		void UpdateSleeping(float timeStep);
+	};
 
 	/// <summary>
-	/// Class to hold an entity represented by a circle.
+	/// The kinds of value a <see cref="FieldInfo"/> can describe.
 	/// </summary>
-	class Circle : public Entity
+	enum FieldType
+	{
+		FIELD_BOOL,
+		FIELD_INT,
+		FIELD_FLOAT
+	};
+
+	/// <summary>
+	/// A reflected member of a type: its name, what kind of value it holds and how to find it in an object.
+	/// </summary>
+	struct FieldInfo
+	{
+		const char* name;
+		FieldType type;
+		void* (*address)(void* object);
+	};
+
+	/// <summary>
+	/// Finds a member through a member pointer, which works for polymorphic types where offsetof doesn't.
+	/// Use it as the address of a <see cref="FieldInfo"/>, e.g. &amp;FieldAddress&lt;Entity, float, &amp;Entity::x&gt;.
+	/// </summary>
+	/// <param name="object">The object, it has to point at a T or at a type derived from it through single inheritance.</param>
+	/// <returns>Returns a pointer to the member.</returns>
+	template <typename T, typename V, V T::*Member>
+	void* FieldAddress(void* object)
+	{
+		return &(static_cast<T*>(object)->*Member);
+	}
+
+	/// <summary>
+	/// Reflection info for a type so tools can read its members without knowing about it at compile time.
+	/// Fields declared by a base class are found through base.
+	/// </summary>
+	struct TypeInfo
+	{
+		const char* name;
+		const TypeInfo* base;
+		const FieldInfo* fields;
+		int fieldCount;
+	};
+
+	/// <summary>
+	/// Keeps track of every type with reflection info. The engine's own types are always registered,
+	/// games can add theirs with <see cref="Register"/>.
+	/// </summary>
+	class TypeRegistry
+	{
+	public:
+		/// <summary>
+		/// Adds a type to the registry. Registering the same type twice does nothing.
+		/// </summary>
+		/// <param name="type">The type to add, it has to outlive the registry.</param>
+		static void Register(const TypeInfo* type);
+
+		/// <summary>
+		/// Looks up a type by name.
+		/// </summary>
+		/// <param name="name">The name of the type.</param>
+		/// <returns>Returns the type, or NULL if nothing with that name is registered.</returns>
+		static const TypeInfo* Find(const char* name);
+
+		/// <summary>
+		/// Gets every registered type.
+		/// </summary>
+		static const std::vector<const TypeInfo*>& GetTypes();
+
+	private:
+		static std::vector<const TypeInfo*>& Types();
+	};
+
+	/// <summary>
+	/// Base class for objects that should be updated and rendered.
+	/// </summary>
+	class Entity
 	{
 	public:
 		/// <summary>
 		/// Default constructor.
 		/// </summary>
-		Circle();
+		Entity();
 
 		/// <summary>
-		/// Creates a new instance of <see cref="Circle"/>.
+		/// Constructs a new instance of <see cref="Entity"/>.
 		/// </summary>
-		/// <param name="x">The x location of the center of the circle.</param>
-		/// <param name="y">The y location of the center of the circle.</param>
-		/// <param name="radius">The radius of the circle</param>
-		/// <param name="color">The color to draw the circle with.</param>
-		/// <param name="renderer">A pointer to the renderer to render the circle to.</param>
-		Circle(float x, float y, float radius, SDL_Color color, SDL_Renderer* renderer);
+		/// <param name="x">The x location of the entity in the engine.</param>
+		/// <param name="y">The y location of the entity in the engine.</param>
+		Entity(float x, float y);
 
 		/// <summary>
-		/// Called once per frame. Renders the circle to its current location.
+		/// Default deconstructor.
+		/// </summary>
+		virtual ~Entity();
+
+		/// <summary>
+		/// Called once a frame to be overridden by derived classes.
 		/// </summary>
 		/// <param name="deltaTime">The delta time since the last frame.</param>
-		/// <returns>Returns a boolean indicating success.</returns>
+		/// <returns>Returns a boolean.</returns>
+		virtual bool OnUpdate(float deltaTime);
+
+		/// <summary>
+		/// Called once a frame to be overridden by derived classes.
+		/// </summary>
+		/// <param name="deltaTime">The delta time since the last frame.</param>
+		/// <returns>Returns a boolean.</returns>
 		virtual bool OnRender(float deltaTime);
 
+		/// <summary>
+		/// Attaches this entity to another so it follows the parent's position, rotation and scale.
+		/// Both entities need to have been added to the same engine.
+		/// </summary>
+		/// <param name="parent">The new parent, or NULL to detach.</param>
+		/// <returns>Returns a boolean indicating success.</returns>
+		bool SetParent(Entity* parent);
+
+		/// <summary>
+		/// Gets the position of the entity after its parents have been applied.
+		/// </summary>
+		SDL_FPoint GetWorldPosition();
+
+		/// <summary>
+		/// Gets the rotation of the entity in degrees after its parents have been applied.
+		/// </summary>
+		float GetWorldRotation();
+
+		/// <summary>
+		/// Gets the scale of the entity after its parents have been applied.
+		/// </summary>
+		SDL_FPoint GetWorldScale();
+
+		/// <summary>
+		/// Gets the collision geometry of the entity in world space.
+		/// </summary>
+		/// <param name="collider">Filled in with the entity's collider.</param>
+		/// <returns>Returns false if the entity doesn't collide with anything.</returns>
+		virtual bool GetCollider(Collider* collider);
+
+		/// <summary>
+		/// Gets the reflection info of the most derived type of this entity.
+		/// </summary>
+		virtual const TypeInfo* GetTypeInfo();
+
+		/// <summary>
+		/// Gets the reflection info for <see cref="Entity"/>.
+		/// </summary>
+		static const TypeInfo* StaticTypeInfo();
+
 	protected:
-		float radius;
-		SDL_Color color;
-		SDL_Renderer* renderer;
+		float x;
+		float y;
+		float rotation;
+		float scaleX;
+		float scaleY;
+		int transform;
+		TransformHierarchy* transforms;
+
+		friend class Engine;
 	};
 
 	/// <summary>
-	/// Struct used to contain a single particle of a <see cref="ParticleEmitter"/>.
+	/// A few SDL_Colors to use.
 	/// </summary>
-	struct Particle
+	SDL_Color COLOR_RED = { 255, 0, 0, 255 }, COLOR_GREEN = { 0, 255, 0, 255 }, COLOR_BLUE = { 0, 0, 255, 255 };
+
+	/// <summary>
+	/// Class for calculating and storing the current frame rate.
+	/// </summary>
+	class FrameRate
 	{
-		float x = 0;
-		float y = 0;
-		float xVelocity = 0;
-		float yVelocity = 0;
-		float totalLifeTime = 0;
-		float lifeTimeRemaining = 0;
-		bool active = false;
+	public:
+		/// <summary>
+		/// Default constructor.
+		/// </summary>
+		FrameRate();
+
+		/// <summary>
+		/// Gets the current frame rate.
+		/// </summary>
+		/// <returns>Returns an int indicating the number of frames that occurd in the last second.</returns>
+		int GetCurrentFramesPerSecond();
+
+		/// <summary>
+		/// Called once per frame in order to update the frame rate.
+		/// </summary>
+		/// <returns>Returns 0 or the current framerate if there is an update (once per second.)</returns>
+		int OnUpdate();
+
+	private:
+		Uint32 timeStampOfBeginingOfSecond;
+		int currentSecondsFrameCount;
+		int currentFramesPerSecond;
 	};
 
-	class ParticleEmitter
+	/// <summary>
+	/// Linear allocator for memory that only has to live for a frame. Allocating bumps a pointer
+	/// and everything is freed at once by <see cref="Reset"/>. If a frame needs more than the buffer holds
+	/// the extra comes from the heap, and the next reset grows the buffer so the following frames don't.
+	/// </summary>
+	class FrameAllocator
 	{
 	public:
-		ParticleEmitter();
-		~ParticleEmitter();
-		ParticleEmitter(float x, float y, float lifeInSeconds, Texture* texture, float speed = 0.5, int newParticlesPerSecond = 5, float startSizeMultiplier = 1.0, float endSizeMultiplier = 0.0, int maxParticles = 20000);
-		void OnUpdate(float deltaTime);
-		void OnRender();
-		bool active;
-		int newParticlesPerSecond;
-		float startOfSecond;
-		float particlesCreatedThisSecond;
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		/// <param name="capacity">The starting size of the buffer in bytes.</param>
+		FrameAllocator(size_t capacity = 256 * 1024);
+		~FrameAllocator();
+
+		FrameAllocator(const FrameAllocator&) = delete;
+		FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+		/// <summary>
+		/// Gets memory that stays valid until the next <see cref="Reset"/>.
+		/// </summary>
+		/// <param name="size">The number of bytes needed.</param>
+		/// <param name="alignment">The alignment of the memory, must be a power of two.</param>
+		/// <returns>Returns a pointer to the memory.</returns>
+		void* Allocate(size_t size, size_t alignment = alignof(max_align_t));
+
+		/// <summary>
+		/// Gets uninitialized room for count objects of type T.
+		/// </summary>
+		template <typename T>
+		T* Allocate(size_t count)
+		{
+			return (T*)Allocate(count * sizeof(T), alignof(T));
+		}
+
+		/// <summary>
+		/// Frees everything allocated since the last reset. Destructors are not called.
+		/// </summary>
+		void Reset();
+
+		/// <summary>
+		/// Gets the number of bytes handed out since the last reset.
+		/// </summary>
+		size_t GetUsed();
+
+		/// <summary>
+		/// Gets the size of the buffer in bytes.
+		/// </summary>
+		size_t GetCapacity();
+
 	private:
-		float x;
-		float y;
-		float lifeInMiliseconds;
-		Texture* texture;
-		float startSizeMultiplier = 1.0;
-		float endSizeMultiplier = 1.0;
-		float speed;
-		Particle* particlePool;
-		int currentParticlePoolIndex = 0;
-		int maxParticles;
+		/// <summary>
+		/// Heap block used when the buffer runs out, chained so they can be freed on reset.
+		/// </summary>
+		struct OverflowBlock
+		{
+			OverflowBlock* next;
+		};
+
+		char* buffer;
+		size_t capacity;
+		size_t used;
+		OverflowBlock* overflow;
+		size_t overflowSize;
+	};
+
+	/// <summary>
+	/// Lets STL containers get their memory from a <see cref="FrameAllocator"/>. Deallocating does nothing,
+	/// so the container must not outlive the allocator's next reset.
+	/// </summary>
+	template <typename T>
+	struct FrameAllocatorAdapter
+	{
+		typedef T value_type;
+
+		FrameAllocator* allocator;
+
+		FrameAllocatorAdapter(FrameAllocator* allocator) : allocator(allocator) {}
+
+		template <typename U>
+		FrameAllocatorAdapter(const FrameAllocatorAdapter<U>& other) : allocator(other.allocator) {}
+
+		T* allocate(size_t count)
+		{
+			return allocator->Allocate<T>(count);
+		}
+
+		void deallocate(T* pointer, size_t count) {}
+
+		template <typename U>
+		bool operator==(const FrameAllocatorAdapter<U>& other) const
+		{
+			return allocator == other.allocator;
+		}
+
+		template <typename U>
+		bool operator!=(const FrameAllocatorAdapter<U>& other) const
+		{
+			return allocator != other.allocator;
+		}
 	};
 
-	Engine::Engine()
+	/// <summary>
+	/// A vector whose storage comes from a <see cref="FrameAllocator"/>.
+	/// </summary>
+	template <typename T>
+	using FrameVector = std::vector<T, FrameAllocatorAdapter<T>>;
+
+	/// <summary>
+	/// The main class that games should create an instance of.
+	/// </summary>
+	class Engine
+	{
+	public:
+		/// <summary>
+		/// Default constructor.
+		/// </summary>
+		Engine();
+
+		/// <summary>
+		/// Overridable deconstructor.
+		/// </summary>
+		virtual ~Engine();
+
+		/// <summary>
+		/// First thing to call after creating an instance of <see cref="Engine"/>.
+		/// </summary>
+		/// <param name="name">The name of the game, will be displayed in the title bar.</param>
+		/// <param name="width">The width of the screen in pixels.</param>
+		/// <param name="height">The height of the screen in pixels.</param>
+		/// <param name="vsync">Indicates if the renderer should be created with vsync on.</param>
+		/// <param name="fullscreen">Indicates if the renderer should be created with fullscreen set.</param>
+		/// <returns>Returns a boolean indicating if creation was successful.</returns>
+		bool Create(std::string name, int width, int height, bool vsync, bool fullscreen);
+
+		/// <summary>
+		/// Called to start the game engines main game loop.
+		/// </summary>
+		/// <returns>Returns a boolean indicating if there was an issue.</returns>
+		bool Start();
+
+		/// <summary>
+		/// Called once at engine startup.
+		/// </summary>
+		/// <returns>Returns a boolean.</returns>
+		virtual bool OnCreate();
+
+		/// <summary>
+		/// Called once per frame after the engine is started.
+		/// </summary>
+		/// <param name="deltaTime">The time delta from the previous frame.</param>
+		/// <returns>Returns a boolean indicating if the engine should continue running.</returns>
+		virtual bool OnUpdate(float deltaTime);
+
+		/// <summary>
+		/// Called zero or more times per frame, once for every fixed time step that has passed.
+		/// The base implementation steps the physics world, so call it from your override.
+		/// </summary>
+		/// <param name="fixedDeltaTime">The fixed time step in milliseconds.</param>
+		/// <returns>Returns a boolean.</returns>
+		virtual bool OnFixedUpdate(float fixedDeltaTime);
+
+		/// <summary>
+		/// Called once per frame after update to render stuff
+		/// </summary>
+		/// <param name="deltaTime">The time delta from the previous frame.</param>
+		/// <returns>Returns a boolean indicating if the engine should continue running.</returns>
+		virtual bool OnRender(float deltaTime);
+
+		virtual bool OnEvent(SDL_Event event);
+
+		/// <summary>
+		/// Called before the engine terminates.
+		/// </summary>
+		/// <returns>Returns a boolean.</returns>
+		virtual bool OnDestroy();
+
+		/// <summary>
+		/// Adds an <see cref="Entity"/> to the engines vector of entites. Will be cleaned up by the engine.
+		/// </summary>
+		/// <param name="entity">The entity pointer to add to the vector.</param>
+		void AddEntity(Entity* entity);
+
+		/// <summary>
+		/// Adds an entity whose concrete type is known at compile time. Entities of the same type are
+		/// kept together so they can be updated and rendered in one loop without a virtual call per entity.
+		/// </summary>
+		/// <param name="entity">The entity pointer to add. Will be cleaned up by the engine.</param>
+		template <typename T>
+		void AddEntity(T* entity);
+
+		/// <summary>
+		/// Calls OnUpdate on every entity that has been added to the engine, one type bucket at a time.
+		/// </summary>
+		/// <param name="deltaTime">The time delta from the previous frame.</param>
+		void UpdateEntities(float deltaTime);
+
+		/// <summary>
+		/// Finds every pair of entities whose colliders are touching.
+		/// </summary>
+		/// <param name="contacts">Cleared and filled with a manifold for each touching pair.
+		/// The manifold's a and b index into <see cref="collisionWorld"/>, whose colliders point back at the entities.</param>
+		/// <returns>Returns the number of contacts found.</returns>
+		int FindEntityContacts(std::vector<ContactManifold>& contacts);
+
+		/// <summary>
+		/// Finds every pair of entities whose colliders are touching, into a buffer owned by <see cref="collisionWorld"/>.
+		/// </summary>
+		/// <returns>Returns the contacts, valid until the next call.</returns>
+		const std::vector<ContactManifold>& FindEntityContacts();
+
+		/// <summary>
+		/// Adds a body to the physics world that moves the given entity. The entity should not have a parent.
+		/// </summary>
+		/// <param name="entity">An entity that has a collider, like a <see cref="Rectangle"/> or <see cref="Circle"/>.</param>
+		/// <param name="mass">The mass of the body, 0 makes the body static.</param>
+		/// <returns>Returns the index of the body in <see cref="physicsWorld"/>, or -1 if the entity has no collider.</returns>
+		int AddRigidBody(Entity* entity, float mass);
+
+		/// <summary>
+		/// Draws a qaud with an optional rotation.
+		/// Realized this is kinda useless right now since SDL doesn't have a way
+		/// to actually fill in the geometry with a color.
+		/// </summary>
+		/// <param name="points">The array of points to draw.</param>
+		/// <param name="color">The color to make the quad</param>
+		/// <param name="rotation">The angle to rotate the quad in radians.</param>
+		void DrawQuad(SDL_FPoint* points, SDL_Color color, float rotation = 0.0);
+
+		/// <summary>
+		/// Gets the allocator for scratch memory of the current frame. It is reset at the start of every
+		/// <see cref="Update"/>, so nothing allocated from it may be kept past the end of the frame.
+		/// </summary>
+		/// <returns>Returns the current frame's allocator.</returns>
+		FrameAllocator& GetFrameAllocator();
+
+		/// <summary>
+		/// Gets the allocator the previous frame used. Its memory is still valid for this whole frame,
+		/// which is handy for handing results from one frame to the next.
+		/// </summary>
+		/// <returns>Returns the previous frame's allocator.</returns>
+		FrameAllocator& GetPreviousFrameAllocator();
+
+		/// <summary>
+		/// Gets a frame allocator owned by the calling thread, for worker threads that need scratch memory
+		/// without locking. It is reset the first time the thread asks for it in a new frame.
+		/// </summary>
+		/// <returns>Returns the calling thread's allocator.</returns>
+		FrameAllocator& GetThreadFrameAllocator();
+
+		/// <summary>
+		/// Gets how many heap allocations the last full frame made. Only counted when
+		/// CRISPY_OCTO_SPORK_COUNT_ALLOCATIONS is defined.
+		/// </summary>
+		/// <returns>Returns the number of allocations, or 0 when they aren't counted.</returns>
+		size_t GetFrameAllocationCount();
+
+	protected:
+		SDL_Window* window;
+		SDL_Renderer* renderer;
+		int screenWidth;
+		int screenHeight;
+		bool isVsyncEnabled;
+		bool isFullscreenEnabled;
+		std::string name;
+		bool isEngineRunning;
+		std::vector <Entity*> entities;
+
+		/// <summary>
+		/// Entities that share the same concrete type along with the loops used to update and render them.
+		/// </summary>
+		struct EntityBucket
+		{
+			const std::type_info* type;
+			std::vector<Entity*> entities;
+			void (*update)(std::vector<Entity*>& entities, float deltaTime);
+			void (*render)(std::vector<Entity*>& entities, float deltaTime);
+		};
+
+		std::vector<EntityBucket> entityBuckets;
+
+		/// <summary>
+		/// An entity added while the buckets were being looped over, put into its bucket once the loop is done.
+		/// </summary>
+		struct PendingEntity
+		{
+			Entity* entity;
+			const std::type_info* type;
+			void (*update)(std::vector<Entity*>& entities, float deltaTime);
+			void (*render)(std::vector<Entity*>& entities, float deltaTime);
+		};
+
+		std::vector<PendingEntity> pendingEntities;
+		bool isIteratingBuckets;
+		TransformHierarchy transforms;
+		CollisionWorld collisionWorld;
+		PhysicsWorld physicsWorld;
+		float fixedTimeStep;
+		float fixedTimeAccumulator;
+		float lastFrameTime;
+		FrameRate frameRate;
+		FrameAllocator frameAllocators[2];
+		int frameAllocatorIndex;
+		std::atomic<Uint32> frameCount;
+		size_t frameAllocationCount;
+		size_t frameStartAllocationCount;
+
+		/// <summary>
+		/// The main loop. To support emscripten the current <see cref="Engine"/> instance is passed in.
+		/// </summary>
+		/// <param name="arg">A pointer to the current <see cref="Engine"/> instance.</param>
+		static void Update(void* arg);
+
+		/// <summary>
+		/// Finds the bucket holding entities of the given type, creating it if it doesn't exist yet.
+		/// </summary>
+		/// <param name="type">The concrete type of the entities.</param>
+		/// <returns>Returns a pointer to the bucket.</returns>
+		EntityBucket* GetEntityBucket(const std::type_info& type);
+
+		/// <summary>
+		/// Puts an entity into the bucket for its type, or queues it when the buckets are being looped over.
+		/// </summary>
+		/// <param name="entity">The entity to add.</param>
+		/// <param name="type">The concrete type of the entity.</param>
+		/// <param name="update">The bucket's update loop, or nullptr to keep the one it has.</param>
+		/// <param name="render">The bucket's render loop, or nullptr to keep the one it has.</param>
+		void AddToEntityBucket(Entity* entity, const std::type_info& type,
+			void (*update)(std::vector<Entity*>& entities, float deltaTime),
+			void (*render)(std::vector<Entity*>& entities, float deltaTime));
+
+		/// <summary>
+		/// Moves the entities added during the last bucket loop into their buckets.
+		/// </summary>
+		void FlushPendingEntities();
+
+		template <typename T>
+		static void UpdateEntityBucket(std::vector<Entity*>& entities, float deltaTime);
+
+		template <typename T>
+		static void RenderEntityBucket(std::vector<Entity*>& entities, float deltaTime);
+
+		static void UpdateEntityBucketVirtual(std::vector<Entity*>& entities, float deltaTime);
+		static void RenderEntityBucketVirtual(std::vector<Entity*>& entities, float deltaTime);
+	};
+
+	class SoundEffect
+	{
+	public:
+		SoundEffect();
+		~SoundEffect();
+		bool LoadSoundFromFile(const char* filepath);
+		bool PlaySound();
+		void Free();
+	private:
+		Mix_Chunk* mixChunk;
+	};
+
+	/// <summary>
+	/// An object for holding texture information and to perform basic renders of it.
+	/// </summary>
+	class Texture
+	{
+	public:
+		/// <summary>
+		/// Default constructor.
+		/// </summary>
+		Texture();
+
+		/// <summary>
+		/// Creates a new instance of <see cref="Texture"/>.
+		/// </summary>
+		Texture(SDL_Renderer* renderer);
+
+		/// <summary>
+		/// Default deconstructor.
+		/// </summary>
+		~Texture();
+
+		/// <summary>
+		/// Populates the <see cref="SDL_Texture"/> from a file.
+		/// </summary>
+		/// <param name="filepath">The file path to load an image from for the texture.</param>
+		/// <returns>Returns a boolean indicating success.</returns>
+		bool LoadTextureFromFile(const char* filepath);
+
+		/// <summary>
+		/// Called to cleanup and free the texture.
+		/// </summary>
+		void Free();
+
+		/// <summary>
+		/// Renders the texture to the current <see cref="SDL_Renderer"/>.
+		/// </summary>
+		/// <param name="x">The x location to draw to.</param>
+		/// <param name="y">The y location to draw to.</param>
+		/// <param name="clip">The rectangle to pull texture information from. Useful for sprite sheets.</param>
+		/// <param name="angle">The angle at which to rotate the texture.</param>
+		/// <param name="center">The center to rotate about.</param>
+		/// <param name="flip">Determines if the texture will be flipped.</param>
+		/// <param name="alpha">The alpha to draw the texture with.</param>
+		/// <param name="scaleX">The horizontal scale to draw the texture with.</param>
+		/// <param name="scaleY">The vertical scale to draw the texture with.</param>
+		void Render(float x, float y, SDL_Rect* clip = NULL, float angle = 0.0, SDL_FPoint* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE, int alpha = 255, float scaleX = 1.0, float scaleY = 1.0);
+
+		/// <summary>
+		/// Gets the current renderer associated with this texture.
+		/// </summary>
+		/// <returns>Returns a pointer to a <see cref="SDL_Renderer"/>.</returns>
+		SDL_Renderer* GetRenderer();
+
+	private:
+		SDL_Texture* texture;
+		SDL_Renderer* renderer;
+		int width;
+		int height;
+	};
+
+	/// <summary>
+	/// Sprite class to hold an entity and a texture.
+	/// </summary>
+	class Sprite : public Entity
+	{
+	public:
+		/// <summary>
+		/// Default constructor.
+		/// </summary>
+		Sprite();
+
+		/// <summary>
+		/// Creates a new instance of <see cref="Sprite"/>.
+		/// </summary>
+		/// <param name="x">The x location of the sprite in the engine.</param>
+		/// <param name="y">The y location of the sprite in the engine.</param>
+		/// <param name="width">The width of the sprite.</param>
+		/// <param name="height">The height of the sprite.</param>
+		/// <param name="texture">A pointer to the texture to use for the sprite.</param>
+		/// <param name="renderer">A pointer to the renderer to render the sprite to.</param>
+		Sprite(float x, float y, float width, float height, Texture* texture, SDL_Renderer* renderer);
+
+		/// <summary>
+		/// Called once per frame. Renders the sprite to its current location.
+		/// </summary>
+		/// <param name="deltaTime">The delta time since the last frame.</param>
+		/// <returns>Returns a boolean indicating success.</returns>
+		virtual bool OnRender(float deltaTime);
+
+		/// <summary>
+		/// Gets the reflection info of the most derived type of this sprite.
+		/// </summary>
+		virtual const TypeInfo* GetTypeInfo();
+
+		/// <summary>
+		/// Gets the reflection info for <see cref="Sprite"/>.
+		/// </summary>
+		static const TypeInfo* StaticTypeInfo();
+
+	protected:
+		float width;
+		float height;
+		Texture* texture;
+		SDL_Renderer* renderer;
+
+	};
+
+	/// <summary>
+	/// Class to hold an entity represented by a rectangle.
+	/// </summary>
+	class Rectangle : public Entity
+	{
+	public:
+		/// <summary>
+		/// Default constructor.
+		/// </summary>
+		Rectangle();
+
+		/// <summary>
+		/// Creates a new instance of <see cref="Rectangle"/>.
+		/// </summary>
+		/// <param name="x">The x location of the rectangle in the engine.</param>
+		/// <param name="y">The y location of the rectangle in the engine.</param>
+		/// <param name="width">The width of the rectangle.</param>
+		/// <param name="height">The height of the rectangle.</param>
+		/// <param name="color">The color to draw the rectangle with.</param>
+		/// <param name="renderer">A pointer to the renderer to render the rectangle to.</param>
+		Rectangle(float x, float y, float width, float height, SDL_Color color, SDL_Renderer* renderer);
+
+		/// <summary>
+		/// Called once per frame. Renders the rectangle to its current location.
+		/// </summary>
+		/// <param name="deltaTime">The delta time since the last frame.</param>
+		/// <returns>Returns a boolean indicating success.</returns>
+		virtual bool OnRender(float deltaTime);
+
+		/// <summary>
+		/// Gets the rectangle as a box collider, oriented if the rectangle is rotated.
+		/// </summary>
+		/// <param name="collider">Filled in with the rectangle's collider.</param>
+		/// <returns>Returns true.</returns>
+		virtual bool GetCollider(Collider* collider);
+
+		/// <summary>
+		/// Gets the reflection info of the most derived type of this rectangle.
+		/// </summary>
+		virtual const TypeInfo* GetTypeInfo();
+
+		/// <summary>
+		/// Gets the reflection info for <see cref="Rectangle"/>.
+		/// </summary>
+		static const TypeInfo* StaticTypeInfo();
+
+	protected:
+		float width;
+		float height;
+		SDL_Color color;
+		SDL_Renderer* renderer;
+	};
+
+	/// <summary>
+	/// Class to hold an entity represented by a circle.
+	/// </summary>
+	class Circle : public Entity
+	{
+	public:
+		/// <summary>
+		/// Default constructor.
+		/// </summary>
+		Circle();
+
+		/// <summary>
+		/// Creates a new instance of <see cref="Circle"/>.
+		/// </summary>
+		/// <param name="x">The x location of the center of the circle.</param>
+		/// <param name="y">The y location of the center of the circle.</param>
+		/// <param name="radius">The radius of the circle</param>
+		/// <param name="color">The color to draw the circle with.</param>
+		/// <param name="renderer">A pointer to the renderer to render the circle to.</param>
+		Circle(float x, float y, float radius, SDL_Color color, SDL_Renderer* renderer);
+
+		/// <summary>
+		/// Called once per frame. Renders the circle to its current location.
+		/// </summary>
+		/// <param name="deltaTime">The delta time since the last frame.</param>
+		/// <returns>Returns a boolean indicating success.</returns>
+		virtual bool OnRender(float deltaTime);
+
+		/// <summary>
+		/// Gets the circle as a circle collider.
+		/// </summary>
+		/// <param name="collider">Filled in with the circle's collider.</param>
+		/// <returns>Returns true.</returns>
+		virtual bool GetCollider(Collider* collider);
+
+		/// <summary>
+		/// Gets the reflection info of the most derived type of this circle.
+		/// </summary>
+		virtual const TypeInfo* GetTypeInfo();
+
+		/// <summary>
+		/// Gets the reflection info for <see cref="Circle"/>.
+		/// </summary>
+		static const TypeInfo* StaticTypeInfo();
+
+	protected:
+		float radius;
+		SDL_Color color;
+		SDL_Renderer* renderer;
+	};
+
+	/// <summary>
+	/// Struct used to contain a single particle of a <see cref="ParticleEmitter"/>.
+	/// </summary>
+	struct Particle
+	{
+		float x = 0;
+		float y = 0;
+		float xVelocity = 0;
+		float yVelocity = 0;
+		float totalLifeTime = 0;
+		float lifeTimeRemaining = 0;
+		bool active = false;
+	};
+
+	class ParticleEmitter
+	{
+	public:
+		ParticleEmitter();
+		~ParticleEmitter();
+		ParticleEmitter(float x, float y, float lifeInSeconds, Texture* texture, float speed = 0.5, int newParticlesPerSecond = 5, float startSizeMultiplier = 1.0, float endSizeMultiplier = 0.0, int maxParticles = 20000);
+		void OnUpdate(float deltaTime);
+		void OnRender();
+
+		/// <summary>
+		/// Gets the reflection info for <see cref="ParticleEmitter"/>.
+		/// </summary>
+		static const TypeInfo* StaticTypeInfo();
+
+		bool active;
+		int newParticlesPerSecond;
+		float startOfSecond;
+		float particlesCreatedThisSecond;
+	private:
+		float x;
+		float y;
+		float lifeInMiliseconds;
+		Texture* texture;
+		float startSizeMultiplier = 1.0;
+		float endSizeMultiplier = 1.0;
+		float speed;
+		Particle* particlePool;
+		int currentParticlePoolIndex = 0;
+		int maxParticles;
+	};
+
+	Engine::Engine()
+	{
+		SDL_Init(SDL_INIT_VIDEO);
+
+		window = NULL;
+		renderer = NULL;
+		screenWidth = 0;
+		screenHeight = 0;
+		isVsyncEnabled = true;
+		isFullscreenEnabled = false;
+		name = "";
+		isEngineRunning = false;
+		isIteratingBuckets = false;
+		fixedTimeStep = 1000.0f / 60.0f;
+		fixedTimeAccumulator = 0;
+		lastFrameTime = 0;
+		frameAllocatorIndex = 0;
+		frameCount = 0;
+		frameAllocationCount = 0;
+		frameStartAllocationCount = 0;
+	}
+
+	Engine::~Engine()
+	{}
+
+	bool Engine::Create(std::string name, int width, int height, bool vsync, bool fullscreen)
+	{
+		this->name = name;
+		this->screenWidth = width;
+		this->screenHeight = height;
+		this->isVsyncEnabled = vsync;
+		this->isFullscreenEnabled = fullscreen;
+
+		Uint32 windowFlags = SDL_WINDOW_SHOWN;
+
+		if (this->isFullscreenEnabled)
+		{
+			windowFlags |= SDL_WINDOW_FULLSCREEN;
+		}
+
+		this->window = SDL_CreateWindow(this->name.c_str(),
+			SDL_WINDOWPOS_UNDEFINED,
+			SDL_WINDOWPOS_UNDEFINED,
+			this->screenWidth,
+			this->screenHeight,
+			windowFlags);
+
+		if (this->window == NULL)
+		{
+			Log("Failed to create window: %s", SDL_GetError());
+			return false;
+		}
+
+		Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+
+		if (this->isVsyncEnabled)
+		{
+			rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+		}
+
+		this->renderer = SDL_CreateRenderer(window, -1, rendererFlags);
+
+		if (renderer == NULL)
+		{
+			Log("Failed to create renderer: %s", SDL_GetError());
+			return false;
+		}
+
+		int imgFlags = IMG_INIT_PNG;
+		if (!(IMG_Init(imgFlags) & imgFlags))
+		{
+			Log("Failed to create renderer: %s", IMG_GetError());
+			return false;
+		}
+
+		if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0)
+		{
+			Log("Failed to start the mixer: %s", Mix_GetError());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Engine::Start()
+	{
+		isEngineRunning = true;
+
+		this->OnCreate();
+
+#ifdef __EMSCRIPTEN__
+		emscripten_set_main_loop_arg(Engine::Update, this, -1, 1);
+#else
+		while (isEngineRunning)
+		{
+			Update(this);
+		}
+#endif
+
+		OnDestroy();
+		SDL_Quit();
+		IMG_Quit();
+		return true;
+	}
+
+
+	void Engine::Update(void* arg)
+	{
+		Engine* engine = (Engine*)arg;
+
+		// swap frame buffers, last frame's scratch memory stays valid until the end of this one.
+		engine->frameCount++;
+		engine->frameAllocatorIndex ^= 1;
+		engine->frameAllocators[engine->frameAllocatorIndex].Reset();
+
+#ifdef CRISPY_OCTO_SPORK_COUNT_ALLOCATIONS
+		size_t allocations = allocationCount.load();
+		engine->frameAllocationCount = allocations - engine->frameStartAllocationCount;
+		engine->frameStartAllocationCount = allocations;
+#endif
+
+		SDL_Event event;
+		while (SDL_PollEvent(&event))
+		{
+			switch (event.type)
+			{
+			case SDL_QUIT:
+				engine->isEngineRunning = false;
+				break;
+			}
+
+			engine->OnEvent(event);
+		}
+
+		Uint32 currentFrameTime = SDL_GetTicks();
+		float deltaTime = currentFrameTime - engine->lastFrameTime;
+		engine->lastFrameTime = currentFrameTime;
+
+		// run as many fixed steps as have built up, capped so a long stall doesn't snowball.
+		const int maxFixedStepsPerFrame = 5;
+		engine->fixedTimeAccumulator = fminf(engine->fixedTimeAccumulator + deltaTime, engine->fixedTimeStep * maxFixedStepsPerFrame);
+
+		while (engine->fixedTimeAccumulator >= engine->fixedTimeStep)
+		{
+			engine->OnFixedUpdate(engine->fixedTimeStep);
+			engine->fixedTimeAccumulator -= engine->fixedTimeStep;
+		}
+
+		SDL_SetRenderDrawColor(engine->renderer, 135, 206, 235, 255);
+		SDL_RenderClear(engine->renderer);
+
+		engine->OnUpdate(deltaTime);
+		SDL_RenderPresent(engine->renderer);
+
+		if (engine->frameRate.OnUpdate() != 0.0)
+		{
+			char newWindowTitle[256];
+#ifdef CRISPY_OCTO_SPORK_COUNT_ALLOCATIONS
+			snprintf(newWindowTitle, sizeof(newWindowTitle), "%s - %d FPS - %f - %zu allocations", engine->name.c_str(), engine->frameRate.GetCurrentFramesPerSecond(), deltaTime, engine->frameAllocationCount);
+#else
+			snprintf(newWindowTitle, sizeof(newWindowTitle), "%s - %d FPS - %f", engine->name.c_str(), engine->frameRate.GetCurrentFramesPerSecond(), deltaTime);
+#endif
+			SDL_SetWindowTitle(engine->window, newWindowTitle);
+		}
+	}
+
+	bool Engine::OnCreate()
+	{
+		lastFrameTime = SDL_GetTicks();
+		return true;
+	}
+
+	bool Engine::OnUpdate(float deltaTime)
+	{
+		UpdateEntities(deltaTime);
+		OnRender(deltaTime);
+		return true;
+	}
+
+	bool Engine::OnFixedUpdate(float fixedDeltaTime)
+	{
+		physicsWorld.Step(fixedDeltaTime / 1000.0f);
+
+		for (int i = 0; i < physicsWorld.GetBodyCount(); i++)
+		{
+			RigidBody& body = physicsWorld.GetBody(i);
+
+			if (body.entity != NULL && body.inverseMass > 0 && !body.sleeping)
+			{
+				body.entity->x = body.shape.x + body.entityOffsetX;
+				body.entity->y = body.shape.y + body.entityOffsetY;
+			}
+		}
+
+		return true;
+	}
+
+	bool Engine::OnRender(float deltaTime)
+	{
+		isIteratingBuckets = true;
+		for (auto& bucket : entityBuckets)
+		{
+			bucket.render(bucket.entities, deltaTime);
+		}
+		isIteratingBuckets = false;
+		FlushPendingEntities();
+
+		return true;
+	}
+
+	void Engine::UpdateEntities(float deltaTime)
+	{
+		// entities can spawn others from OnUpdate, those wait until the loop is done so no bucket grows under it.
+		isIteratingBuckets = true;
+		for (auto& bucket : entityBuckets)
+		{
+			bucket.update(bucket.entities, deltaTime);
+		}
+		isIteratingBuckets = false;
+		FlushPendingEntities();
+
+		// push any movement from this frame into the hierarchy, only changed entities get marked dirty.
+		for (auto entity : entities)
+		{
+			transforms.SetLocal(entity->transform, entity->x, entity->y, entity->rotation, entity->scaleX, entity->scaleY);
+		}
+
+		transforms.Update();
+	}
+
+	int Engine::FindEntityContacts(std::vector<ContactManifold>& contacts)
+	{
+		contacts = FindEntityContacts();
+		return (int)contacts.size();
+	}
+
+	const std::vector<ContactManifold>& Engine::FindEntityContacts()
+	{
+		// entities are added in the same order every time, which keeps the broad-phase sort warm.
+		collisionWorld.Clear();
+		Collider collider;
+
+		for (auto entity : entities)
+		{
+			if (entity->GetCollider(&collider))
+			{
+				collider.entity = entity;
+				collisionWorld.AddCollider(collider);
+			}
+		}
+
+		return collisionWorld.FindContacts();
+	}
+
+	int Engine::AddRigidBody(Entity* entity, float mass)
+	{
+		Collider collider;
+
+		if (!entity->GetCollider(&collider))
+		{
+			return -1;
+		}
+
+		// bodies don't rotate, so treat the entity's box as axis aligned.
+		if (collider.type == COLLIDER_OBB)
+		{
+			collider.type = COLLIDER_AABB;
+			collider.rotation = 0;
+		}
+
+		int index = physicsWorld.AddBody(collider, mass);
+		RigidBody& body = physicsWorld.GetBody(index);
+		body.entity = entity;
+		body.entityOffsetX = entity->x - collider.x;
+		body.entityOffsetY = entity->y - collider.y;
+		return index;
+	}
+
+	bool Engine::OnEvent(SDL_Event event)
+	{
+		return true;
+	}
+
+	bool Engine::OnDestroy()
+	{
+		for (auto p : entities)
+		{
+			delete p;
+		}
+
+		entities.clear();
+		entityBuckets.clear();
+		pendingEntities.clear();
+		transforms.Clear();
+		collisionWorld.Clear();
+		physicsWorld.Clear();
+		return true;
+	}
+
+	void Engine::AddEntity(Entity* entity)
+	{
+		if (entity == NULL)
+		{
+			Log("AddEntity was given a null entity");
+			return;
+		}
+
+		entities.push_back(entity);
+		AddToEntityBucket(entity, typeid(*entity), nullptr, nullptr);
+
+		entity->transforms = &transforms;
+		entity->transform = transforms.Create(entity->x, entity->y, entity->rotation, entity->scaleX, entity->scaleY);
+	}
+
+	template <typename T>
+	void Engine::AddEntity(T* entity)
+	{
+		if (entity == NULL)
+		{
+			Log("AddEntity was given a null entity");
+			return;
+		}
+
+		// the pointer might be to something further derived than T, in which case
+		// we can't call T's methods directly and have to go through the vtable.
+		if (typeid(*entity) != typeid(T))
+		{
+			AddEntity(static_cast<Entity*>(entity));
+			return;
+		}
+
+		entities.push_back(entity);
+		AddToEntityBucket(entity, typeid(T), &Engine::UpdateEntityBucket<T>, &Engine::RenderEntityBucket<T>);
+
+		entity->transforms = &transforms;
+		entity->transform = transforms.Create(entity->x, entity->y, entity->rotation, entity->scaleX, entity->scaleY);
+	}
+
+	Engine::EntityBucket* Engine::GetEntityBucket(const std::type_info& type)
+	{
+		for (auto& bucket : entityBuckets)
+		{
+			if (*bucket.type == type)
+			{
+				return &bucket;
+			}
+		}
+
+		EntityBucket bucket;
+		bucket.type = &type;
+		bucket.update = &Engine::UpdateEntityBucketVirtual;
+		bucket.render = &Engine::RenderEntityBucketVirtual;
+		entityBuckets.push_back(bucket);
+
+		return &entityBuckets.back();
+	}
+
+	void Engine::AddToEntityBucket(Entity* entity, const std::type_info& type,
+		void (*update)(std::vector<Entity*>& entities, float deltaTime),
+		void (*render)(std::vector<Entity*>& entities, float deltaTime))
+	{
+		if (isIteratingBuckets)
+		{
+			pendingEntities.push_back({ entity, &type, update, render });
+			return;
+		}
+
+		EntityBucket* bucket = GetEntityBucket(type);
+
+		if (update != nullptr)
+		{
+			bucket->update = update;
+			bucket->render = render;
+		}
+
+		bucket->entities.push_back(entity);
+	}
+
+	void Engine::FlushPendingEntities()
+	{
+		for (auto& pending : pendingEntities)
+		{
+			AddToEntityBucket(pending.entity, *pending.type, pending.update, pending.render);
+		}
+
+		pendingEntities.clear();
+	}
+
+	template <typename T>
+	void Engine::UpdateEntityBucket(std::vector<Entity*>& entities, float deltaTime)
+	{
+		// every entity in here is exactly a T, so the qualified call is resolved at compile time.
+		for (auto entity : entities)
+		{
+			static_cast<T*>(entity)->T::OnUpdate(deltaTime);
+		}
+	}
+
+	template <typename T>
+	void Engine::RenderEntityBucket(std::vector<Entity*>& entities, float deltaTime)
+	{
+		for (auto entity : entities)
+		{
+			static_cast<T*>(entity)->T::OnRender(deltaTime);
+		}
+	}
+
+	void Engine::UpdateEntityBucketVirtual(std::vector<Entity*>& entities, float deltaTime)
+	{
+		for (auto entity : entities)
+		{
+			entity->OnUpdate(deltaTime);
+		}
+	}
+
+	void Engine::RenderEntityBucketVirtual(std::vector<Entity*>& entities, float deltaTime)
+	{
+		for (auto entity : entities)
+		{
+			entity->OnRender(deltaTime);
+		}
+	}
+
+	void Engine::DrawQuad(SDL_FPoint* points, SDL_Color color, float rotation)
+	{
+		SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+
+		// if we have a rotation then let's apply the rotation matrix.
+		if (rotation == 0.0)
+		{
+			SDL_RenderDrawLinesF(renderer, points, 4);
+			return;
+		}
+
+		SDL_FPoint rotatedPoints[4];
+
+		for (int i = 0; i < 3; i++)
+		{
+			rotatedPoints[i].x = (points[i].x * cosf(rotation)) - (points[i].y * sinf(rotation));
+			rotatedPoints[i].y = (points[i].x * sinf(rotation)) + (points[i].y * cosf(rotation));
+		}
+
+		SDL_RenderDrawLinesF(renderer, rotatedPoints, 4);
+	}
+
+	FrameAllocator& Engine::GetFrameAllocator()
+	{
+		return frameAllocators[frameAllocatorIndex];
+	}
+
+	FrameAllocator& Engine::GetPreviousFrameAllocator()
+	{
+		return frameAllocators[frameAllocatorIndex ^ 1];
+	}
+
+	FrameAllocator& Engine::GetThreadFrameAllocator()
+	{
+		thread_local FrameAllocator allocator(64 * 1024);
+		thread_local Uint32 lastFrame = 0;
+
+		// only tells this thread that a new frame began, the main thread's writes it doesn't need to see.
+		Uint32 frame = frameCount.load(std::memory_order_relaxed);
+
+		if (lastFrame != frame)
+		{
+			allocator.Reset();
+			lastFrame = frame;
+		}
+
+		return allocator;
+	}
+
+	size_t Engine::GetFrameAllocationCount()
+	{
+		return frameAllocationCount;
+	}
+
+	FrameAllocator::FrameAllocator(size_t capacity)
+	{
+		this->buffer = (char*)malloc(capacity);
+		this->capacity = capacity;
+		this->used = 0;
+		this->overflow = NULL;
+		this->overflowSize = 0;
+	}
+
+	FrameAllocator::~FrameAllocator()
+	{
+		Reset();
+		free(buffer);
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		// align the address rather than the offset, the buffer itself is only aligned for max_align_t.
+		uintptr_t base = (uintptr_t)buffer;
+		size_t start = (size_t)(((base + used + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base);
+
+		if (start + size <= capacity)
+		{
+			used = start + size;
+			return buffer + start;
+		}
+
+		// out of room, take this one from the heap and remember how much more the buffer should have held.
+		OverflowBlock* block = (OverflowBlock*)malloc(sizeof(OverflowBlock) + alignment - 1 + size);
+		block->next = overflow;
+		overflow = block;
+		overflowSize += size + alignment;
+
+#ifdef CRISPY_OCTO_SPORK_COUNT_ALLOCATIONS
+		allocationCount++;
+#endif
+
+		uintptr_t memory = (uintptr_t)(block + 1);
+		return (void*)((memory + alignment - 1) & ~(uintptr_t)(alignment - 1));
+	}
+
+	void FrameAllocator::Reset()
+	{
+		if (overflow != NULL)
+		{
+			while (overflow != NULL)
+			{
+				OverflowBlock* next = overflow->next;
+				free(overflow);
+				overflow = next;
+			}
+
+			// grow by at least half again so a frame that keeps creeping up doesn't overflow every time.
+			size_t newCapacity = capacity + overflowSize;
+			if (newCapacity < capacity + capacity / 2)
+			{
+				newCapacity = capacity + capacity / 2;
+			}
+
+			free(buffer);
+			buffer = (char*)malloc(newCapacity);
+			capacity = newCapacity;
+			overflowSize = 0;
+		}
+
+		used = 0;
+	}
+
+	size_t FrameAllocator::GetUsed()
+	{
+		return used + overflowSize;
+	}
+
+	size_t FrameAllocator::GetCapacity()
+	{
+		return capacity;
+	}
+
+	FrameRate::FrameRate()
+	{
+		timeStampOfBeginingOfSecond = SDL_GetTicks();
+		currentFramesPerSecond = 0.0;
+		currentSecondsFrameCount = 0;
+	}
+
+	int FrameRate::GetCurrentFramesPerSecond()
+	{
+		return currentFramesPerSecond;
+	}
+
+	int FrameRate::OnUpdate()
+	{
+		Uint32 currentFrameTime = SDL_GetTicks();
+
+		if (currentFrameTime - timeStampOfBeginingOfSecond >= 1000.0)
+		{
+			currentSecondsFrameCount++;
+			currentFramesPerSecond = currentSecondsFrameCount;
+			currentSecondsFrameCount = 0;
+			timeStampOfBeginingOfSecond = currentFrameTime;
+			return currentFramesPerSecond;
+		}
+
+		currentSecondsFrameCount++;
+		return 0;
+	}
+
+	Entity::Entity()
+	{
+		x = 0;
+		y = 0;
+		rotation = 0;
+		scaleX = 1;
+		scaleY = 1;
+		transform = -1;
+		transforms = NULL;
+	}
+
+	Entity::Entity(float x, float y)
+	{
+		this->x = x;
+		this->y = y;
+		this->rotation = 0;
+		this->scaleX = 1;
+		this->scaleY = 1;
+		this->transform = -1;
+		this->transforms = NULL;
+	}
+
+	bool Entity::SetParent(Entity* parent)
+	{
+		if (transforms == NULL)
+		{
+			return false;
+		}
+
+		if (parent == NULL)
+		{
+			return transforms->SetParent(transform, -1);
+		}
+
+		if (parent->transforms != transforms)
+		{
+			return false;
+		}
+
+		return transforms->SetParent(transform, parent->transform);
+	}
+
+	SDL_FPoint Entity::GetWorldPosition()
+	{
+		if (transforms == NULL)
+		{
+			return SDL_FPoint{ x, y };
+		}
+
+		const Matrix2D& world = transforms->GetWorld(transform);
+		return SDL_FPoint{ world.tx, world.ty };
+	}
+
+	float Entity::GetWorldRotation()
+	{
+		if (transforms == NULL)
+		{
+			return rotation;
+		}
+
+		return transforms->GetWorld(transform).GetRotation();
+	}
+
+	SDL_FPoint Entity::GetWorldScale()
+	{
+		if (transforms == NULL)
+		{
+			return SDL_FPoint{ scaleX, scaleY };
+		}
+
+		return transforms->GetWorld(transform).GetScale();
+	}
+
+	Sprite::Sprite()
+	{
+		this->width = 0;
+		this->height = 0;
+		this->texture = NULL;
+		this->renderer = NULL;
+	}
+
+	Sprite::Sprite(float x, float y, float width, float height, Texture* texture, SDL_Renderer* renderer) : Entity(x, y)
+	{
+		this->width = width;
+		this->height = height;
+		this->texture = texture;
+		this->renderer = renderer;
+	}
+
+	bool Sprite::OnRender(float deltaTime)
+	{
+		SDL_FPoint position = GetWorldPosition();
+		SDL_FPoint scale = GetWorldScale();
+
+		// rotate around the entity's origin so children stay attached at the right spot.
+		SDL_FPoint origin = { 0, 0 };
+		texture->Render(position.x, position.y, NULL, GetWorldRotation(), &origin, SDL_FLIP_NONE, 255, scale.x, scale.y);
+
+		return true;
+	}
+
+	Rectangle::Rectangle()
+	{
+		this->width = 0;
+		this->height = 0;
+		this->color = SDL_Color{ 255, 255, 255, 255 };
+		this->renderer = NULL;
+	}
+
+	Rectangle::Rectangle(float x, float y, float width, float height, SDL_Color color, SDL_Renderer* renderer) : Entity(x, y)
+	{
+		this->width = width;
+		this->height = height;
+		this->color = color;
+		this->renderer = renderer;
+	}
+
+	bool Rectangle::OnRender(float deltaTime)
+	{
+		SDL_SetRenderDrawColor(renderer, color.r, color.b, color.g, color.a);
+
+		// scaled the same way as GetCollider, so what is drawn is what collides.
+		if (transforms == NULL)
+		{
+			SDL_FPoint scale = GetWorldScale();
+			SDL_FRect rect = { x, y, width * scale.x, height * scale.y };
+			SDL_RenderFillRectF(renderer, &rect);
+			return true;
+		}
+
+		const Matrix2D& world = transforms->GetWorld(transform);
+
+		if (world.b == 0.0 && world.c == 0.0)
+		{
+			SDL_FRect rect = { world.tx, world.ty, width * world.a, height * world.d };
+			SDL_RenderFillRectF(renderer, &rect);
+			return true;
+		}
+
+		// rotated, so draw it as two triangles instead.
+		SDL_Color vertexColor = { color.r, color.b, color.g, color.a };
+		SDL_FPoint corners[4] = { { 0, 0 }, { width, 0 }, { width, height }, { 0, height } };
+		SDL_Vertex vertices[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			vertices[i].position = world.TransformPoint(corners[i]);
+			vertices[i].color = vertexColor;
+			vertices[i].tex_coord = SDL_FPoint{ 0, 0 };
+		}
+
+		int indices[6] = { 0, 1, 2, 0, 2, 3 };
+		SDL_RenderGeometry(renderer, NULL, vertices, 4, indices, 6);
+		return true;
+	}
+
+	bool Rectangle::GetCollider(Collider* collider)
+	{
+		SDL_FPoint scale = GetWorldScale();
+		float rotation = GetWorldRotation();
+		SDL_FPoint center = { x + width / 2 * scale.x, y + height / 2 * scale.y };
+
+		if (transforms != NULL)
+		{
+			center = transforms->GetWorld(transform).TransformPoint(SDL_FPoint{ width / 2, height / 2 });
+		}
+
+		collider->type = rotation == 0.0 ? COLLIDER_AABB : COLLIDER_OBB;
+		collider->x = center.x;
+		collider->y = center.y;
+		collider->halfWidth = width / 2 * fabsf(scale.x);
+		collider->halfHeight = height / 2 * fabsf(scale.y);
+		collider->rotation = rotation;
+		collider->radius = 0;
+		collider->entity = this;
+		return true;
+	}
+
+	Circle::Circle()
+	{
+		this->radius = 0;
+		this->color = SDL_Color{ 255, 255, 255, 255 };
+		this->renderer = NULL;
+	}
+
+	Circle::Circle(float x, float y, float radius, SDL_Color color, SDL_Renderer* renderer) : Entity(x, y)
+	{
+		this->radius = radius;
+		this->color = color;
+		this->renderer = renderer;
+	}
+
+	bool Circle::OnRender(float deltaTime)
+	{
+		SDL_SetRenderDrawColor(renderer, color.r, color.b, color.g, color.a);
+
+		SDL_FPoint position = GetWorldPosition();
+		float x = position.x;
+		float y = position.y;
+		float radius = this->radius * GetWorldScale().x;
+
+		for (int w = 0; w < radius * 2; w++)
+		{
+			for (int h = 0; h < radius * 2; h++)
+			{
+				int dx = radius - w; // horizontal offset
+				int dy = radius - h; // vertical offset
+				if ((dx * dx + dy * dy) <= (radius * radius))
+				{
+					SDL_RenderDrawPoint(renderer, x + dx, y + dy);
+				}
+			}
+		}
+		return true;
+	}
+
+	bool Circle::GetCollider(Collider* collider)
+	{
+		SDL_FPoint position = GetWorldPosition();
+		SDL_FPoint scale = GetWorldScale();
+
+		// a circle collider can't be stretched, so it covers the larger of the two scales.
+		collider->type = COLLIDER_CIRCLE;
+		collider->x = position.x;
+		collider->y = position.y;
+		collider->radius = radius * (fabsf(scale.x) > fabsf(scale.y) ? fabsf(scale.x) : fabsf(scale.y));
+		collider->halfWidth = collider->radius;
+		collider->halfHeight = collider->radius;
+		collider->rotation = 0;
+		collider->entity = this;
+		return true;
+	}
+
+	Entity::~Entity()
+	{
+	}
+
+	Matrix2D Matrix2D::FromTransform(float x, float y, float rotation, float scaleX, float scaleY)
+	{
+		float radians = rotation * (float)M_PI / 180.0f;
+		float cosine = cosf(radians);
+		float sine = sinf(radians);
+
+		Matrix2D m;
+		m.a = cosine * scaleX;
+		m.b = sine * scaleX;
+		m.c = -sine * scaleY;
+		m.d = cosine * scaleY;
+		m.tx = x;
+		m.ty = y;
+		return m;
+	}
+
+	Matrix2D Matrix2D::operator*(const Matrix2D& other) const
+	{
+		Matrix2D m;
+		m.a = a * other.a + c * other.b;
+		m.b = b * other.a + d * other.b;
+		m.c = a * other.c + c * other.d;
+		m.d = b * other.c + d * other.d;
+		m.tx = a * other.tx + c * other.ty + tx;
+		m.ty = b * other.tx + d * other.ty + ty;
+		return m;
+	}
+
+	SDL_FPoint Matrix2D::TransformPoint(SDL_FPoint point) const
+	{
+		return SDL_FPoint{ a * point.x + c * point.y + tx, b * point.x + d * point.y + ty };
+	}
+
+	float Matrix2D::GetRotation() const
+	{
+		return atan2f(b, a) * 180.0f / (float)M_PI;
+	}
+
+	SDL_FPoint Matrix2D::GetScale() const
+	{
+		return SDL_FPoint{ sqrtf(a * a + b * b), sqrtf(c * c + d * d) };
+	}
+
+	int TransformHierarchy::Create(float x, float y, float rotation, float scaleX, float scaleY)
+	{
+		int handle;
+
+		if (!freeHandles.empty())
+		{
+			handle = freeHandles.back();
+			freeHandles.pop_back();
+		}
+		else
+		{
+			handle = (int)handleToIndex.size();
+			handleToIndex.push_back(-1);
+			parentHandle.push_back(-1);
+		}
+
+		// a new node has no children yet, so appending it as a root keeps the depth ordering intact.
+		handleToIndex[handle] = (int)indexToHandle.size();
+		parentHandle[handle] = -1;
+
+		parentIndex.push_back(-1);
+		local.push_back(LocalTransform{ x, y, rotation, scaleX, scaleY });
+		world.push_back(Matrix2D::FromTransform(x, y, rotation, scaleX, scaleY));
+		dirty.push_back(1);
+		indexToHandle.push_back(handle);
+
+		return handle;
+	}
+
+	void TransformHierarchy::Destroy(int handle)
+	{
+		if (handle < 0 || handle >= (int)handleToIndex.size() || handleToIndex[handle] == -1)
+		{
+			return;
+		}
+
+		for (int i = 0; i < (int)parentHandle.size(); i++)
+		{
+			if (parentHandle[i] == handle)
+			{
+				parentHandle[i] = -1;
+				dirty[handleToIndex[i]] = 1;
+			}
+		}
+
+		// leave the slot in place until the next sort compacts the arrays.
+		indexToHandle[handleToIndex[handle]] = -1;
+		handleToIndex[handle] = -1;
+		parentHandle[handle] = -1;
+		freeHandles.push_back(handle);
+		needsSort = true;
+	}
+
+	void TransformHierarchy::Clear()
+	{
+		parentIndex.clear();
+		local.clear();
+		world.clear();
+		dirty.clear();
+		indexToHandle.clear();
+		handleToIndex.clear();
+		parentHandle.clear();
+		freeHandles.clear();
+		needsSort = false;
+	}
+
+	bool TransformHierarchy::SetParent(int handle, int parent)
+	{
+		if (handle < 0 || handle >= (int)handleToIndex.size() || handleToIndex[handle] == -1)
+		{
+			return false;
+		}
+
+		if (parent != -1)
+		{
+			if (parent >= (int)handleToIndex.size() || handleToIndex[parent] == -1)
+			{
+				return false;
+			}
+
+			// walk up from the new parent to make sure we aren't one of its ancestors.
+			for (int ancestor = parent; ancestor != -1; ancestor = parentHandle[ancestor])
+			{
+				if (ancestor == handle)
+				{
+					return false;
+				}
+			}
+		}
+
+		if (parentHandle[handle] == parent)
+		{
+			return true;
+		}
+
+		parentHandle[handle] = parent;
+		dirty[handleToIndex[handle]] = 1;
+		needsSort = true;
+		return true;
+	}
+
+	int TransformHierarchy::GetParent(int handle)
+	{
+		return parentHandle[handle];
+	}
+
+	void TransformHierarchy::SetLocal(int handle, float x, float y, float rotation, float scaleX, float scaleY)
+	{
+		int index = handleToIndex[handle];
+		LocalTransform& l = local[index];
+
+		if (l.x != x || l.y != y || l.rotation != rotation || l.scaleX != scaleX || l.scaleY != scaleY)
+		{
+			l = LocalTransform{ x, y, rotation, scaleX, scaleY };
+			dirty[index] = 1;
+		}
+	}
+
+	const Matrix2D& TransformHierarchy::GetWorld(int handle)
+	{
+		return world[handleToIndex[handle]];
+	}
+
+	void TransformHierarchy::Update()
+	{
+		if (needsSort)
+		{
+			Sort();
+		}
+
+		int count = (int)parentIndex.size();
+
+		// parents always come first, so by the time we get to a node its parent is final for this frame.
+		for (int i = 0; i < count; i++)
+		{
+			int parent = parentIndex[i];
+
+			if (parent != -1 && dirty[parent])
+			{
+				dirty[i] = 1;
+			}
+
+			if (dirty[i])
+			{
+				const LocalTransform& l = local[i];
+				Matrix2D m = Matrix2D::FromTransform(l.x, l.y, l.rotation, l.scaleX, l.scaleY);
+				world[i] = parent == -1 ? m : world[parent] * m;
+			}
+		}
+
+		std::fill(dirty.begin(), dirty.end(), 0);
+	}
+
+	void TransformHierarchy::Sort()
+	{
+		int handleCount = (int)handleToIndex.size();
+		std::vector<int> depth(handleCount, -1);
+		int maxDepth = 0;
+
+		for (int handle = 0; handle < handleCount; handle++)
+		{
+			if (handleToIndex[handle] == -1)
+			{
+				continue;
+			}
+
+			int d = 0;
+			for (int ancestor = parentHandle[handle]; ancestor != -1; ancestor = parentHandle[ancestor])
+			{
+				d++;
+			}
+
+			depth[handle] = d;
+			maxDepth = d > maxDepth ? d : maxDepth;
+		}
+
+		// counting sort by depth, keeping the existing order within a level.
+		std::vector<int> levelStart(maxDepth + 2, 0);
+		for (int handle : indexToHandle)
+		{
+			if (handle != -1)
+			{
+				levelStart[depth[handle] + 1]++;
+			}
+		}
+
+		for (int d = 1; d < (int)levelStart.size(); d++)
+		{
+			levelStart[d] += levelStart[d - 1];
+		}
+
+		int count = levelStart.back();
+		std::vector<int> sortedHandles(count);
+		std::vector<LocalTransform> sortedLocal(count);
+		std::vector<Matrix2D> sortedWorld(count);
+		std::vector<unsigned char> sortedDirty(count);
+
+		for (int i = 0; i < (int)indexToHandle.size(); i++)
+		{
+			int handle = indexToHandle[i];
+
+			if (handle == -1)
+			{
+				continue;
+			}
+
+			int to = levelStart[depth[handle]]++;
+			sortedHandles[to] = handle;
+			sortedLocal[to] = local[i];
+			sortedWorld[to] = world[i];
+			sortedDirty[to] = dirty[i];
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			handleToIndex[sortedHandles[i]] = i;
+		}
+
+		parentIndex.resize(count);
+		for (int i = 0; i < count; i++)
+		{
+			int parent = parentHandle[sortedHandles[i]];
+			parentIndex[i] = parent == -1 ? -1 : handleToIndex[parent];
+		}
+
+		indexToHandle.swap(sortedHandles);
+		local.swap(sortedLocal);
+		world.swap(sortedWorld);
+		dirty.swap(sortedDirty);
+		needsSort = false;
+	}
+
+	int CollisionWorld::AddCollider(const Collider& collider)
+	{
+		colliders.push_back(collider);
+		return (int)colliders.size() - 1;
+	}
+
+	Collider& CollisionWorld::GetCollider(int index)
+	{
+		return colliders[index];
+	}
+
+	int CollisionWorld::GetColliderCount()
+	{
+		return (int)colliders.size();
+	}
+
+	void CollisionWorld::Clear()
+	{
+		colliders.clear();
+		candidatePairs.clear();
+	}
+
+	SDL_FRect CollisionWorld::GetBounds(const Collider& collider)
+	{
+		SDL_FRect bounds;
+
+		if (collider.type == COLLIDER_CIRCLE)
+		{
+			bounds = SDL_FRect{ collider.x - collider.radius, collider.y - collider.radius, collider.radius * 2, collider.radius * 2 };
+		}
+		else
+		{
+			bounds = GetBoxBounds(collider);
+		}
+
+		if (collider.sweepX != 0.0 || collider.sweepY != 0.0)
+		{
+			bounds.x += fminf(collider.sweepX, 0.0f);
+			bounds.y += fminf(collider.sweepY, 0.0f);
+			bounds.w += fabsf(collider.sweepX);
+			bounds.h += fabsf(collider.sweepY);
+		}
+
+		return bounds;
+	}
+
+	SDL_FRect CollisionWorld::GetBoxBounds(const Collider& collider)
+	{
+
+		float halfWidth = collider.halfWidth;
+		float halfHeight = collider.halfHeight;
+
+		if (collider.type == COLLIDER_OBB)
+		{
+			float radians = collider.rotation * (float)M_PI / 180.0f;
+			float cosine = fabsf(cosf(radians));
+			float sine = fabsf(sinf(radians));
+			halfWidth = cosine * collider.halfWidth + sine * collider.halfHeight;
+			halfHeight = sine * collider.halfWidth + cosine * collider.halfHeight;
+		}
+
+		return SDL_FRect{ collider.x - halfWidth, collider.y - halfHeight, halfWidth * 2, halfHeight * 2 };
+	}
+
+	const std::vector<ColliderPair>& CollisionWorld::GetCandidatePairs()
+	{
+		return candidatePairs;
+	}
+
+	void CollisionWorld::UpdateBounds()
+	{
+		int count = (int)colliders.size();
+		minX.resize(count);
+		minY.resize(count);
+		maxX.resize(count);
+		maxY.resize(count);
+
+		for (int i = 0; i < count; i++)
+		{
+			SDL_FRect bounds = GetBounds(colliders[i]);
+			minX[i] = bounds.x;
+			minY[i] = bounds.y;
+			maxX[i] = bounds.x + bounds.w;
+			maxY[i] = bounds.y + bounds.h;
+		}
+
+		if ((int)sortedByMinX.size() != count)
+		{
+			sortedByMinX.resize(count);
+			for (int i = 0; i < count; i++)
+			{
+				sortedByMinX[i] = i;
+			}
+		}
+
+		// insertion sort, which is close to linear when things only moved a little since last time.
+		for (int i = 1; i < count; i++)
+		{
+			int index = sortedByMinX[i];
+			float value = minX[index];
+			int j = i - 1;
+
+			while (j >= 0 && minX[sortedByMinX[j]] > value)
+			{
+				sortedByMinX[j + 1] = sortedByMinX[j];
+				j--;
+			}
+
+			sortedByMinX[j + 1] = index;
+		}
+	}
+
+	const std::vector<ColliderPair>& CollisionWorld::FindCandidatePairs()
+	{
+		UpdateBounds();
+		candidatePairs.clear();
+
+		int count = (int)sortedByMinX.size();
+
+		for (int i = 0; i < count; i++)
+		{
+			int a = sortedByMinX[i];
+
+			for (int j = i + 1; j < count; j++)
+			{
+				int b = sortedByMinX[j];
+
+				if (minX[b] > maxX[a])
+				{
+					break;
+				}
+
+				if (!colliders[a].awake && !colliders[b].awake)
+				{
+					continue;
+				}
+
+				candidatePairs.push_back(a < b ? ColliderPair{ a, b } : ColliderPair{ b, a });
+			}
+		}
+
+		return candidatePairs;
+	}
+
+	void CollisionWorld::TestBoundsBatch(std::vector<ColliderPair>& overlapping)
 	{
-		SDL_Init(SDL_INIT_VIDEO);
+		int count = (int)candidatePairs.size();
+		int padded = (count + 3) & ~3;
 
-		window = NULL;
-		renderer = NULL;
-		screenWidth = 0;
-		screenHeight = 0;
-		isVsyncEnabled = true;
-		isFullscreenEnabled = false;
-		name = "";
-		isEngineRunning = false;
+		batchMinXA.resize(padded); batchMinYA.resize(padded); batchMaxXA.resize(padded); batchMaxYA.resize(padded);
+		batchMinXB.resize(padded); batchMinYB.resize(padded); batchMaxXB.resize(padded); batchMaxYB.resize(padded);
+
+		for (int i = 0; i < count; i++)
+		{
+			int a = candidatePairs[i].a;
+			int b = candidatePairs[i].b;
+			batchMinXA[i] = minX[a]; batchMinYA[i] = minY[a]; batchMaxXA[i] = maxX[a]; batchMaxYA[i] = maxY[a];
+			batchMinXB[i] = minX[b]; batchMinYB[i] = minY[b]; batchMaxXB[i] = maxX[b]; batchMaxYB[i] = maxY[b];
+		}
+
+		// padding lanes get an inverted box so they never report an overlap.
+		for (int i = count; i < padded; i++)
+		{
+			batchMinXA[i] = 1; batchMinYA[i] = 1; batchMaxXA[i] = 0; batchMaxYA[i] = 0;
+			batchMinXB[i] = 1; batchMinYB[i] = 1; batchMaxXB[i] = 0; batchMaxYB[i] = 0;
+		}
+
+		for (int i = 0; i < padded; i += 4)
+		{
+#ifdef CRISPY_OCTO_SPORK_SSE2
+			__m128 overlapX = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&batchMinXA[i]), _mm_loadu_ps(&batchMaxXB[i])),
+				_mm_cmple_ps(_mm_loadu_ps(&batchMinXB[i]), _mm_loadu_ps(&batchMaxXA[i])));
+			__m128 overlapY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&batchMinYA[i]), _mm_loadu_ps(&batchMaxYB[i])),
+				_mm_cmple_ps(_mm_loadu_ps(&batchMinYB[i]), _mm_loadu_ps(&batchMaxYA[i])));
+			int mask = _mm_movemask_ps(_mm_and_ps(overlapX, overlapY));
+#else
+			int mask = 0;
+			for (int lane = 0; lane < 4; lane++)
+			{
+				int k = i + lane;
+				bool overlap = batchMinXA[k] <= batchMaxXB[k] && batchMinXB[k] <= batchMaxXA[k] &&
+					batchMinYA[k] <= batchMaxYB[k] && batchMinYB[k] <= batchMaxYA[k];
+				mask |= overlap << lane;
+			}
+#endif
+			while (mask != 0)
+			{
+				int lane = 0;
+				while (!(mask & (1 << lane)))
+				{
+					lane++;
+				}
+
+				mask &= ~(1 << lane);
+				overlapping.push_back(candidatePairs[i + lane]);
+			}
+		}
 	}
 
-	Engine::~Engine()
-	{}
+	int CollisionWorld::FindContacts(std::vector<ContactManifold>& contacts)
+	{
+		contacts.clear();
+		FindCandidatePairs();
 
-	bool Engine::Create(std::string name, int width, int height, bool vsync, bool fullscreen)
+		overlappingPairs.clear();
+		TestBoundsBatch(overlappingPairs);
+
+		ContactManifold manifold;
+		for (auto& pair : overlappingPairs)
+		{
+			if (TestCollision(colliders[pair.a], colliders[pair.b], &manifold))
+			{
+				manifold.a = pair.a;
+				manifold.b = pair.b;
+				contacts.push_back(manifold);
+			}
+		}
+
+		return (int)contacts.size();
+	}
+
+	const std::vector<ContactManifold>& CollisionWorld::FindContacts()
 	{
-		this->name = name;
-		this->screenWidth = width;
-		this->screenHeight = height;
-		this->isVsyncEnabled = vsync;
-		this->isFullscreenEnabled = fullscreen;
+		FindContacts(contacts);
+		return contacts;
+	}
 
-		Uint32 windowFlags = SDL_WINDOW_SHOWN;
+	bool CollisionWorld::TestCollision(const Collider& a, const Collider& b, ContactManifold* manifold)
+	{
+		// boxes that aren't rotated can use the cheaper axis aligned tests.
+		ColliderType typeA = (a.type == COLLIDER_OBB && a.rotation == 0.0) ? COLLIDER_AABB : a.type;
+		ColliderType typeB = (b.type == COLLIDER_OBB && b.rotation == 0.0) ? COLLIDER_AABB : b.type;
+		bool hit = false;
 
-		if (this->isFullscreenEnabled)
+		if (typeA == COLLIDER_CIRCLE && typeB == COLLIDER_CIRCLE)
 		{
-			windowFlags |= SDL_WINDOW_FULLSCREEN;
+			return TestCircleCircle(a, b, manifold);
 		}
 
-		this->window = SDL_CreateWindow(this->name.c_str(),
-			SDL_WINDOWPOS_UNDEFINED,
-			SDL_WINDOWPOS_UNDEFINED,
-			this->screenWidth,
-			this->screenHeight,
-			windowFlags);
+		if (typeA == COLLIDER_CIRCLE || typeB == COLLIDER_CIRCLE)
+		{
+			bool circleIsA = typeA == COLLIDER_CIRCLE;
+			const Collider& circle = circleIsA ? a : b;
+			const Collider& box = circleIsA ? b : a;
+			ColliderType boxType = circleIsA ? typeB : typeA;
 
-		if (this->window == NULL)
+			hit = boxType == COLLIDER_AABB ? TestCircleAABB(circle, box, manifold) : TestCircleOBB(circle, box, manifold);
+
+			// the circle tests report a normal from the circle to the box.
+			if (hit && !circleIsA)
+			{
+				FlipManifold(manifold);
+			}
+
+			return hit;
+		}
+
+		if (typeA == COLLIDER_AABB && typeB == COLLIDER_AABB)
 		{
-			std::cout << "Failed to create window: " << SDL_GetError() << std::endl;
-			return false;
+			return TestAABBAABB(a, b, manifold);
 		}
 
-		Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+		return TestOBBOBB(a, b, manifold);
+	}
 
-		if (this->isVsyncEnabled)
+	bool CollisionWorld::RayCastAABB(float originX, float originY, float dx, float dy, float minX, float minY, float maxX, float maxY, float* t, float* normalX, float* normalY)
+	{
+		float entry = 0;
+		float exit = 1;
+		float nx = 0;
+		float ny = 0;
+		float origin[2] = { originX, originY };
+		float direction[2] = { dx, dy };
+		float minimum[2] = { minX, minY };
+		float maximum[2] = { maxX, maxY };
+
+		// slab test, one axis at a time.
+		for (int axis = 0; axis < 2; axis++)
 		{
-			rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+			if (fabsf(direction[axis]) < 0.000001f)
+			{
+				if (origin[axis] < minimum[axis] || origin[axis] > maximum[axis])
+				{
+					return false;
+				}
+
+				continue;
+			}
+
+			float inverse = 1.0f / direction[axis];
+			float tNear = (minimum[axis] - origin[axis]) * inverse;
+			float tFar = (maximum[axis] - origin[axis]) * inverse;
+			float sign = -1;
+
+			if (tNear > tFar)
+			{
+				float swap = tNear;
+				tNear = tFar;
+				tFar = swap;
+				sign = 1;
+			}
+
+			if (tNear > entry)
+			{
+				entry = tNear;
+				nx = axis == 0 ? sign : 0;
+				ny = axis == 1 ? sign : 0;
+			}
+
+			exit = fminf(exit, tFar);
+
+			if (entry > exit)
+			{
+				return false;
+			}
 		}
 
-		this->renderer = SDL_CreateRenderer(window, -1, rendererFlags);
+		*t = entry;
+		*normalX = nx;
+		*normalY = ny;
+		return true;
+	}
 
-		if (renderer == NULL)
+	bool CollisionWorld::RayCastCircle(float originX, float originY, float dx, float dy, float centerX, float centerY, float radius, float* t, float* normalX, float* normalY)
+	{
+		float mx = originX - centerX;
+		float my = originY - centerY;
+		float a = dx * dx + dy * dy;
+		float b = mx * dx + my * dy;
+		float c = mx * mx + my * my - radius * radius;
+
+		if (a < 0.000001f || (c > 0 && b > 0))
 		{
-			std::cout << "Failed to create renderer: " << SDL_GetError() << std::endl;
 			return false;
 		}
 
-		int imgFlags = IMG_INIT_PNG;
-		if (!(IMG_Init(imgFlags) & imgFlags))
+		float discriminant = b * b - a * c;
+		if (discriminant < 0)
 		{
-			std::cout << "Failed to create renderer: " << IMG_GetError() << std::endl;
 			return false;
 		}
 
-		if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0)
+		float hit = fmaxf((-b - sqrtf(discriminant)) / a, 0.0f);
+		if (hit > 1)
 		{
-			std::cout << "Failed to start the mixer: " << Mix_GetError() << std::endl;
 			return false;
 		}
 
+		float hitX = mx + dx * hit;
+		float hitY = my + dy * hit;
+		float length = sqrtf(hitX * hitX + hitY * hitY);
+
+		*t = hit;
+		*normalX = length > 0 ? hitX / length : 0;
+		*normalY = length > 0 ? hitY / length : 0;
 		return true;
 	}
 
-	bool Engine::Start()
+	bool CollisionWorld::SweepTest(const Collider& moving, float dx, float dy, const Collider& target, float* timeOfImpact, float* normalX, float* normalY)
 	{
-		isEngineRunning = true;
+		float t = 0;
+		float nx = 0;
+		float ny = 0;
+		bool hit = false;
 
-		this->OnCreate();
+		if (moving.type == COLLIDER_CIRCLE && target.type == COLLIDER_CIRCLE)
+		{
+			hit = RayCastCircle(moving.x, moving.y, dx, dy, target.x, target.y, moving.radius + target.radius, &t, &nx, &ny);
+		}
+		else if (moving.type == COLLIDER_CIRCLE || target.type == COLLIDER_CIRCLE)
+		{
+			// sweep the circle's center against the box grown by the radius, with rounded corners.
+			bool circleMoves = moving.type == COLLIDER_CIRCLE;
+			const Collider& circle = circleMoves ? moving : target;
+			const Collider& box = circleMoves ? target : moving;
+			float directionX = circleMoves ? dx : -dx;
+			float directionY = circleMoves ? dy : -dy;
+
+			SDL_FRect bounds = box.type == COLLIDER_OBB && box.rotation != 0.0 ? GetBounds(box) : SDL_FRect{ box.x - box.halfWidth, box.y - box.halfHeight, box.halfWidth * 2, box.halfHeight * 2 };
+			float left = bounds.x;
+			float top = bounds.y;
+			float right = bounds.x + bounds.w;
+			float bottom = bounds.y + bounds.h;
+			float r = circle.radius;
+			float bestT = 2;
+
+			float candidateT, candidateX, candidateY;
+			if (RayCastAABB(circle.x, circle.y, directionX, directionY, left - r, top, right + r, bottom, &candidateT, &candidateX, &candidateY) && candidateT < bestT)
+			{
+				bestT = candidateT; nx = candidateX; ny = candidateY;
+			}
+			if (RayCastAABB(circle.x, circle.y, directionX, directionY, left, top - r, right, bottom + r, &candidateT, &candidateX, &candidateY) && candidateT < bestT)
+			{
+				bestT = candidateT; nx = candidateX; ny = candidateY;
+			}
 
-#ifdef __EMSCRIPTEN__
-		emscripten_set_main_loop_arg(Engine::Update, this, -1, 1);
-#else
-		while (isEngineRunning)
+			float cornersX[4] = { left, right, right, left };
+			float cornersY[4] = { top, top, bottom, bottom };
+			for (int i = 0; i < 4; i++)
+			{
+				if (RayCastCircle(circle.x, circle.y, directionX, directionY, cornersX[i], cornersY[i], r, &candidateT, &candidateX, &candidateY) && candidateT < bestT)
+				{
+					bestT = candidateT; nx = candidateX; ny = candidateY;
+				}
+			}
+
+			hit = bestT <= 1;
+			t = bestT;
+
+			if (!circleMoves)
+			{
+				nx = -nx;
+				ny = -ny;
+			}
+		}
+		else
 		{
-			Update(this);
+			// two boxes, sweep the center against the target grown by the moving box. Rotated boxes
+			// fall back to their bounds which can report a hit slightly early but never misses.
+			SDL_FRect movingBounds = GetBounds(moving);
+			SDL_FRect targetBounds = GetBounds(target);
+			float halfWidth = movingBounds.w / 2;
+			float halfHeight = movingBounds.h / 2;
+
+			hit = RayCastAABB(movingBounds.x + halfWidth, movingBounds.y + halfHeight, dx, dy,
+				targetBounds.x - halfWidth, targetBounds.y - halfHeight,
+				targetBounds.x + targetBounds.w + halfWidth, targetBounds.y + targetBounds.h + halfHeight,
+				&t, &nx, &ny);
 		}
-#endif
 
-		OnDestroy();
-		SDL_Quit();
-		IMG_Quit();
+		if (!hit)
+		{
+			return false;
+		}
+
+		*timeOfImpact = t;
+		*normalX = nx;
+		*normalY = ny;
 		return true;
 	}
 
+	void CollisionWorld::FlipManifold(ContactManifold* manifold)
+	{
+		if (manifold != NULL)
+		{
+			manifold->normalX = -manifold->normalX;
+			manifold->normalY = -manifold->normalY;
+		}
+	}
 
-	void Engine::Update(void* arg)
+	bool CollisionWorld::TestCircleCircle(const Collider& a, const Collider& b, ContactManifold* manifold)
 	{
-		Engine* engine = (Engine*)arg;
+		float dx = b.x - a.x;
+		float dy = b.y - a.y;
+		float radii = a.radius + b.radius;
+		float distanceSquared = dx * dx + dy * dy;
 
-		SDL_Event event;
-		while (SDL_PollEvent(&event))
+		if (distanceSquared > radii * radii)
 		{
-			switch (event.type)
+			return false;
+		}
+
+		if (manifold != NULL)
+		{
+			float distance = sqrtf(distanceSquared);
+			float nx = 1;
+			float ny = 0;
+
+			if (distance > 0.0001f)
 			{
-			case SDL_QUIT:
-				engine->isEngineRunning = false;
-				break;
+				nx = dx / distance;
+				ny = dy / distance;
 			}
 
-			engine->OnEvent(event);
+			manifold->normalX = nx;
+			manifold->normalY = ny;
+			manifold->penetration = radii - distance;
+			manifold->pointCount = 1;
+			manifold->points[0] = SDL_FPoint{ a.x + nx * a.radius, a.y + ny * a.radius };
 		}
 
-		Uint32 currentFrameTime = SDL_GetTicks();
-		float deltaTime = currentFrameTime - engine->lastFrameTime;
-		engine->lastFrameTime = currentFrameTime;
+		return true;
+	}
 
-		SDL_SetRenderDrawColor(engine->renderer, 135, 206, 235, 255);
-		SDL_RenderClear(engine->renderer);
+	bool CollisionWorld::TestAABBAABB(const Collider& a, const Collider& b, ContactManifold* manifold)
+	{
+		float dx = b.x - a.x;
+		float dy = b.y - a.y;
+		float overlapX = a.halfWidth + b.halfWidth - fabsf(dx);
+		float overlapY = a.halfHeight + b.halfHeight - fabsf(dy);
 
-		engine->OnUpdate(deltaTime);
-		SDL_RenderPresent(engine->renderer);
+		if (overlapX < 0 || overlapY < 0)
+		{
+			return false;
+		}
 
-		if (engine->frameRate.OnUpdate() != 0.0)
+		if (manifold != NULL)
 		{
-			std::string newWindowTitle = engine->name + " - " + std::to_string(engine->frameRate.GetCurrentFramesPerSecond()) + " FPS - " + std::to_string(deltaTime);
-			SDL_SetWindowTitle(engine->window, newWindowTitle.c_str());
+			float left = fmaxf(a.x - a.halfWidth, b.x - b.halfWidth);
+			float right = fminf(a.x + a.halfWidth, b.x + b.halfWidth);
+			float top = fmaxf(a.y - a.halfHeight, b.y - b.halfHeight);
+			float bottom = fminf(a.y + a.halfHeight, b.y + b.halfHeight);
+
+			// push out along whichever axis has the least overlap, with the points on the face of b.
+			if (overlapX < overlapY)
+			{
+				float sign = dx < 0 ? -1.0f : 1.0f;
+				float face = b.x - sign * b.halfWidth;
+				manifold->normalX = sign;
+				manifold->normalY = 0;
+				manifold->penetration = overlapX;
+				manifold->points[0] = SDL_FPoint{ face, top };
+				manifold->points[1] = SDL_FPoint{ face, bottom };
+			}
+			else
+			{
+				float sign = dy < 0 ? -1.0f : 1.0f;
+				float face = b.y - sign * b.halfHeight;
+				manifold->normalX = 0;
+				manifold->normalY = sign;
+				manifold->penetration = overlapY;
+				manifold->points[0] = SDL_FPoint{ left, face };
+				manifold->points[1] = SDL_FPoint{ right, face };
+			}
+
+			manifold->pointCount = 2;
 		}
-	}
 
-	bool Engine::OnCreate()
-	{
-		lastFrameTime = SDL_GetTicks();
 		return true;
 	}
 
-	bool Engine::OnUpdate(float deltaTime)
+	bool CollisionWorld::TestCircleAABB(const Collider& circle, const Collider& box, ContactManifold* manifold)
 	{
-		return true;
-	}
+		float dx = circle.x - box.x;
+		float dy = circle.y - box.y;
+		float closestX = fmaxf(-box.halfWidth, fminf(box.halfWidth, dx));
+		float closestY = fmaxf(-box.halfHeight, fminf(box.halfHeight, dy));
+		bool inside = closestX == dx && closestY == dy;
 
-	bool Engine::OnRender(float deltaTime)
-	{
-		for (auto& entity : entities)
+		float offsetX = dx - closestX;
+		float offsetY = dy - closestY;
+		float distanceSquared = offsetX * offsetX + offsetY * offsetY;
+
+		if (!inside && distanceSquared > circle.radius * circle.radius)
 		{
-			entity->OnRender(deltaTime);
+			return false;
 		}
 
-		return true;
-	}
+		if (manifold == NULL)
+		{
+			return true;
+		}
 
-	bool Engine::OnEvent(SDL_Event event)
-	{
+		if (inside)
+		{
+			// center is inside the box, push out through the nearest face.
+			float toFaceX = box.halfWidth - fabsf(dx);
+			float toFaceY = box.halfHeight - fabsf(dy);
+
+			if (toFaceX < toFaceY)
+			{
+				float sign = dx < 0 ? -1.0f : 1.0f;
+				manifold->normalX = -sign;
+				manifold->normalY = 0;
+				manifold->penetration = toFaceX + circle.radius;
+				manifold->points[0] = SDL_FPoint{ box.x + sign * box.halfWidth, circle.y };
+			}
+			else
+			{
+				float sign = dy < 0 ? -1.0f : 1.0f;
+				manifold->normalX = 0;
+				manifold->normalY = -sign;
+				manifold->penetration = toFaceY + circle.radius;
+				manifold->points[0] = SDL_FPoint{ circle.x, box.y + sign * box.halfHeight };
+			}
+		}
+		else
+		{
+			float distance = sqrtf(distanceSquared);
+			manifold->normalX = -offsetX / distance;
+			manifold->normalY = -offsetY / distance;
+			manifold->penetration = circle.radius - distance;
+			manifold->points[0] = SDL_FPoint{ box.x + closestX, box.y + closestY };
+		}
+
+		manifold->pointCount = 1;
 		return true;
 	}
 
-	bool Engine::OnDestroy()
+	bool CollisionWorld::TestCircleOBB(const Collider& circle, const Collider& box, ContactManifold* manifold)
 	{
-		for (auto p : entities)
+		// move the circle into the box's space, test there, then rotate the result back out.
+		float radians = box.rotation * (float)M_PI / 180.0f;
+		float cosine = cosf(radians);
+		float sine = sinf(radians);
+		float dx = circle.x - box.x;
+		float dy = circle.y - box.y;
+
+		Collider localCircle = circle;
+		localCircle.x = box.x + dx * cosine + dy * sine;
+		localCircle.y = box.y - dx * sine + dy * cosine;
+
+		Collider localBox = box;
+		localBox.type = COLLIDER_AABB;
+		localBox.rotation = 0;
+
+		if (!TestCircleAABB(localCircle, localBox, manifold))
 		{
-			delete p;
+			return false;
+		}
+
+		if (manifold != NULL)
+		{
+			float nx = manifold->normalX;
+			float ny = manifold->normalY;
+			manifold->normalX = nx * cosine - ny * sine;
+			manifold->normalY = nx * sine + ny * cosine;
+
+			float px = manifold->points[0].x - box.x;
+			float py = manifold->points[0].y - box.y;
+			manifold->points[0].x = box.x + px * cosine - py * sine;
+			manifold->points[0].y = box.y + px * sine + py * cosine;
 		}
 
-		entities.clear();
 		return true;
 	}
 
-	void Engine::AddEntity(Entity* entity)
+	bool CollisionWorld::TestOBBOBB(const Collider& a, const Collider& b, ContactManifold* manifold)
 	{
-		entities.push_back(entity);
-	}
+		const Collider* boxes[2] = { &a, &b };
+		SDL_FPoint axes[2][2];
+		float extents[2][2];
 
-	void Engine::DrawQuad(SDL_FPoint* points, SDL_Color color, float rotation)
-	{
-		SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+		for (int i = 0; i < 2; i++)
+		{
+			float radians = boxes[i]->type == COLLIDER_OBB ? boxes[i]->rotation * (float)M_PI / 180.0f : 0.0f;
+			axes[i][0] = SDL_FPoint{ cosf(radians), sinf(radians) };
+			axes[i][1] = SDL_FPoint{ -sinf(radians), cosf(radians) };
+			extents[i][0] = boxes[i]->halfWidth;
+			extents[i][1] = boxes[i]->halfHeight;
+		}
+
+		float dx = b.x - a.x;
+		float dy = b.y - a.y;
+
+		// separating axis test on the two face normals of each box.
+		float bestSeparation = -FLT_MAX;
+		int bestBox = 0;
+		int bestAxis = 0;
+
+		for (int i = 0; i < 2; i++)
+		{
+			for (int k = 0; k < 2; k++)
+			{
+				SDL_FPoint axis = axes[i][k];
+				float distance = fabsf(dx * axis.x + dy * axis.y);
+				float projection = 0;
+
+				for (int j = 0; j < 2; j++)
+				{
+					for (int m = 0; m < 2; m++)
+					{
+						projection += extents[j][m] * fabsf(axes[j][m].x * axis.x + axes[j][m].y * axis.y);
+					}
+				}
+
+				float separation = distance - projection;
+
+				if (separation > 0)
+				{
+					return false;
+				}
+
+				// slightly prefer the faces of a so the reference face doesn't flip between frames.
+				if (separation > bestSeparation + (i == 1 ? 0.001f : 0.0f))
+				{
+					bestSeparation = separation;
+					bestBox = i;
+					bestAxis = k;
+				}
+			}
+		}
+
+		if (manifold == NULL)
+		{
+			return true;
+		}
+
+		int reference = bestBox;
+		int incident = 1 - bestBox;
+		const Collider* referenceBox = boxes[reference];
+		const Collider* incidentBox = boxes[incident];
+
+		SDL_FPoint normal = axes[reference][bestAxis];
+		float toIncidentX = incidentBox->x - referenceBox->x;
+		float toIncidentY = incidentBox->y - referenceBox->y;
+
+		if (normal.x * toIncidentX + normal.y * toIncidentY < 0)
+		{
+			normal = SDL_FPoint{ -normal.x, -normal.y };
+		}
+
+		SDL_FPoint tangent = axes[reference][1 - bestAxis];
+		float tangentExtent = extents[reference][1 - bestAxis];
+		SDL_FPoint faceCenter = {
+			referenceBox->x + normal.x * extents[reference][bestAxis],
+			referenceBox->y + normal.y * extents[reference][bestAxis]
+		};
+
+		// the incident face is the one on the other box that faces most against the normal.
+		int incidentAxis = 0;
+		if (fabsf(axes[incident][1].x * normal.x + axes[incident][1].y * normal.y) >
+			fabsf(axes[incident][0].x * normal.x + axes[incident][0].y * normal.y))
+		{
+			incidentAxis = 1;
+		}
+
+		SDL_FPoint incidentNormal = axes[incident][incidentAxis];
+		if (incidentNormal.x * normal.x + incidentNormal.y * normal.y > 0)
+		{
+			incidentNormal = SDL_FPoint{ -incidentNormal.x, -incidentNormal.y };
+		}
+
+		SDL_FPoint incidentTangent = axes[incident][1 - incidentAxis];
+		float incidentExtent = extents[incident][incidentAxis];
+		float incidentTangentExtent = extents[incident][1 - incidentAxis];
+		SDL_FPoint incidentCenter = {
+			incidentBox->x + incidentNormal.x * incidentExtent,
+			incidentBox->y + incidentNormal.y * incidentExtent
+		};
+
+		SDL_FPoint segment[2] = {
+			{ incidentCenter.x - incidentTangent.x * incidentTangentExtent, incidentCenter.y - incidentTangent.y * incidentTangentExtent },
+			{ incidentCenter.x + incidentTangent.x * incidentTangentExtent, incidentCenter.y + incidentTangent.y * incidentTangentExtent }
+		};
+
+		// clip the incident edge against both sides of the reference face.
+		float faceOffset = tangent.x * faceCenter.x + tangent.y * faceCenter.y;
+		for (int side = -1; side <= 1; side += 2)
+		{
+			float limit = side * faceOffset + tangentExtent;
+			float distance0 = side * (tangent.x * segment[0].x + tangent.y * segment[0].y) - limit;
+			float distance1 = side * (tangent.x * segment[1].x + tangent.y * segment[1].y) - limit;
+
+			if (distance0 > 0 && distance1 > 0)
+			{
+				return false;
+			}
+
+			if (distance0 > 0 || distance1 > 0)
+			{
+				float t = distance0 / (distance0 - distance1);
+				SDL_FPoint clipped = {
+					segment[0].x + t * (segment[1].x - segment[0].x),
+					segment[0].y + t * (segment[1].y - segment[0].y)
+				};
+
+				segment[distance0 > 0 ? 0 : 1] = clipped;
+			}
+		}
 
-		// if we have a rotation then let's apply the rotation matrix.
-		if (rotation == 0.0)
+		manifold->pointCount = 0;
+		manifold->penetration = 0;
+
+		for (int i = 0; i < 2; i++)
 		{
-			SDL_RenderDrawLinesF(renderer, points, 4);
-			return;
-		}
+			float separation = normal.x * (segment[i].x - faceCenter.x) + normal.y * (segment[i].y - faceCenter.y);
 
-		SDL_FPoint rotatedPoints[4];
+			if (separation <= 0)
+			{
+				manifold->points[manifold->pointCount++] = segment[i];
+				manifold->penetration = fmaxf(manifold->penetration, -separation);
+			}
+		}
 
-		for (int i = 0; i < 3; i++)
+		if (manifold->pointCount == 0)
 		{
-			rotatedPoints[i].x = (points[i].x * cosf(rotation)) - (points[i].y * sinf(rotation));
-			rotatedPoints[i].y = (points[i].x * sinf(rotation)) + (points[i].y * cosf(rotation));
+			return false;
 		}
 
-		SDL_RenderDrawLinesF(renderer, rotatedPoints, 4);
+		// the normal should always point from a to b.
+		manifold->normalX = reference == 0 ? normal.x : -normal.x;
+		manifold->normalY = reference == 0 ? normal.y : -normal.y;
+		return true;
 	}
 
-	FrameRate::FrameRate()
+	PhysicsWorld::PhysicsWorld()
 	{
-		timeStampOfBeginingOfSecond = SDL_GetTicks();
-		currentFramesPerSecond = 0.0;
-		currentSecondsFrameCount = 0;
+		gravityX = 0;
+		gravityY = 980;
+		iterations = 10;
+		sleepingEnabled = true;
+		sleepVelocity = 5;
+		timeToSleep = 0.5f;
 	}
 
-	int FrameRate::GetCurrentFramesPerSecond()
+	int PhysicsWorld::AddBody(const Collider& shape, float mass)
 	{
-		return currentFramesPerSecond;
+		RigidBody body;
+		body.shape = shape;
+		body.inverseMass = mass > 0 ? 1.0f / mass : 0.0f;
+		bodies.push_back(body);
+		return (int)bodies.size() - 1;
 	}
 
-	int FrameRate::OnUpdate()
+	RigidBody& PhysicsWorld::GetBody(int index)
 	{
-		Uint32 currentFrameTime = SDL_GetTicks();
-
-		if (currentFrameTime - timeStampOfBeginingOfSecond >= 1000.0)
-		{
-			currentSecondsFrameCount++;
-			currentFramesPerSecond = currentSecondsFrameCount;
-			currentSecondsFrameCount = 0;
-			timeStampOfBeginingOfSecond = currentFrameTime;
-			return currentFramesPerSecond;
-		}
-
-		currentSecondsFrameCount++;
-		return 0;
+		return bodies[index];
 	}
 
-	Entity::Entity()
+	int PhysicsWorld::GetBodyCount()
 	{
-		x = 0;
-		y = 0;
+		return (int)bodies.size();
 	}
 
-	Entity::Entity(float x, float y)
+	void PhysicsWorld::WakeBody(int index)
 	{
-		this->x = x;
-		this->y = y;
+		bodies[index].sleeping = false;
+		bodies[index].sleepTime = 0;
 	}
 
-	Sprite::Sprite()
+	void PhysicsWorld::Clear()
 	{
-		this->width = 0;
-		this->height = 0;
-		this->texture = NULL;
-		this->renderer = NULL;
+		bodies.clear();
+		collisionWorld.Clear();
+		cachedImpulses.clear();
 	}
 
-	Sprite::Sprite(float x, float y, float width, float height, Texture* texture, SDL_Renderer* renderer) : Entity(x, y)
+	bool PhysicsWorld::IsAwake(const RigidBody& body)
 	{
-		this->width = width;
-		this->height = height;
-		this->texture = texture;
-		this->renderer = renderer;
+		return body.inverseMass > 0 && !body.sleeping;
 	}
 
-	bool Sprite::OnRender(float deltaTime)
+	void PhysicsWorld::Step(float timeStep)
 	{
-		texture->Render(x, y);
+		const float penetrationSlop = 0.5f;
+		const float baumgarte = 0.2f;
+		const float restitutionThreshold = 60.0f;
 
-		return true;
-	}
+		int bodyCount = (int)bodies.size();
 
-	Rectangle::Rectangle()
-	{
-		this->width = 0;
-		this->height = 0;
-		this->color = SDL_Color{ 255, 255, 255, 255 };
-		this->renderer = NULL;
-	}
+		for (auto& body : bodies)
+		{
+			if (IsAwake(body))
+			{
+				body.velocityX += gravityX * timeStep;
+				body.velocityY += gravityY * timeStep;
+			}
+		}
 
-	Rectangle::Rectangle(float x, float y, float width, float height, SDL_Color color, SDL_Renderer* renderer) : Entity(x, y)
-	{
-		this->width = width;
-		this->height = height;
-		this->color = color;
-		this->renderer = renderer;
+		// collider indices line up with body indices. Static and sleeping bodies are marked as not
+		// awake, so pairs of them are skipped by the broad-phase.
+		collisionWorld.Clear();
+		for (auto& body : bodies)
+		{
+			Collider collider = body.shape;
+			collider.awake = IsAwake(body);
+
+			if (body.bullet && collider.awake)
+			{
+				collider.sweepX = body.velocityX * timeStep;
+				collider.sweepY = body.velocityY * timeStep;
+			}
+
+			collisionWorld.AddCollider(collider);
+		}
+
+		collisionWorld.FindContacts(manifolds);
+
+		constraints.clear();
+		for (auto& manifold : manifolds)
+		{
+			RigidBody& a = bodies[manifold.a];
+			RigidBody& b = bodies[manifold.b];
+
+			// a sleeping body acts as if it were static for the rest of this step and is woken at the end.
+			float inverseMassA = IsAwake(a) ? a.inverseMass : 0.0f;
+			float inverseMassB = IsAwake(b) ? b.inverseMass : 0.0f;
+
+			if (inverseMassA + inverseMassB == 0)
+			{
+				continue;
+			}
+
+			ContactConstraint constraint;
+			constraint.a = manifold.a;
+			constraint.b = manifold.b;
+			constraint.normalX = manifold.normalX;
+			constraint.normalY = manifold.normalY;
+			constraint.penetration = manifold.penetration;
+			constraint.normalMass = 1.0f / (inverseMassA + inverseMassB);
+			constraint.friction = sqrtf(a.friction * b.friction);
+
+			float relativeVelocity = (b.velocityX - a.velocityX) * constraint.normalX + (b.velocityY - a.velocityY) * constraint.normalY;
+			constraint.bias = baumgarte / timeStep * fmaxf(manifold.penetration - penetrationSlop, 0.0f);
+
+			if (relativeVelocity < -restitutionThreshold)
+			{
+				constraint.bias = fmaxf(constraint.bias, -fmaxf(a.restitution, b.restitution) * relativeVelocity);
+			}
+
+			// warm start with whatever this pair needed last step.
+			CachedImpulse search = { ((unsigned long long)manifold.a << 32) | (unsigned int)manifold.b, 0.0f, 0.0f };
+			auto cached = std::lower_bound(cachedImpulses.begin(), cachedImpulses.end(), search);
+			bool found = cached != cachedImpulses.end() && cached->key == search.key;
+			constraint.normalImpulse = found ? cached->normalImpulse : 0.0f;
+			constraint.tangentImpulse = found ? cached->tangentImpulse : 0.0f;
+
+			float impulseX = constraint.normalX * constraint.normalImpulse - constraint.normalY * constraint.tangentImpulse;
+			float impulseY = constraint.normalY * constraint.normalImpulse + constraint.normalX * constraint.tangentImpulse;
+			a.velocityX -= impulseX * inverseMassA;
+			a.velocityY -= impulseY * inverseMassA;
+			b.velocityX += impulseX * inverseMassB;
+			b.velocityY += impulseY * inverseMassB;
+
+			constraints.push_back(constraint);
+		}
+
+		for (int i = 0; i < iterations; i++)
+		{
+			for (auto& constraint : constraints)
+			{
+				SolveConstraint(constraint);
+			}
+		}
+
+		// kept sorted by pair in a flat array that is reused every step, so warm starting allocates nothing once it has grown.
+		cachedImpulses.clear();
+		for (auto& constraint : constraints)
+		{
+			unsigned long long key = ((unsigned long long)constraint.a << 32) | (unsigned int)constraint.b;
+			cachedImpulses.push_back({ key, constraint.normalImpulse, constraint.tangentImpulse });
+		}
+		std::sort(cachedImpulses.begin(), cachedImpulses.end());
+
+		SweepBullets(timeStep);
+
+		for (int i = 0; i < bodyCount; i++)
+		{
+			RigidBody& body = bodies[i];
+
+			if (IsAwake(body))
+			{
+				body.shape.x += body.velocityX * timeStep;
+				body.shape.y += body.velocityY * timeStep;
+			}
+		}
+
+		UpdateSleeping(timeStep);
 	}
 
-	bool Rectangle::OnRender(float deltaTime)
+	void PhysicsWorld::SweepBullets(float timeStep)
 	{
-		SDL_SetRenderDrawColor(renderer, color.r, color.b, color.g, color.a);
-		SDL_FRect rect = { x, y, width, height };
-		SDL_RenderFillRectF(renderer, &rect);
-		return false;
+		const std::vector<ColliderPair>& pairs = collisionWorld.GetCandidatePairs();
+		int bodyCount = (int)bodies.size();
+
+		for (int i = 0; i < bodyCount; i++)
+		{
+			RigidBody& bullet = bodies[i];
+
+			if (!bullet.bullet || !IsAwake(bullet))
+			{
+				continue;
+			}
+
+			// each impact uses up part of the step, the bullet keeps going with what is left until it is
+			// used up or it has hit maxImpacts things.
+			const int maxImpacts = 4;
+			const float skin = 0.01f;
+			float remaining = 1;
+
+			for (int impact = 0; impact < maxImpacts && remaining > 0; impact++)
+			{
+				float dx = bullet.velocityX * timeStep * remaining;
+				float dy = bullet.velocityY * timeStep * remaining;
+				float earliest = 1;
+				float normalX = 0;
+				float normalY = 0;
+				int hitBody = -1;
+
+				auto sweepAgainst = [&](int other)
+				{
+					// bullets only sweep against things that aren't bullets themselves.
+					if (bodies[other].bullet && IsAwake(bodies[other]))
+					{
+						return;
+					}
+
+					float t, nx, ny;
+					if (CollisionWorld::SweepTest(bullet.shape, dx, dy, bodies[other].shape, &t, &nx, &ny))
+					{
+						// already touching is the contact solver's job, only moving into something counts.
+						if (t > 0 && t < earliest && nx * dx + ny * dy < 0)
+						{
+							earliest = t;
+							normalX = nx;
+							normalY = ny;
+							hitBody = other;
+						}
+					}
+				};
+
+				if (impact == 0)
+				{
+					for (auto& pair : pairs)
+					{
+						if (pair.a == i || pair.b == i)
+						{
+							sweepAgainst(pair.a == i ? pair.b : pair.a);
+						}
+					}
+				}
+				else
+				{
+					// the broad-phase only knew the direction the bullet had before it bounced, so after a bounce
+					// everything whose bounds the rest of the sweep crosses is checked.
+					Collider swept = bullet.shape;
+					swept.sweepX = dx;
+					swept.sweepY = dy;
+					SDL_FRect sweptBounds = CollisionWorld::GetBounds(swept);
+
+					for (int other = 0; other < bodyCount; other++)
+					{
+						SDL_FRect bounds = CollisionWorld::GetBounds(bodies[other].shape);
+
+						if (other != i &&
+							bounds.x <= sweptBounds.x + sweptBounds.w && sweptBounds.x <= bounds.x + bounds.w &&
+							bounds.y <= sweptBounds.y + sweptBounds.h && sweptBounds.y <= bounds.y + bounds.h)
+						{
+							sweepAgainst(other);
+						}
+					}
+				}
+
+				if (hitBody == -1)
+				{
+					break;
+				}
+
+				// move up to the point of impact and bounce off the surface.
+				float travelled = fmaxf(earliest - skin, 0.0f);
+				bullet.shape.x += dx * travelled;
+				bullet.shape.y += dy * travelled;
+				remaining *= 1 - travelled;
+
+				float restitution = fmaxf(bullet.restitution, bodies[hitBody].restitution);
+				float normalVelocity = bullet.velocityX * normalX + bullet.velocityY * normalY;
+				bullet.velocityX -= (1 + restitution) * normalVelocity * normalX;
+				bullet.velocityY -= (1 + restitution) * normalVelocity * normalY;
+
+				if (!IsAwake(bodies[hitBody]) && bodies[hitBody].inverseMass > 0)
+				{
+					WakeBody(hitBody);
+				}
+			}
+
+			// the integration that follows moves a whole step, so take back the part we already used.
+			bullet.shape.x -= bullet.velocityX * timeStep * (1 - remaining);
+			bullet.shape.y -= bullet.velocityY * timeStep * (1 - remaining);
+		}
 	}
 
-	Circle::Circle()
+	void PhysicsWorld::SolveConstraint(ContactConstraint& constraint)
 	{
-		this->radius = 0;
-		this->color = SDL_Color{ 255, 255, 255, 255 };
-		this->renderer = NULL;
+		RigidBody& a = bodies[constraint.a];
+		RigidBody& b = bodies[constraint.b];
+		float inverseMassA = IsAwake(a) ? a.inverseMass : 0.0f;
+		float inverseMassB = IsAwake(b) ? b.inverseMass : 0.0f;
+		float nx = constraint.normalX;
+		float ny = constraint.normalY;
+
+		// normal impulse, accumulated and clamped so the bodies are only ever pushed apart.
+		float relativeX = b.velocityX - a.velocityX;
+		float relativeY = b.velocityY - a.velocityY;
+		float normalVelocity = relativeX * nx + relativeY * ny;
+		float impulse = constraint.normalMass * (constraint.bias - normalVelocity);
+		float oldImpulse = constraint.normalImpulse;
+		constraint.normalImpulse = fmaxf(oldImpulse + impulse, 0.0f);
+		impulse = constraint.normalImpulse - oldImpulse;
+
+		a.velocityX -= nx * impulse * inverseMassA;
+		a.velocityY -= ny * impulse * inverseMassA;
+		b.velocityX += nx * impulse * inverseMassB;
+		b.velocityY += ny * impulse * inverseMassB;
+
+		// friction along the tangent, limited by the normal impulse.
+		relativeX = b.velocityX - a.velocityX;
+		relativeY = b.velocityY - a.velocityY;
+		float tangentVelocity = relativeX * -ny + relativeY * nx;
+		float maxFriction = constraint.friction * constraint.normalImpulse;
+		impulse = -constraint.normalMass * tangentVelocity;
+		oldImpulse = constraint.tangentImpulse;
+		constraint.tangentImpulse = fmaxf(-maxFriction, fminf(oldImpulse + impulse, maxFriction));
+		impulse = constraint.tangentImpulse - oldImpulse;
+
+		a.velocityX -= -ny * impulse * inverseMassA;
+		a.velocityY -= nx * impulse * inverseMassA;
+		b.velocityX += -ny * impulse * inverseMassB;
+		b.velocityY += nx * impulse * inverseMassB;
 	}
 
-	Circle::Circle(float x, float y, float radius, SDL_Color color, SDL_Renderer* renderer) : Entity(x, y)
+	int PhysicsWorld::FindIsland(int body)
 	{
-		this->radius = radius;
-		this->color = color;
-		this->renderer = renderer;
+		while (islandParent[body] != body)
+		{
+			islandParent[body] = islandParent[islandParent[body]];
+			body = islandParent[body];
+		}
+
+		return body;
 	}
 
-	bool Circle::OnRender(float deltaTime)
+	void PhysicsWorld::UpdateSleeping(float timeStep)
 	{
-		SDL_SetRenderDrawColor(renderer, color.r, color.b, color.g, color.a);
-		for (int w = 0; w < radius * 2; w++)
+		if (!sleepingEnabled)
 		{
-			for (int h = 0; h < radius * 2; h++)
+			return;
+		}
+
+		int bodyCount = (int)bodies.size();
+		islandParent.resize(bodyCount);
+		islandSleepTime.assign(bodyCount, FLT_MAX);
+
+		for (int i = 0; i < bodyCount; i++)
+		{
+			islandParent[i] = i;
+			RigidBody& body = bodies[i];
+
+			if (IsAwake(body))
 			{
-				int dx = radius - w; // horizontal offset
-				int dy = radius - h; // vertical offset
-				if ((dx * dx + dy * dy) <= (radius * radius))
+				float speedSquared = body.velocityX * body.velocityX + body.velocityY * body.velocityY;
+				body.sleepTime = speedSquared > sleepVelocity * sleepVelocity ? 0.0f : body.sleepTime + timeStep;
+			}
+		}
+
+		// static bodies don't join islands, otherwise everything on the ground would be one island.
+		for (auto& constraint : constraints)
+		{
+			if (bodies[constraint.a].inverseMass > 0 && bodies[constraint.b].inverseMass > 0)
+			{
+				int islandA = FindIsland(constraint.a);
+				int islandB = FindIsland(constraint.b);
+
+				if (islandA != islandB)
 				{
-					SDL_RenderDrawPoint(renderer, x + dx, y + dy);
+					// always keep the lower index as the root so the result doesn't depend on contact order.
+					islandParent[islandA > islandB ? islandA : islandB] = islandA < islandB ? islandA : islandB;
 				}
 			}
 		}
-		return false;
-	}
 
-	Entity::~Entity()
-	{
+		// an island can only sleep once every body in it has been resting long enough.
+		for (int i = 0; i < bodyCount; i++)
+		{
+			if (IsAwake(bodies[i]))
+			{
+				int island = FindIsland(i);
+				islandSleepTime[island] = fminf(islandSleepTime[island], bodies[i].sleepTime);
+			}
+		}
+
+		for (int i = 0; i < bodyCount; i++)
+		{
+			RigidBody& body = bodies[i];
+
+			if (body.inverseMass == 0)
+			{
+				continue;
+			}
+
+			float sleepTime = islandSleepTime[FindIsland(i)];
+
+			// islands with nothing awake in them weren't touched this step, leave them as they are.
+			if (sleepTime == FLT_MAX)
+			{
+				continue;
+			}
+
+			if (sleepTime >= timeToSleep)
+			{
+				body.sleeping = true;
+				body.velocityX = 0;
+				body.velocityY = 0;
+			}
+			else if (body.sleeping)
+			{
+				WakeBody(i);
+			}
+		}
 	}
 
 	bool Entity::OnUpdate(float deltaTime)
@@ -732,6 +3633,11 @@ namespace CrispyOctoSpork
 		return true;
 	}
 
+	bool Entity::GetCollider(Collider* collider)
+	{
+		return false;
+	}
+
 	SoundEffect::SoundEffect()
 	{
 		mixChunk = NULL;
@@ -747,7 +3653,7 @@ namespace CrispyOctoSpork
 		mixChunk = Mix_LoadWAV(filepath);
 		if (mixChunk == NULL)
 		{
-			printf("Failed to load scratch sound effect! SDL_mixer Error: %s\n", Mix_GetError());
+			Log("Failed to load scratch sound effect! SDL_mixer Error: %s", Mix_GetError());
 			return false;
 		}
 
@@ -803,7 +3709,7 @@ namespace CrispyOctoSpork
 
 		if (texture == NULL)
 		{
-			std::cout << "Could not load the texture from: " << filepath << " Error:" << SDL_GetError() << std::endl;
+			Log("Could not load the texture from: %s Error:%s", filepath, SDL_GetError());
 		}
 
 		SDL_QueryTexture(texture, NULL, NULL, &width, &height);
@@ -822,7 +3728,7 @@ namespace CrispyOctoSpork
 		}
 	}
 
-	void Texture::Render(float x, float y, SDL_Rect* clip, float angle, SDL_FPoint* center, SDL_RendererFlip flip, int alpha)
+	void Texture::Render(float x, float y, SDL_Rect* clip, float angle, SDL_FPoint* center, SDL_RendererFlip flip, int alpha, float scaleX, float scaleY)
 	{
 		SDL_FRect renderQuad = { x, y, (float)width, (float)height };
 
@@ -832,6 +3738,9 @@ namespace CrispyOctoSpork
 			renderQuad.h = clip->h;
 		}
 
+		renderQuad.w *= scaleX;
+		renderQuad.h *= scaleY;
+
 		SDL_SetTextureAlphaMod(texture, alpha);
 		SDL_RenderCopyExF(renderer, texture, clip, &renderQuad, angle, center, flip);
 	}
@@ -957,4 +3866,153 @@ namespace CrispyOctoSpork
 			}
 		}
 	}
-}
\ No newline at end of file
+
+	const TypeInfo* Entity::GetTypeInfo()
+	{
+		return StaticTypeInfo();
+	}
+
+	const TypeInfo* Entity::StaticTypeInfo()
+	{
+		static const FieldInfo fields[] =
+		{
+			{ "x", FIELD_FLOAT, &FieldAddress<Entity, float, &Entity::x> },
+			{ "y", FIELD_FLOAT, &FieldAddress<Entity, float, &Entity::y> },
+			{ "rotation", FIELD_FLOAT, &FieldAddress<Entity, float, &Entity::rotation> },
+			{ "scaleX", FIELD_FLOAT, &FieldAddress<Entity, float, &Entity::scaleX> },
+			{ "scaleY", FIELD_FLOAT, &FieldAddress<Entity, float, &Entity::scaleY> }
+		};
+		static const TypeInfo type = { "Entity", NULL, fields, sizeof(fields) / sizeof(fields[0]) };
+		return &type;
+	}
+
+	const TypeInfo* Sprite::GetTypeInfo()
+	{
+		return StaticTypeInfo();
+	}
+
+	const TypeInfo* Sprite::StaticTypeInfo()
+	{
+		static const FieldInfo fields[] =
+		{
+			{ "width", FIELD_FLOAT, &FieldAddress<Sprite, float, &Sprite::width> },
+			{ "height", FIELD_FLOAT, &FieldAddress<Sprite, float, &Sprite::height> }
+		};
+		static const TypeInfo type = { "Sprite", Entity::StaticTypeInfo(), fields, sizeof(fields) / sizeof(fields[0]) };
+		return &type;
+	}
+
+	const TypeInfo* Rectangle::GetTypeInfo()
+	{
+		return StaticTypeInfo();
+	}
+
+	const TypeInfo* Rectangle::StaticTypeInfo()
+	{
+		static const FieldInfo fields[] =
+		{
+			{ "width", FIELD_FLOAT, &FieldAddress<Rectangle, float, &Rectangle::width> },
+			{ "height", FIELD_FLOAT, &FieldAddress<Rectangle, float, &Rectangle::height> }
+		};
+		static const TypeInfo type = { "Rectangle", Entity::StaticTypeInfo(), fields, sizeof(fields) / sizeof(fields[0]) };
+		return &type;
+	}
+
+	const TypeInfo* Circle::GetTypeInfo()
+	{
+		return StaticTypeInfo();
+	}
+
+	const TypeInfo* Circle::StaticTypeInfo()
+	{
+		static const FieldInfo fields[] =
+		{
+			{ "radius", FIELD_FLOAT, &FieldAddress<Circle, float, &Circle::radius> }
+		};
+		static const TypeInfo type = { "Circle", Entity::StaticTypeInfo(), fields, sizeof(fields) / sizeof(fields[0]) };
+		return &type;
+	}
+
+	const TypeInfo* ParticleEmitter::StaticTypeInfo()
+	{
+		static const FieldInfo fields[] =
+		{
+			{ "active", FIELD_BOOL, &FieldAddress<ParticleEmitter, bool, &ParticleEmitter::active> },
+			{ "x", FIELD_FLOAT, &FieldAddress<ParticleEmitter, float, &ParticleEmitter::x> },
+			{ "y", FIELD_FLOAT, &FieldAddress<ParticleEmitter, float, &ParticleEmitter::y> },
+			{ "speed", FIELD_FLOAT, &FieldAddress<ParticleEmitter, float, &ParticleEmitter::speed> },
+			{ "lifeInMiliseconds", FIELD_FLOAT, &FieldAddress<ParticleEmitter, float, &ParticleEmitter::lifeInMiliseconds> },
+			{ "newParticlesPerSecond", FIELD_INT, &FieldAddress<ParticleEmitter, int, &ParticleEmitter::newParticlesPerSecond> },
+			{ "particlesCreatedThisSecond", FIELD_FLOAT, &FieldAddress<ParticleEmitter, float, &ParticleEmitter::particlesCreatedThisSecond> },
+			{ "currentParticlePoolIndex", FIELD_INT, &FieldAddress<ParticleEmitter, int, &ParticleEmitter::currentParticlePoolIndex> },
+			{ "maxParticles", FIELD_INT, &FieldAddress<ParticleEmitter, int, &ParticleEmitter::maxParticles> }
+		};
+		static const TypeInfo type = { "ParticleEmitter", NULL, fields, sizeof(fields) / sizeof(fields[0]) };
+		return &type;
+	}
+
+	std::vector<const TypeInfo*>& TypeRegistry::Types()
+	{
+		static std::vector<const TypeInfo*> types =
+		{
+			Entity::StaticTypeInfo(),
+			Sprite::StaticTypeInfo(),
+			Rectangle::StaticTypeInfo(),
+			Circle::StaticTypeInfo(),
+			ParticleEmitter::StaticTypeInfo()
+		};
+		return types;
+	}
+
+	void TypeRegistry::Register(const TypeInfo* type)
+	{
+		std::vector<const TypeInfo*>& types = Types();
+		if (std::find(types.begin(), types.end(), type) == types.end())
+		{
+			types.push_back(type);
+		}
+	}
+
+	const TypeInfo* TypeRegistry::Find(const char* name)
+	{
+		for (const TypeInfo* type : Types())
+		{
+			if (strcmp(type->name, name) == 0)
+			{
+				return type;
+			}
+		}
+
+		return NULL;
+	}
+
+	const std::vector<const TypeInfo*>& TypeRegistry::GetTypes()
+	{
+		return Types();
+	}
+}
+#ifdef CRISPY_OCTO_SPORK_COUNT_ALLOCATIONS
+// Replaces the program's global operator new and operator delete so allocationCount sees every heap allocation.
+void* operator new(size_t size)
+{
+	CrispyOctoSpork::allocationCount++;
+
+	void* pointer = malloc(size == 0 ? 1 : size);
+	if (pointer == NULL)
+	{
+		throw std::bad_alloc();
+	}
+
+	return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	free(pointer);
+}
+
+void operator delete(void* pointer, size_t size) noexcept
+{
+	free(pointer);
+}
+#endif
\ No newline at end of file
@@ -3,6 +3,51 @@
 
 using namespace CrispyOctoSpork;
 
+/// <summary>
+/// Sends engine log lines to the sdlui console. Runs on whichever thread logged, which SDLUI_LogText allows.
+/// Until the console exists the lines are printed to stdout as well, so a failed Create is still reported.
+/// </summary>
+/// <param name="message">The line that was logged.</param>
+/// <param name="userData">Points at the game's console pointer, which is null until the console is created.</param>
+void LogToConsole(const char* message, void* userData)
+{
+	SDLUI_LogText(message);
+
+	if (*(SDLUI_Control_Console**)userData == NULL)
+	{
+		puts(message);
+	}
+}
+
+/// <summary>
+/// Adds every reflected field of an object to an sdlui inspector, fields of base types first.
+/// </summary>
+/// <param name="inspector">The inspector to add the fields to.</param>
+/// <param name="type">The reflection info of the object.</param>
+/// <param name="object">The object to inspect, it has to outlive the inspector.</param>
+void InspectObject(SDLUI_Control_Inspector* inspector, const TypeInfo* type, void* object)
+{
+	if (type->base != NULL)
+	{
+		InspectObject(inspector, type->base, object);
+	}
+
+	for (int i = 0; i < type->fieldCount; i++)
+	{
+		const FieldInfo& field = type->fields[i];
+		SDLUI_VALUE_TYPE valueType = SDLUI_VALUE_TYPE_FLOAT;
+
+		switch (field.type)
+		{
+		case FIELD_BOOL: valueType = SDLUI_VALUE_TYPE_BOOL; break;
+		case FIELD_INT: valueType = SDLUI_VALUE_TYPE_INT; break;
+		case FIELD_FLOAT: valueType = SDLUI_VALUE_TYPE_FLOAT; break;
+		}
+
+		SDLUI_InspectorAddField(inspector, field.name, valueType, field.address(object));
+	}
+}
+
 /// <summary>
 /// Sample game. Derivies from the base CrispyOctoSpork::Engine.
 /// </summary>
@@ -14,6 +59,12 @@ public:
 	SDLUI_Control_Button* button;
 	SDLUI_Control_Text* slider_text;
 	SDLUI_Control_SliderInt* slider;
+	SDLUI_Control_Text* frame_time_text;
+	SDLUI_Control_Plot* frame_time_plot;
+	SDLUI_Control_Window* consoleWindow;
+	SDLUI_Control_Console* console = NULL;
+	SDLUI_Control_Window* inspectorWindow;
+	SDLUI_Control_Inspector* inspector;
 	Texture* particleTexture;
 	ParticleEmitter* particleEmitter;
 
@@ -31,6 +82,12 @@ public:
 		slider_text = SDLUI_CreateText(uiWindow, 10, 100, "Particles Per Second");
 		slider = SDLUI_CreateSliderInt(uiWindow, 10, 120, 100, 10000, 100);
 
+		frame_time_text = SDLUI_CreateText(uiWindow, 10, 170, "Frame Time (ms)");
+		frame_time_plot = SDLUI_CreatePlot(uiWindow, 10, 190, 180, 90, 600);
+
+		consoleWindow = SDLUI_CreateWindow(20, 440, 620, 260, "Console");
+		console = SDLUI_CreateConsole(consoleWindow, 10, 40, 600, 210);
+
 		texture = new Texture(renderer);
 		particleTexture = new Texture(renderer);
 		texture->LoadTextureFromFile("../assets/ball.png");
@@ -42,6 +99,10 @@ public:
 
 		particleEmitter = new ParticleEmitter((float) (screenWidth / 2 - 16), (float) (screenHeight / 2 - 16), 1500, particleTexture, 0.3, 100);
 
+		inspectorWindow = SDLUI_CreateWindow(240, 20, 300, 220, "Particle Emitter");
+		inspector = SDLUI_CreateInspector(inspectorWindow, 10, 40, 280, 170);
+		InspectObject(inspector, TypeRegistry::Find("ParticleEmitter"), particleEmitter);
+
 		return true;
 	}
 
@@ -70,6 +131,7 @@ public:
 			particleEmitter->active = !particleEmitter->active;
 			particleEmitter->startOfSecond = SDL_GetTicks();
 			particleEmitter->particlesCreatedThisSecond = 0;
+			Log("Particle emitter %s", particleEmitter->active ? "started" : "stopped");
 		}
 
 		SDLUI_Text(slider_text);
@@ -81,6 +143,16 @@ public:
 			particleEmitter->particlesCreatedThisSecond = 0;
 		}
 
+		SDLUI_Text(frame_time_text);
+		SDLUI_PlotPush(frame_time_plot, deltaTime);
+		SDLUI_Plot(frame_time_plot);
+
+		SDLUI_Window(consoleWindow);
+		SDLUI_Console(console);
+
+		SDLUI_Window(inspectorWindow);
+		SDLUI_Inspector(inspector);
+
 		SDLUI_Render();
 		return true;
 	}
@@ -105,6 +177,9 @@ int main(int argc, char* argv[])
 {
 	SampleGame game;
 
+	// Log lines go to the console's ring from the start, so whatever Create reports shows up once the console exists.
+	SetLogSink(LogToConsole, &game.console);
+
 	// Create a new instance of your game. If successful, then start the main loop.
 	if (game.Create("SampleGame", 1280, 720, false, false))
 	{
@@ -0,0 +1,124 @@
+// Steps a pyramid of boxes resting on static ground without opening a window, to time PhysicsWorld::Step
+// and check that it is deterministic. Build it against SDL2 like the engine and run
+//
+//     physics_pyramid_benchmark [rows] [steps]
+//
+// It simulates the stack twice from the same start and reports whether the positions match bit for bit,
+// how long the steps took with sleeping on and off, and how long more steps take once everything is asleep.
+
+#define SDL_MAIN_HANDLED
+#include "../crispyOctoSporkEngine.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace CrispyOctoSpork;
+
+const float boxSize = 20.0f;
+const float timeStep = 1.0f / 60.0f;
+
+void BuildPyramid(PhysicsWorld& world, int rows)
+{
+	Collider ground;
+	ground.type = COLLIDER_AABB;
+	ground.x = 0;
+	ground.y = boxSize / 2 + 50;
+	ground.halfWidth = rows * boxSize * 2;
+	ground.halfHeight = 50;
+	world.AddBody(ground, 0);
+
+	for (int row = 0; row < rows; row++)
+	{
+		int count = rows - row;
+		float left = -(count - 1) * boxSize / 2;
+
+		for (int i = 0; i < count; i++)
+		{
+			Collider box;
+			box.type = COLLIDER_AABB;
+			box.x = left + i * boxSize;
+			box.y = -row * boxSize;
+			box.halfWidth = boxSize / 2;
+			box.halfHeight = boxSize / 2;
+			world.AddBody(box, 1);
+		}
+	}
+}
+
+double StepWorld(PhysicsWorld& world, int steps)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (int i = 0; i < steps; i++)
+	{
+		world.Step(timeStep);
+	}
+
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+	return elapsed.count();
+}
+
+int CountSleeping(PhysicsWorld& world)
+{
+	int sleeping = 0;
+
+	for (int i = 0; i < world.GetBodyCount(); i++)
+	{
+		if (world.GetBody(i).inverseMass > 0 && world.GetBody(i).sleeping)
+		{
+			sleeping++;
+		}
+	}
+
+	return sleeping;
+}
+
+bool SamePositions(PhysicsWorld& a, PhysicsWorld& b)
+{
+	for (int i = 0; i < a.GetBodyCount(); i++)
+	{
+		if (memcmp(&a.GetBody(i).shape.x, &b.GetBody(i).shape.x, sizeof(float)) != 0 ||
+			memcmp(&a.GetBody(i).shape.y, &b.GetBody(i).shape.y, sizeof(float)) != 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	int rows = argc > 1 ? atoi(argv[1]) : 20;
+	int steps = argc > 2 ? atoi(argv[2]) : 600;
+
+	PhysicsWorld first;
+	PhysicsWorld second;
+	PhysicsWorld awake;
+	awake.sleepingEnabled = false;
+
+	BuildPyramid(first, rows);
+	BuildPyramid(second, rows);
+	BuildPyramid(awake, rows);
+
+	int boxes = first.GetBodyCount() - 1;
+	printf("%d rows, %d boxes, %d steps of %.4f s\n", rows, boxes, steps, timeStep);
+
+	double settleTime = StepWorld(first, steps);
+	StepWorld(second, steps);
+	double awakeTime = StepWorld(awake, steps);
+
+	printf("settling:            %8.2f ms, %d of %d boxes asleep\n", settleTime, CountSleeping(first), boxes);
+	printf("sleeping disabled:   %8.2f ms\n", awakeTime);
+	printf("after settling:      %8.2f ms for %d more steps\n", StepWorld(first, steps), steps);
+
+	StepWorld(second, steps);
+	bool deterministic = SamePositions(first, second);
+	printf("deterministic:       %s\n", deterministic ? "yes" : "no");
+
+	float top = first.GetBody(first.GetBodyCount() - 1).shape.y;
+	printf("top box rests at y = %.3f (starts at %.3f)\n", top, -(rows - 1) * boxSize);
+
+	return deterministic ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+// Bakes the printable ascii glyphs of the font embedded in sdlui.h into a header, so SDLUI_Init doesn't have to
+// open the font or rasterize anything. Build it against SDL2 and SDL2_ttf and run
+//
+//     sdlui_bake_font [size] > sdlui_font_baked.h
+//
+// then define SDLUI_BAKED_FONT as "sdlui_font_baked.h" before including sdlui.h. The size has to match
+// SDLUI_Font.size when SDLUI_Init is called, otherwise sdlui ignores the baked glyphs and opens the font.
+
+#define SDL_MAIN_HANDLED
+#include "../sdlui.h"
+
+#define BAKE_FIRST 32
+#define BAKE_COUNT 95
+
+void PrintBytes(const u8* data, i32 size)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        printf(i % 16 == 0 ? "\n    0x%02x," : " 0x%02x,", data[i]);
+    }
+    printf("\n");
+}
+
+// kerning is mostly negative, so it is written as signed decimals to fit the i8 table.
+void PrintSignedBytes(const i8* data, i32 size)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        printf(i % 16 == 0 ? "\n    %d," : " %d,", data[i]);
+    }
+    printf("\n");
+}
+
+int main(int argc, char* argv[])
+{
+    i32 size = argc > 1 ? atoi(argv[1]) : SDLUI_Font.size;
+
+    if (TTF_Init() != 0)
+    {
+        fprintf(stderr, "TTF_Init failed: %s\n", TTF_GetError());
+        return 1;
+    }
+
+    SDL_RWops* rw = SDL_RWFromConstMem(sdlui_font_data, sizeof(sdlui_font_data));
+    TTF_Font* font = TTF_OpenFontRW(rw, 1, size);
+
+    if (font == NULL)
+    {
+        fprintf(stderr, "couldn't open the font: %s\n", TTF_GetError());
+        return 1;
+    }
+
+    i32 width, height;
+    TTF_SizeText(font, "0", &width, &height);
+
+    SDLUI_BakedGlyph glyphs[BAKE_COUNT];
+    u8* coverage = NULL;
+    i32 coverage_size = 0;
+    SDL_Color white = { 255, 255, 255, 255 };
+
+    // the same steps as SDLUI_GetGlyph, keeping only the alpha of each pixel since the color is always white.
+    for (u32 c = BAKE_FIRST; c < BAKE_FIRST + BAKE_COUNT; ++c)
+    {
+        SDLUI_BakedGlyph* b = &glyphs[c - BAKE_FIRST];
+        i32 minx, maxx, miny, maxy;
+
+        if (!TTF_GlyphIsProvided32(font, c) || TTF_GlyphMetrics32(font, c, &minx, &maxx, &miny, &maxy, &b->advance) != 0)
+        {
+            b->advance = width;
+            minx = 0;
+        }
+
+        b->offset_x = minx < 0 ? minx : 0;
+        b->w = 0;
+        b->h = 0;
+        b->offset = coverage_size;
+
+        SDL_Surface* rendered = TTF_RenderGlyph32_Blended(font, c, white);
+
+        if (rendered != NULL)
+        {
+            SDL_Surface* s = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+
+            if (s != NULL && s->w > 0)
+            {
+                b->w = s->w;
+                b->h = s->h;
+                coverage = (u8*)realloc(coverage, coverage_size + s->w * s->h);
+
+                SDL_LockSurface(s);
+                for (int y = 0; y < s->h; ++y)
+                {
+                    const u32* row = (const u32*)((const u8*)s->pixels + y * s->pitch);
+
+                    for (int x = 0; x < s->w; ++x)
+                    {
+                        coverage[coverage_size++] = (u8)(row[x] >> 24);
+                    }
+                }
+                SDL_UnlockSurface(s);
+            }
+
+            SDL_FreeSurface(s);
+            SDL_FreeSurface(rendered);
+        }
+    }
+
+    i8 kerning[BAKE_COUNT * BAKE_COUNT];
+    bool kerning_enabled = TTF_GetFontKerning(font) != 0;
+
+    for (u32 a = 0; a < BAKE_COUNT; ++a)
+    {
+        for (u32 b = 0; b < BAKE_COUNT; ++b)
+        {
+            kerning[a * BAKE_COUNT + b] = kerning_enabled ? (i8)TTF_GetFontKerningSizeGlyphs32(font, BAKE_FIRST + a, BAKE_FIRST + b) : 0;
+        }
+    }
+
+    printf("// Written by tools/sdlui_bake_font.cpp, run it again rather than editing this.\n");
+    printf("#pragma once\n\n");
+    printf("#define SDLUI_BAKED_FONT_SIZE %d\n", size);
+    printf("#define SDLUI_BAKED_FIRST %d\n", BAKE_FIRST);
+    printf("#define SDLUI_BAKED_COUNT %d\n\n", BAKE_COUNT);
+    printf("const i32 sdlui_baked_font_width = %d;\n", width);
+    printf("const i32 sdlui_baked_font_height = %d;\n\n", height);
+
+    printf("const SDLUI_BakedGlyph sdlui_baked_glyphs[SDLUI_BAKED_COUNT] = {\n");
+    for (int i = 0; i < BAKE_COUNT; ++i)
+    {
+        SDLUI_BakedGlyph* b = &glyphs[i];
+        printf("    { %d, %d, %d, %d, %d },\n", b->advance, b->offset_x, b->w, b->h, b->offset);
+    }
+    printf("};\n\n");
+
+    printf("const i8 sdlui_baked_kerning[SDLUI_BAKED_COUNT * SDLUI_BAKED_COUNT] = {");
+    PrintSignedBytes(kerning, sizeof(kerning));
+    printf("};\n\n");
+
+    // an array can't be empty, so a font without any visible glyphs still gets one byte.
+    u8 empty = 0;
+    printf("const u8 sdlui_baked_coverage[%d] = {", coverage_size > 0 ? coverage_size : 1);
+    PrintBytes(coverage_size > 0 ? coverage : &empty, coverage_size > 0 ? coverage_size : 1);
+    printf("};\n");
+
+    free(coverage);
+    TTF_CloseFont(font);
+    TTF_Quit();
+
+    return 0;
+}